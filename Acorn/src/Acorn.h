@@ -23,6 +23,8 @@
 #include "Acorn/utils/PlatformUtils.h"
 
 #include "Acorn/serialize/Serializer.h"
+#include "Acorn/serialize/SceneJournal.h"
+#include "Acorn/serialize/SceneLoader.h"
 
 #include "Acorn/ecs/Entity.h"
 #include "Acorn/ecs/Scene.h"
@@ -98,6 +98,8 @@ namespace Acorn
 				m_ImGuiLayer->End();
 			}
 
+			Renderer::EndFrame();
+
 			{
 				AC_PROFILE_SCOPE("Application::Run::WindowUpdate");
 				m_Window->OnUpdate();
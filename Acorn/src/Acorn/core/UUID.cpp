@@ -2,18 +2,153 @@
 
 #include "core/UUID.h"
 
-#include <boost/uuid/uuid_generators.hpp>
+#include <chrono>
+#include <random>
+#include <thread>
 
 namespace Acorn
 {
+	static uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * @brief xoshiro256** seeded once per thread.
+	 */
+	class UUIDGenerator
+	{
+	public:
+		UUIDGenerator()
+		{
+			// random_device may be deterministic on some platforms, so mix in the thread and the time
+			std::random_device device;
+			uint64_t seed = ((uint64_t)device() << 32) ^ device();
+			seed ^= (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+			seed ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+			for (auto& state : m_State)
+			{
+				state = SplitMix64(seed);
+			}
+		}
+
+		uint64_t Next()
+		{
+			uint64_t result = Rotl(m_State[1] * 5, 7) * 9;
+			uint64_t t = m_State[1] << 17;
+
+			m_State[2] ^= m_State[0];
+			m_State[3] ^= m_State[1];
+			m_State[1] ^= m_State[2];
+			m_State[0] ^= m_State[3];
+			m_State[2] ^= t;
+			m_State[3] = Rotl(m_State[3], 45);
+
+			return result;
+		}
+
+	private:
+		static uint64_t Rotl(uint64_t x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+	private:
+		uint64_t m_State[4];
+	};
+
+	static int HexValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	}
+
 	UUID::UUID()
 	{
-		m_UUID = boost::uuids::random_generator()();
+		thread_local UUIDGenerator generator;
+
+		m_High = generator.Next();
+		m_Low = generator.Next();
+
+		// Version 4 and RFC 4122 variant, like any other random UUID
+		m_High = (m_High & ~0xf000ull) | 0x4000ull;
+		m_Low = (m_Low & 0x3fffffffffffffffull) | 0x8000000000000000ull;
 	}
 
 	UUID::UUID(const std::string& uuid)
 	{
-		m_UUID = boost::uuids::string_generator()(uuid);
+		std::optional<UUID> parsed = FromChars(uuid);
+		if (!parsed)
+		{
+			// Asserts are gone in release builds, this at least says where the zero id came from
+			AC_CORE_ERROR("Invalid UUID {}", uuid);
+			AC_CORE_ASSERT(false, "Invalid UUID");
+			return;
+		}
+
+		*this = *parsed;
+	}
+
+	void UUID::ToChars(char* buffer) const
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		size_t position = 0;
+		for (int i = 0; i < 32; i++)
+		{
+			// Dashes go in front of hex digits 8, 12, 16 and 20
+			if (i == 8 || i == 12 || i == 16 || i == 20)
+			{
+				buffer[position++] = '-';
+			}
+
+			uint64_t half = i < 16 ? m_High : m_Low;
+			int shift = 60 - (i % 16) * 4;
+			buffer[position++] = digits[(half >> shift) & 0xf];
+		}
 	}
 
-}
\ No newline at end of file
+	std::optional<UUID> UUID::FromChars(std::string_view text)
+	{
+		if (text.size() >= 2 && text.front() == '{' && text.back() == '}')
+		{
+			text = text.substr(1, text.size() - 2);
+		}
+
+		// Either the 8-4-4-4-12 layout or the bare 32 digits, dashes anywhere else are not a UUID
+		bool dashed = text.size() == StringLength;
+		if (!dashed && text.size() != 32)
+			return std::nullopt;
+
+		uint64_t halves[2] = {0, 0};
+		int digitCount = 0;
+		for (size_t i = 0; i < text.size(); i++)
+		{
+			if (dashed && (i == 8 || i == 13 || i == 18 || i == 23))
+			{
+				if (text[i] != '-')
+					return std::nullopt;
+				continue;
+			}
+
+			int value = HexValue(text[i]);
+			if (value < 0)
+				return std::nullopt;
+
+			uint64_t& half = halves[digitCount / 16];
+			half = (half << 4) | (uint64_t)value;
+			digitCount++;
+		}
+
+		return UUID(halves[0], halves[1]);
+	}
+}
@@ -2,32 +2,74 @@
 
 #include "core/Core.h"
 
-#include <boost/container_hash/hash.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_io.hpp>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace Acorn
 {
+	/**
+	 * @brief Random (version 4) 128 bit UUID.
+	 *
+	 * New ids come from a fast generator that every thread seeds once, so creating one never touches the OS
+	 * entropy source. The text form is the usual 8-4-4-4-12 hex layout, which older scene files use as well.
+	 */
 	class UUID
 	{
+	public:
+		static constexpr size_t StringLength = 36;
+
 	public:
 		UUID();
+		// Text that is not a valid UUID leaves the zero id, use FromChars for anything read from a file
 		UUID(const std::string& uuid);
+		constexpr UUID(uint64_t high, uint64_t low)
+			: m_High(high), m_Low(low) {}
 		UUID(const UUID& uuid) = default;
+		UUID& operator=(const UUID& uuid) = default;
+
+		inline uint64_t GetHigh() const { return m_High; }
+		inline uint64_t GetLow() const { return m_Low; }
+
+		/**
+		 * @brief Writes the text form without allocating.
+		 *
+		 * @param buffer
+		 *  Receives exactly StringLength characters, no null terminator is written.
+		 */
+		void ToChars(char* buffer) const;
+
+		/**
+		 * @brief Parses the text form, with or without braces.
+		 *
+		 * Dashes are only accepted in the 8-4-4-4-12 layout, otherwise the text must be the 32 hex digits alone.
+		 *
+		 * @param text
+		 *  Text to parse.
+		 * @return
+		 *  The UUID or std::nullopt if the text is not a valid UUID.
+		 */
+		static std::optional<UUID> FromChars(std::string_view text);
 
-		inline const boost::uuids::uuid& getUUID() const { return m_UUID; }
+		inline operator std::string() const
+		{
+			std::string result(StringLength, '\0');
+			ToChars(result.data());
+			return result;
+		}
 
-		inline operator std::string() { return to_string(m_UUID); }
-		inline operator const std::string() const { return to_string(m_UUID); }
-		inline bool operator==(const UUID& uuid) const { return m_UUID == uuid.m_UUID; }
+		inline bool operator==(const UUID& uuid) const { return m_High == uuid.m_High && m_Low == uuid.m_Low; }
+		inline bool operator!=(const UUID& uuid) const { return !(*this == uuid); }
 
 	private:
-		//NOTE does this need to be a boost::uuid::uuid or is a uint64_t more performant?
-		boost::uuids::uuid m_UUID;
+		// Bytes 0-7 and 8-15 of the UUID, most significant byte first
+		uint64_t m_High = 0;
+		uint64_t m_Low = 0;
 	};
+
+	static_assert(std::is_trivially_copyable_v<UUID>, "UUIDs are copied around a lot and stored in binary files");
 }
 
 namespace std
@@ -35,12 +77,10 @@ namespace std
 	template <>
 	struct hash<Acorn::UUID>
 	{
-
 		size_t operator()(const Acorn::UUID& uuid) const
 		{
-			boost::hash<boost::uuids::uuid> uuid_hasher;
-			size_t hashVal = uuid_hasher(uuid.getUUID());
-			return hashVal;
+			// The bits are already random, folding both halves is enough
+			return (size_t)(uuid.GetHigh() ^ (uuid.GetLow() * 0x9e3779b97f4a7c15ull));
 		}
 	};
-}
\ No newline at end of file
+}
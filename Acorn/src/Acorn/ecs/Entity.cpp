@@ -23,19 +23,50 @@ namespace Acorn
 		AC_CORE_ASSERT(m_EntityHandle != entt::null, "Entity is null");
 		AC_CORE_ASSERT(HasComponent<Components::Transform>(), "Entity does not have component");
 
-		auto& selfTransform = GetComponent<Components::Transform>();
-		selfTransform.SetFromMatrix(deltaMatrix * selfTransform.GetTransform());
+		// Children are relative to this entity, so they follow without being touched
+		SetWorldTransform(deltaMatrix * GetWorldTransform());
+	}
+
+	glm::mat4 Entity::GetWorldTransform()
+	{
+		AC_CORE_ASSERT(HasComponent<Components::Transform>(), "Entity does not have component");
+
+		glm::mat4 worldMatrix = GetComponent<Components::Transform>().GetTransform();
 
-		if (HasComponent<Components::ChildRelationship>())
+		Entity entity = *this;
+		while (entity.HasComponent<Components::ParentRelationship>())
 		{
-			auto& childComponent = GetComponent<Components::ChildRelationship>();
+			entity = entity.GetComponent<Components::ParentRelationship>().Parent;
+			worldMatrix = entity.GetComponent<Components::Transform>().GetTransform() * worldMatrix;
+		}
+
+		return worldMatrix;
+	}
+
+	void Entity::SetWorldTransform(const glm::mat4& worldMatrix)
+	{
+		AC_CORE_ASSERT(HasComponent<Components::Transform>(), "Entity does not have component");
 
-			for (auto& child : childComponent.Entities)
-			{
-				// FIXME: If the component is a child of another entity, we should rotate the child based on the the parent's center.
-				child.MoveTransform(deltaMatrix);
-			}
+		auto& transform = GetComponent<Components::Transform>();
+		if (HasComponent<Components::ParentRelationship>())
+		{
+			Entity parent = GetComponent<Components::ParentRelationship>().Parent;
+			transform.SetFromMatrix(glm::inverse(parent.GetWorldTransform()) * worldMatrix);
 		}
+		else
+		{
+			transform.SetFromMatrix(worldMatrix);
+		}
+		MarkChanged();
+	}
+
+	void Entity::MarkChanged()
+	{
+		AC_CORE_ASSERT(m_Scene != nullptr, "Scene is null");
+		AC_CORE_ASSERT(m_EntityHandle != entt::null, "Entity is null");
+
+		// Patching without a function only fires the update signal
+		m_Scene->m_Registry.patch<Components::ID>(m_EntityHandle);
 	}
 
 	UUID& Entity::GetUUID()
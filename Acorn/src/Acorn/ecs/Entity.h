@@ -85,6 +85,29 @@ namespace Acorn
 		 */
 		void MoveTransform(const glm::mat4& deltaMatrix);
 
+		/**
+		 * @brief Computes the world matrix by walking up the parent chain.
+		 *
+		 * Unlike the cached Components::WorldTransform this is always current, which the editor needs while
+		 * it edits transforms between frames.
+		 */
+		glm::mat4 GetWorldTransform();
+
+		/**
+		 * @brief Sets the local transform, so that the entity ends up at the given world matrix.
+		 *
+		 * @param worldMatrix
+		 *  World matrix the entity should have under its current parent.
+		 */
+		void SetWorldTransform(const glm::mat4& worldMatrix);
+
+		/**
+		 * @brief Reports components that were written in place to the change tracking of the scene.
+		 *
+		 * entt only notices writes that go through the registry, references handed out by GetComponent bypass it.
+		 */
+		void MarkChanged();
+
 		UUID& GetUUID();
 		std::string GetName();
 
@@ -94,6 +117,7 @@ namespace Acorn
 		bool operator==(const Entity& other) const { return m_EntityHandle == other.m_EntityHandle && m_Scene == other.m_Scene; }
 
 		bool IsValid() const { return m_EntityHandle != entt::null && m_Scene != nullptr; }
+		Scene* GetScene() const { return m_Scene; }
 
 	private:
 		entt::entity m_EntityHandle{entt::null};
@@ -1,6 +1,8 @@
 #include "acpch.h"
 
 #include "ecs/Scene.h"
+#include "ecs/SceneSnapshot.h"
+#include "ecs/components/ComponentRegistry.h"
 #include "ecs/components/ScriptableEntity.h"
 
 #include "ecs/Entity.h"
@@ -28,8 +30,128 @@
 #include <entt/entity/snapshot.hpp>
 #include <glm/glm.hpp>
 
+#include <limits>
+
 namespace Acorn
 {
+	// Matches the billboard the debug renderer draws for cameras
+	static constexpr float CameraIconExtent = 0.15f;
+
+	/**
+	 * @brief Places collider shapes the way the physics world builds their fixtures.
+	 *
+	 * The size of a box follows the scale of the entity, its offset and the radius of a circle do not.
+	 */
+	struct ColliderFrame
+	{
+		glm::vec3 Position;
+		glm::vec2 Scale;
+		glm::vec2 AxisX = {1.0f, 0.0f};
+		glm::vec2 AxisY = {0.0f, 1.0f};
+
+		explicit ColliderFrame(const glm::mat4& matrix)
+			: Position(matrix[3]), Scale(glm::length(glm::vec2(matrix[0])), glm::length(glm::vec2(matrix[1])))
+		{
+			if (Scale.x > 0.0f)
+				AxisX = glm::vec2(matrix[0]) / Scale.x;
+			if (Scale.y > 0.0f)
+				AxisY = glm::vec2(matrix[1]) / Scale.y;
+		}
+
+		inline glm::vec2 ToWorld(const glm::vec2& local) const { return glm::vec2(Position) + AxisX * local.x + AxisY * local.y; }
+
+		inline glm::vec2 ToLocal(const glm::vec2& point) const
+		{
+			glm::vec2 offset = point - glm::vec2(Position);
+			return {glm::dot(offset, AxisX), glm::dot(offset, AxisY)};
+		}
+
+		inline Math::AABB Bounds(const glm::vec2& center, const glm::vec2& extent) const
+		{
+			return {glm::vec3(center - extent, Position.z), glm::vec3(center + extent, Position.z)};
+		}
+	};
+
+	static Math::AABB GetBounds(const entt::registry& registry, entt::entity entity, const glm::mat4& matrix)
+	{
+		glm::vec3 position = glm::vec3(matrix[3]);
+		Math::AABB bounds = {position, position};
+		if (registry.any_of<Components::SpriteRenderer, Components::CircleRenderer>(entity))
+			bounds = Math::AABB::FromQuad(matrix);
+		if (registry.all_of<Components::CameraComponent>(entity))
+			bounds = bounds.Union({position - CameraIconExtent, position + CameraIconExtent});
+
+		if (registry.any_of<Components::BoxCollider2d, Components::CircleCollider2d>(entity))
+		{
+			ColliderFrame frame(matrix);
+			if (const auto* box = registry.try_get<Components::BoxCollider2d>(entity))
+			{
+				glm::vec2 halfSize = box->GetSize() * frame.Scale;
+				glm::vec2 extent = glm::abs(frame.AxisX) * halfSize.x + glm::abs(frame.AxisY) * halfSize.y;
+				bounds = bounds.Union(frame.Bounds(frame.ToWorld(box->GetOffset()), extent));
+			}
+			if (const auto* circle = registry.try_get<Components::CircleCollider2d>(entity))
+				bounds = bounds.Union(frame.Bounds(frame.ToWorld(circle->GetOffset()), glm::vec2(circle->GetRadius())));
+		}
+		return bounds;
+	}
+
+	// Exact test against the collider shapes, works in the editor as well since it does not need the fixtures
+	static bool ColliderContains(const entt::registry& registry, entt::entity entity, const glm::vec2& point)
+	{
+		const auto* box = registry.try_get<Components::BoxCollider2d>(entity);
+		const auto* circle = registry.try_get<Components::CircleCollider2d>(entity);
+		if (!box && !circle)
+			return false;
+
+		ColliderFrame frame(registry.get<Components::WorldTransform>(entity).Matrix);
+		glm::vec2 local = frame.ToLocal(point);
+		if (box && glm::all(glm::lessThanEqual(glm::abs(local - box->GetOffset()), box->GetSize() * frame.Scale)))
+			return true;
+		return circle && glm::length(local - circle->GetOffset()) <= circle->GetRadius();
+	}
+
+	// Exact test against what is drawn, the bounds only narrow down the candidates
+	static bool HitTest(const entt::registry& registry, entt::entity entity, const Math::Ray& ray, float& distance)
+	{
+		const glm::mat4& matrix = registry.get<Components::WorldTransform>(entity).Matrix;
+		bool hit = false;
+
+		if (registry.all_of<Components::CameraComponent>(entity))
+		{
+			glm::vec3 position = glm::vec3(matrix[3]);
+			hit = ray.Intersects({position - CameraIconExtent, position + CameraIconExtent}, distance);
+		}
+
+		bool sprite = registry.all_of<Components::SpriteRenderer>(entity);
+		const auto* circle = registry.try_get<Components::CircleRenderer>(entity);
+		if (!sprite && !circle)
+			return hit;
+
+		// In the space of the unit quad it lies in the z = 0 plane, the distance along the ray stays the same
+		glm::mat4 inverse = glm::inverse(matrix);
+		glm::vec3 origin = glm::vec3(inverse * glm::vec4(ray.Origin, 1.0f));
+		glm::vec3 direction = glm::vec3(inverse * glm::vec4(ray.Direction, 0.0f));
+		if (direction.z == 0.0f)
+			return hit;
+
+		float quadDistance = -origin.z / direction.z;
+		glm::vec2 point = glm::vec2(origin + quadDistance * direction);
+		bool inside = glm::abs(point.x) <= 0.5f && glm::abs(point.y) <= 0.5f;
+		if (circle && !sprite)
+		{
+			// Same ring the circle shader keeps
+			float radius = glm::length(point) * 2.0f;
+			inside = radius <= 1.0f && radius >= 1.0f - circle->Thickness;
+		}
+
+		if (!inside || quadDistance < 0.0f || (hit && quadDistance >= distance))
+			return hit;
+
+		distance = quadDistance;
+		return true;
+	}
+
 	static b2BodyType GetBodyType(Components::RigidBody2d::BodyType type)
 	{
 		AC_PROFILE_FUNCTION();
@@ -47,27 +169,47 @@ namespace Acorn
 	}
 
 	template <typename Component>
-	static void CopyComponent(entt::registry& dst, const entt::registry& src, const std::unordered_map<UUID, entt::entity>& entityMap)
+	static void ClonePool(entt::registry& dst, entt::registry& src)
 	{
 		AC_PROFILE_FUNCTION();
-		auto view = src.view<Component>();
-		for (auto entity : view)
-		{
-			UUID uuid = src.get<Components::ID>(entity).UUID;
-			AC_CORE_ASSERT(entityMap.find(uuid) != entityMap.end(), "Entity not found in entity map");
-			entt::entity enttId = entityMap.at(uuid);
+		// The mutable overload always hands out a pool, creating an empty one if the scene never used the component
+		const auto& storage = src.storage<Component>();
+		const entt::sparse_set& entities = storage;
 
-			auto& component = src.get<Component>(entity);
-			dst.emplace_or_replace<Component>(enttId, component);
-		}
+		// Reverse iteration walks the packed arrays front to back, so the clone keeps the order of the source
+		dst.insert<Component>(entities.rbegin(), entities.rend(), storage.rbegin());
 	}
 
 	Scene::Scene()
 	{
+		// Removing a transform swaps the last one into its slot, which can put a child before its parent
+		m_Registry.on_construct<Components::ParentRelationship>().connect<&Scene::OnHierarchyChanged>(*this);
+		m_Registry.on_destroy<Components::ParentRelationship>().connect<&Scene::OnHierarchyChanged>(*this);
+		m_Registry.on_destroy<Components::WorldTransform>().connect<&Scene::OnHierarchyChanged>(*this);
+
+		// Bounds follow the components that give an entity something to pick or draw
+		m_Registry.on_construct<Components::SpriteRenderer>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::SpriteRenderer>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_construct<Components::CircleRenderer>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::CircleRenderer>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_construct<Components::CameraComponent>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::CameraComponent>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_construct<Components::BoxCollider2d>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::BoxCollider2d>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_construct<Components::CircleCollider2d>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::CircleCollider2d>().connect<&Scene::OnBoundsChanged>(*this);
+		// Collider sizes are edited in place, the editor marks the entity changed afterwards
+		m_Registry.on_update<Components::ID>().connect<&Scene::OnBoundsChanged>(*this);
+		m_Registry.on_destroy<Components::WorldTransform>().connect<&Scene::OnBoundsDestroyed>(*this);
+
+		// A new transform can start a page the views of scripts do not cover, removing one swaps the last one in
+		m_Registry.on_construct<Components::Transform>().connect<&Scene::OnTransformsMoved>(*this);
+		m_Registry.on_destroy<Components::Transform>().connect<&Scene::OnTransformsMoved>(*this);
 	}
 
 	Scene::~Scene()
 	{
+		InvalidateScriptViews();
 	}
 
 	Ref<Scene> Scene::Copy(Ref<Scene> src)
@@ -77,96 +219,62 @@ namespace Acorn
 
 		dst->m_ViewportWidth = src->m_ViewportWidth;
 		dst->m_ViewportHeight = src->m_ViewportHeight;
+		dst->m_Options = src->m_Options;
+		dst->m_StaticGeometry = src->m_StaticGeometry;
 
 		auto& srcSceneReg = src->m_Registry;
 		auto& dstSceneReg = dst->m_Registry;
-		auto idView = srcSceneReg.view<Components::ID>();
 
-		std::unordered_map<UUID, entt::entity> entityMap;
-
-		for (auto e : idView)
+		// The copy keeps the entity identifiers, so the UUID index and the cached hierarchy carry over unchanged
+		for (auto entity : srcSceneReg.view<Components::ID>())
 		{
-			Entity entity{e, src.get()};
-			UUID uuid = entity.GetUUID();
-			const auto& name = entity.GetComponent<Components::Tag>().TagName;
+			[[maybe_unused]] entt::entity created = dstSceneReg.create(entity);
+			AC_CORE_ASSERT(created == entity, "Entity could not be copied with its identifier");
+		}
+		dst->m_EntityMap = src->m_EntityMap;
 
-			entt::entity newEntity = dst->CreateEntity(name, uuid);
+		Components::SceneComponents::ForEach([&](auto type)
+			{
+				ClonePool<typename decltype(type)::type>(dstSceneReg, srcSceneReg);
+			});
+		ClonePool<Components::WorldTransform>(dstSceneReg, srcSceneReg);
+		dst->m_HierarchyChanged = src->m_HierarchyChanged;
 
-			entityMap[uuid] = newEntity;
+		// Relationships hold handles of the source scene, only the scene they point into changes
+		for (auto&& [e, parent] : dstSceneReg.view<Components::ParentRelationship>().each())
+		{
+			parent.Parent = Entity{parent.Parent, dst.get()};
 		}
 
-		CopyComponent<Components::Transform>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::SpriteRenderer>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::CircleRenderer>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::CameraComponent>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::NativeScript>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::JSScript>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::RigidBody2d>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::BoxCollider2d>(dstSceneReg, srcSceneReg, entityMap);
-		CopyComponent<Components::CircleCollider2d>(dstSceneReg, srcSceneReg, entityMap);
+		for (auto&& [e, children] : dstSceneReg.view<Components::ChildRelationship>().each())
+		{
+			for (Entity& child : children.Entities)
+			{
+				child = Entity{child, dst.get()};
+			}
+		}
 
 		return dst;
 	}
 
 	Entity Scene::DuplicateEntity(Entity entity)
 	{
+		AC_PROFILE_FUNCTION();
 		std::string name = entity.GetName();
 		name += " - Copy";
 
 		Entity newEntity = CreateEntity(name);
 
-		auto& newTransform = newEntity.GetComponent<Components::Transform>();
-		auto oldTransform = entity.GetComponent<Components::Transform>();
-		newTransform.Translation = oldTransform.Translation;
-		newTransform.Rotation = oldTransform.Rotation;
-		newTransform.Scale = oldTransform.Scale;
-
-		if (entity.HasComponent<Components::SpriteRenderer>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::SpriteRenderer>(entity.GetComponent<Components::SpriteRenderer>());
-		}
-		if (entity.HasComponent<Components::CircleRenderer>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::CircleRenderer>(entity.GetComponent<Components::CircleRenderer>());
-		}
-
-		if (entity.HasComponent<Components::CameraComponent>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::CameraComponent>(entity.GetComponent<Components::CameraComponent>());
-		}
-
-		if (entity.HasComponent<Components::NativeScript>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::NativeScript>(entity.GetComponent<Components::NativeScript>());
-		}
-
-		if (entity.HasComponent<Components::JSScript>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::JSScript>(entity.GetComponent<Components::JSScript>());
-		}
-
-		if (entity.HasComponent<Components::RigidBody2d>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::RigidBody2d>(entity.GetComponent<Components::RigidBody2d>());
-		}
+		Components::DuplicatedComponents::ForEach([&](auto type)
+			{
+				using Component = typename decltype(type)::type;
+				if (!entity.HasComponent<Component>())
+					return;
 
-		if (entity.HasComponent<Components::BoxCollider2d>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::BoxCollider2d>(entity.GetComponent<Components::BoxCollider2d>());
-		}
-
-		if (entity.HasComponent<Components::CircleCollider2d>())
-		{
-			// Call the copy constructor
-			newEntity.AddComponent<Components::CircleCollider2d>(entity.GetComponent<Components::CircleCollider2d>());
-		}
+				// Transform already exists on the new entity
+				auto& component = m_Registry.emplace_or_replace<Component>(newEntity, entity.GetComponent<Component>());
+				OnComponentAdded(newEntity, component);
+			});
 
 		// TODO figure out relations
 
@@ -178,98 +286,179 @@ namespace Acorn
 		AC_PROFILE_FUNCTION();
 		Entity entity = {m_Registry.create(), this};
 		entity.AddComponent<Components::ID>(uuid);
+
+		bool inserted = m_EntityMap.emplace(uuid, entity).second;
+		AC_CORE_ASSERT(inserted, "An entity with this UUID already exists");
 		entity.AddComponent<Components::Transform>();
+		entity.AddComponent<Components::WorldTransform>();
 		auto& tag = entity.AddComponent<Components::Tag>();
 		tag.TagName = name.empty() ? "Entity" : name;
 
 		return entity;
 	}
 
-	void Scene::DestroyEntity(Entity entity)
+	void Scene::CreateEntities(const std::vector<UUID>& uuids, std::vector<entt::entity>& entities)
 	{
 		AC_PROFILE_FUNCTION();
-		m_Registry.destroy(entity);
+		entities.resize(uuids.size());
+		m_Registry.create(entities.begin(), entities.end());
+
+		// Bulk insertion copies from a range of the component type itself
+		std::vector<Components::ID> ids(uuids.begin(), uuids.end());
+		m_Registry.insert<Components::ID>(entities.begin(), entities.end(), ids.begin());
+		m_Registry.insert<Components::Transform>(entities.begin(), entities.end());
+		m_Registry.insert<Components::WorldTransform>(entities.begin(), entities.end());
+		m_Registry.insert<Components::Tag>(entities.begin(), entities.end(), Components::Tag("Entity"));
+
+		m_EntityMap.reserve(m_EntityMap.size() + uuids.size());
+		for (size_t i = 0; i < uuids.size(); i++)
+		{
+			bool inserted = m_EntityMap.emplace(uuids[i], entities[i]).second;
+			AC_CORE_ASSERT(inserted, "An entity with this UUID already exists");
+		}
 	}
 
-	Entity Scene::GetEntity(const UUID& uuid)
+	void Scene::DestroyEntity(Entity entity)
 	{
 		AC_PROFILE_FUNCTION();
-		auto view = m_Registry.view<Components::ID>();
 
-		for (auto entity : view)
+		// Orphaned children become roots and keep their place in the world
+		if (entity.HasComponent<Components::ChildRelationship>())
 		{
-			if (m_Registry.get<Components::ID>(entity).UUID == uuid)
+			auto children = entity.GetComponent<Components::ChildRelationship>().Entities;
+			for (Entity child : children)
 			{
-				return Entity{entity, this};
+				glm::mat4 worldMatrix = child.GetWorldTransform();
+				child.RemoveComponent<Components::ParentRelationship>();
+				child.SetWorldTransform(worldMatrix);
 			}
 		}
 
-		return Entity{};
+		if (entity.HasComponent<Components::ParentRelationship>())
+		{
+			Entity parent = entity.GetComponent<Components::ParentRelationship>().Parent;
+			parent.GetComponent<Components::ChildRelationship>().RemoveEntity(entity);
+		}
+
+		m_EntityMap.erase(entity.GetUUID());
+		m_Registry.destroy(entity);
+	}
+
+	Entity Scene::GetEntity(const UUID& uuid)
+	{
+		AC_PROFILE_FUNCTION();
+		auto it = m_EntityMap.find(uuid);
+		if (it == m_EntityMap.end())
+			return Entity{};
+
+		return Entity{it->second, this};
 	}
 
 	void Scene::InitializeRuntime()
 	{
 		AC_PROFILE_FUNCTION();
-		m_PhysicsWorld = new b2World(b2Vec2(0.0f, -9.8f));
+		m_PhysicsWorld = CreateScope<Physics2D::World>(glm::vec2(0.0f, -9.8f), m_Options.Physics);
+		m_PhysicsEntities.clear();
+
+		UpdateWorldTransforms();
 
 		auto rigidBodies = m_Registry.view<Components::RigidBody2d>();
+		m_PhysicsWorld->ReserveBodies(rigidBodies.size() + 1);
+		m_PhysicsEntities.reserve(rigidBodies.size() + 1);
+		m_StaticGeometry->Begin(rigidBodies.size());
+
 		for (auto e : rigidBodies)
 		{
-			Entity entity = {e, this};
-			// TODO check if using the registry is faster
-			auto& transform = entity.GetComponent<Components::Transform>();
-			auto& rigidBody = entity.GetComponent<Components::RigidBody2d>();
+			auto& transform = m_Registry.get<Components::Transform>(e);
+			auto& rigidBody = rigidBodies.get<Components::RigidBody2d>(e);
+			auto* boxCollider = m_Registry.try_get<Components::BoxCollider2d>(e);
+			auto* circleCollider = m_Registry.try_get<Components::CircleCollider2d>(e);
+			bool hasParent = m_Registry.all_of<Components::ParentRelationship>(e);
+
+			// Static boxes, e.g. tiles, are merged onto one shared body below
+			if (rigidBody.Type == Components::RigidBody2d::BodyType::Static && boxCollider && !circleCollider && !hasParent)
+			{
+				float angle = transform.Rotation.z;
+				const glm::vec2& offset = boxCollider->GetOffset();
+				float c = glm::cos(angle), s = glm::sin(angle);
+
+				Physics2D::StaticBox box;
+				box.Center = glm::vec2(transform.Translation) + glm::vec2(c * offset.x - s * offset.y, s * offset.x + c * offset.y);
+				box.HalfSize = boxCollider->GetSize() * glm::vec2(transform.Scale);
+				box.Angle = angle;
+				box.Material = {rigidBody.Density, rigidBody.Friction, rigidBody.Restitution, rigidBody.RestitutionThreshold};
+				box.Owner = (uint32_t)e;
+				m_StaticGeometry->Add(box);
+				continue;
+			}
 
 			b2BodyDef bodyDef;
 			bodyDef.type = GetBodyType(rigidBody.Type);
 			bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
 			bodyDef.angle = transform.Rotation.z;
+			if (hasParent)
+			{
+				// Bodies live in world space
+				const glm::mat4& worldMatrix = m_Registry.get<Components::WorldTransform>(e).Matrix;
+				bodyDef.position.Set(worldMatrix[3].x, worldMatrix[3].y);
+				bodyDef.angle = glm::atan(worldMatrix[0].y, worldMatrix[0].x);
+			}
 
-			b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
+			b2Body* body = m_PhysicsWorld->GetB2World()->CreateBody(&bodyDef);
 			body->SetFixedRotation(rigidBody.FixedRotation);
 
 			rigidBody.RuntimeBody = body;
+			m_PhysicsWorld->AddBody(body);
+			m_PhysicsEntities.push_back(e);
 
-			if (entity.HasComponent<Components::BoxCollider2d>())
-			{
-				auto& boxCollider = entity.GetComponent<Components::BoxCollider2d>();
-				boxCollider.CreateFixture(entity, transform);
-				// auto& collider = entity.GetComponent<Components::BoxCollider2d>();
+			if (boxCollider)
+				boxCollider->CreateFixture(body, rigidBody, transform);
+			if (circleCollider)
+				circleCollider->CreateFixture(body, rigidBody, transform);
+		}
 
-				// b2PolygonShape shape;
-				// shape.SetAsBox(collider.Size.x * transform.Scale.x, collider.Size.y * transform.Scale.y, b2Vec2{collider.Offset.x, collider.Offset.y}, 0.0f);
+		if (!m_StaticGeometry->IsEmpty())
+		{
+			AC_PROFILE_SCOPE("Scene::InitializeRuntime (Static colliders)");
+			bool reused = m_StaticGeometry->Build();
 
-				// b2FixtureDef fixtureDef;
-				// fixtureDef.shape = &shape;
-				// fixtureDef.density = rigidBody.Density;
-				// fixtureDef.friction = rigidBody.Friction;
-				// fixtureDef.restitution = rigidBody.Restitution;
-				// fixtureDef.restitutionThreshold = rigidBody.RestitutionThreshold;
+			b2BodyDef bodyDef;
+			b2Body* staticBody = m_PhysicsWorld->GetB2World()->CreateBody(&bodyDef);
+			m_PhysicsWorld->AddBody(staticBody);
+			// Belongs to no entity, the writeback skips it
+			m_PhysicsEntities.push_back(entt::null);
 
-				// collider.RuntimeFixture = body->CreateFixture(&fixtureDef);
-			}
-			if (entity.HasComponent<Components::CircleCollider2d>())
+			for (const auto& merged : m_StaticGeometry->GetMergedBoxes())
 			{
-				auto& collider = entity.GetComponent<Components::CircleCollider2d>();
-				collider.CreateFixture(entity, transform);
-
-				// b2CircleShape shape;
-				// shape.m_p.Set(collider.Offset.x, collider.Offset.y);
-				// shape.m_radius = collider.Radius * transform.Scale.z; //TODO think about scaling axis
-
-				// b2FixtureDef fixtureDef;
-				// fixtureDef.shape = &shape;
-				// fixtureDef.density = rigidBody.Density;
-				// fixtureDef.friction = rigidBody.Friction;
-				// fixtureDef.restitution = rigidBody.Restitution;
-				// fixtureDef.restitutionThreshold = rigidBody.RestitutionThreshold;
-
-				// collider.RuntimeFixture = body->CreateFixture(&fixtureDef);
+				b2PolygonShape shape;
+				shape.SetAsBox(merged.HalfSize.x, merged.HalfSize.y, b2Vec2{merged.Center.x, merged.Center.y}, merged.Angle);
+
+				b2FixtureDef fixtureDef;
+				fixtureDef.shape = &shape;
+				fixtureDef.density = merged.Material.Density;
+				fixtureDef.friction = merged.Material.Friction;
+				fixtureDef.restitution = merged.Material.Restitution;
+				fixtureDef.restitutionThreshold = merged.Material.RestitutionThreshold;
+				b2Fixture* fixture = staticBody->CreateFixture(&fixtureDef);
+
+				for (uint32_t i = merged.FirstMember; i < merged.FirstMember + merged.MemberCount; i++)
+				{
+					const Physics2D::StaticBox& box = m_StaticGeometry->GetMember(i);
+					entt::entity e = (entt::entity)box.Owner;
+					m_Registry.get<Components::RigidBody2d>(e).RuntimeBody = staticBody;
+					m_Registry.get<Components::BoxCollider2d>(e).AttachStaticFixture(fixture, box.Center, box.HalfSize, box.Angle);
+				}
 			}
+
+			if (reused)
+				AC_CORE_TRACE("Reused {} merged static colliders of the last run", m_StaticGeometry->GetMergedBoxes().size());
 		}
+		m_PhysicsWorld->Start();
 
 		// Setup v8
 #ifndef NO_SCRIPTING
+		if (V8Engine::instance().isRunning())
+			V8Engine::instance().BeginHeapMeasurement();
 
 		auto view = m_Registry.view<Components::JSScript>();
 		for (auto entity : view)
@@ -285,6 +474,8 @@ namespace Acorn
 				AC_CORE_WARN("Undefined script in {}", tag);
 			}
 		}
+		if (V8Engine::instance().isRunning())
+			V8Engine::instance().ReportHeapUsage();
 #endif // !NO_SCRIPTING
 	}
 
@@ -306,30 +497,20 @@ namespace Acorn
 
 #endif // !(NO_SCRIPTING)
 
-		delete m_PhysicsWorld;
-		m_PhysicsWorld = nullptr;
+		// Stops the physics thread before the bodies go away
+		m_PhysicsWorld.reset();
+		m_PhysicsEntities.clear();
 	}
 
 	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
 	{
 		AC_PROFILE_FUNCTION();
-		ext2d::Renderer::BeginScene(camera);
-		{
-			auto group = m_Registry.group<Components::Transform>(entt::get<Components::SpriteRenderer>);
-
-			for (auto&& [entity, transform, sprite] : group.each())
-			{
-				ext2d::Renderer::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-			}
-		}
+		UpdateWorldTransforms();
 
-		{
-			auto view = m_Registry.view<Components::Transform, Components::CircleRenderer>();
-			for (auto&& [entity, transform, circle] : view.each())
-			{
-				ext2d::Renderer::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade, (int)entity);
-			}
-		}
+		ext2d::Renderer::BeginScene(camera);
+		CollectVisible(camera.GetViewProjection());
+		RenderSprites();
+		RenderCircles();
 
 		ext2d::Renderer::EndScene();
 
@@ -337,28 +518,28 @@ namespace Acorn
 			AC_PROFILE_SCOPE("Scene::OnEditorUpdate (DebugRendering)");
 			debug::Renderer::Begin(camera);
 
-			auto cameraGroup = m_Registry.group<Components::CameraComponent>(entt::get<Components::Transform>);
+			auto cameraGroup = m_Registry.group<Components::CameraComponent>(entt::get<Components::WorldTransform>);
 			for (auto&& [entity, camera, transform] : cameraGroup.each())
 			{
 				if (m_Options.ShowIcons)
-					debug::Renderer::DrawGizmo(debug::GizmoType::Camera, transform.Translation, (int)entity);
+					debug::Renderer::DrawGizmo(debug::GizmoType::Camera, glm::vec3(transform.Matrix[3]), (int)entity);
 				if (m_Options.ShowCameraFrustums)
-					debug::Renderer::DrawCameraFrustum(camera, transform);
+					debug::Renderer::DrawCameraFrustum(camera, transform.Matrix);
 			}
 
-			auto b2dColliderGroup = m_Registry.group<Components::BoxCollider2d>(entt::get<Components::Transform>);
+			auto b2dColliderGroup = m_Registry.group<Components::BoxCollider2d>(entt::get<Components::WorldTransform>);
 			for (auto&& [entity, collider, transform] : b2dColliderGroup.each())
 			{
 				// TODO Think about, if we even need zDepth for colliders?
 				if (m_Options.ShowColliders)
-					debug::Renderer::DrawB2dCollider(collider, transform);
+					debug::Renderer::DrawB2dCollider(collider, transform.Matrix);
 			}
 
-			auto b2dCircleColliderGroup = m_Registry.group<Components::CircleCollider2d>(entt::get<Components::Transform>);
+			auto b2dCircleColliderGroup = m_Registry.group<Components::CircleCollider2d>(entt::get<Components::WorldTransform>);
 			for (auto&& [entity, collider, transform] : b2dCircleColliderGroup.each())
 			{
 				if (m_Options.ShowColliders)
-					debug::Renderer::DrawB2dCollider(collider, transform);
+					debug::Renderer::DrawB2dCollider(collider, transform.Matrix);
 			}
 
 			// TODO show circle colliders
@@ -372,18 +553,21 @@ namespace Acorn
 		AC_PROFILE_FUNCTION();
 
 		// Render 2D
+		// World matrices are from the end of the last frame until physics has run
 		Camera* mainCamera = nullptr;
+		entt::entity mainCameraEntity = entt::null;
 		glm::mat4 cameraTransform;
 		{
-			auto view = m_Registry.view<Components::Transform, Components::CameraComponent>();
+			auto view = m_Registry.view<Components::WorldTransform, Components::CameraComponent>();
 			for (auto entity : view)
 			{
-				auto [transform, camera] = view.get<Components::Transform, Components::CameraComponent>(entity);
+				auto [transform, camera] = view.get<Components::WorldTransform, Components::CameraComponent>(entity);
 
 				if (camera.Primary)
 				{
 					mainCamera = &camera.Camera;
-					cameraTransform = transform.GetTransform();
+					mainCameraEntity = entity;
+					cameraTransform = transform.Matrix;
 					break;
 				}
 			}
@@ -410,60 +594,58 @@ namespace Acorn
 			V8Data& data = V8Engine::instance().GetData();
 			data.PrimaryCameraViewProjectionMatrix = mainCamera->GetProjection() * glm::inverse(cameraTransform);
 
-			m_Registry.view<Components::JSScript>().each(
-				[=](auto entity, Components::JSScript& jsc)
-				{
-					if (jsc.Script != nullptr)
-					{
-						jsc.Script->OnUpdate(ts);
-					}
-				});
+			V8Engine::instance().UpdateScripts(ts, m_Options.BatchScriptUpdates);
 		}
 #endif
 
 		// Physics
 		{
-			const int32_t velocityIterations = 6;
-			const int32_t positionIterations = 2;
+			AC_PROFILE_SCOPE("Scene::OnUpdateRuntime (Physics)");
+			m_PhysicsWorld->Advance(ts);
 
-			m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
-
-			auto view = m_Registry.view<Components::RigidBody2d>();
-			for (auto e : view)
+			// Only bodies that moved since the last frame, static and sleeping ones keep the transform they were last given
+			for (uint32_t i : m_PhysicsWorld->GetMovingBodies())
 			{
-				Entity entity = {e, this};
-				auto& rigidBody = entity.GetComponent<Components::RigidBody2d>();
-				auto& transform = entity.GetComponent<Components::Transform>();
+				entt::entity entity = m_PhysicsEntities[i];
 
-				b2Body* body = static_cast<b2Body*>(rigidBody.RuntimeBody);
-				b2Vec2 position = body->GetPosition();
+				// Scripts can destroy entities, their bodies simply stay behind
+				if (!m_Registry.valid(entity))
+					continue;
 
-				transform.Translation.x = position.x;
-				transform.Translation.y = position.y;
+				// Between the last two steps, so motion stays smooth when frames and steps do not line up
+				Physics2D::BodyState state = m_PhysicsWorld->GetInterpolatedState(i);
 
-				transform.Rotation.z = body->GetAngle();
+				if (m_Registry.all_of<Components::ParentRelationship>(entity))
+				{
+					// The body is in world space, keep the depth and scale the entity had last frame
+					const glm::mat4& lastMatrix = m_Registry.get<Components::WorldTransform>(entity).Matrix;
+					glm::vec3 scale = {glm::length(glm::vec3(lastMatrix[0])), glm::length(glm::vec3(lastMatrix[1])), glm::length(glm::vec3(lastMatrix[2]))};
+
+					glm::mat4 worldMatrix = glm::translate(glm::mat4(1.0f), {state.Position.x, state.Position.y, lastMatrix[3].z}) *
+											glm::rotate(glm::mat4(1.0f), state.Angle, {0.0f, 0.0f, 1.0f}) *
+											glm::scale(glm::mat4(1.0f), scale);
+					Entity{entity, this}.SetWorldTransform(worldMatrix);
+					continue;
+				}
+
+				// UpdateWorldTransforms notices the new values, no flag needed
+				auto& transform = m_Registry.get<Components::Transform>(entity);
+				transform.Translation.x = state.Position.x;
+				transform.Translation.y = state.Position.y;
+				transform.Rotation.z = state.Angle;
 			}
+			m_PhysicsWorld->ClearMovingBodies();
 		}
 
+		UpdateWorldTransforms();
+
 		if (mainCamera)
 		{
+			cameraTransform = m_Registry.get<Components::WorldTransform>(mainCameraEntity).Matrix;
 			ext2d::Renderer::BeginScene(*mainCamera, cameraTransform);
-
-			{
-				auto group = m_Registry.group<Components::Transform>(entt::get<Components::SpriteRenderer>);
-				for (auto&& [entity, transform, sprite] : group.each())
-				{
-					ext2d::Renderer::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-				}
-			}
-
-			{
-				auto view = m_Registry.view<Components::Transform, Components::CircleRenderer>();
-				for (auto&& [entity, transform, circle] : view.each())
-				{
-					ext2d::Renderer::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade, (int)entity);
-				}
-			}
+			CollectVisible(mainCamera->GetProjection() * glm::inverse(cameraTransform));
+			RenderSprites();
+			RenderCircles();
 
 			ext2d::Renderer::EndScene();
 		}
@@ -495,25 +677,464 @@ namespace Acorn
 		AC_PROFILE_FUNCTION();
 		AC_CORE_ASSERT(entity.HasComponent<Components::CameraComponent>(), "Entity does not have a camera component");
 		auto& camera = entity.GetComponent<Components::CameraComponent>();
-		auto& transform = entity.GetComponent<Components::Transform>();
+		auto& transform = entity.GetComponent<Components::WorldTransform>();
 
-		ext2d::Renderer::BeginScene(camera.Camera, transform.GetTransform());
+		ext2d::Renderer::BeginScene(camera.Camera, transform.Matrix);
+		CollectVisible(camera.Camera.GetProjection() * glm::inverse(transform.Matrix));
+		RenderSprites();
+		ext2d::Renderer::EndScene();
+	}
+
+	void Scene::CollectVisible(const glm::mat4& viewProjection)
+	{
+		AC_PROFILE_FUNCTION();
+		m_SpriteEntities.clear();
+		m_CircleEntities.clear();
 
-		auto group = m_Registry.group<Components::Transform>(entt::get<Components::SpriteRenderer>);
-		for (auto&& [entity, transform, sprite] : group.each())
+		// WorldTransform is sorted by depth, so the group can not own it
+		auto group = m_Registry.group<Components::SpriteRenderer>(entt::get<Components::WorldTransform>);
+		auto circles = m_Registry.view<Components::WorldTransform, Components::CircleRenderer>();
+		if (!m_Options.FrustumCulling)
 		{
-			ext2d::Renderer::DrawSprite(transform.GetTransform(), sprite, (int)entity);
+			m_SpriteEntities.assign(group.begin(), group.end());
+			m_CircleEntities.assign(circles.begin(), circles.end());
+			ext2d::Renderer::RecordCulling((uint32_t)(m_SpriteEntities.size() + m_CircleEntities.size()), 0);
+			return;
 		}
 
-		ext2d::Renderer::EndScene();
+		auto& spritePool = m_Registry.storage<Components::SpriteRenderer>();
+		auto& circlePool = m_Registry.storage<Components::CircleRenderer>();
+
+		// Bounds are up to date, UpdateWorldTransforms ran this frame
+		Math::Frustum frustum(viewProjection);
+		m_Bounds.Query([&](const Math::AABB& box)
+			{
+				return frustum.Intersects(box);
+			},
+			[&](uint32_t data)
+			{
+				entt::entity entity = (entt::entity)data;
+				if (!frustum.Intersects(Math::AABB::FromQuad(m_Registry.get<Components::WorldTransform>(entity).Matrix)))
+					return;
+
+				if (spritePool.contains(entity))
+					m_SpriteEntities.push_back(entity);
+				if (circlePool.contains(entity))
+					m_CircleEntities.push_back(entity);
+			});
+
+		// The tree hands them out in any order, draws have to keep theirs
+		std::sort(m_SpriteEntities.begin(), m_SpriteEntities.end(), [&](entt::entity a, entt::entity b)
+			{
+				return spritePool.index(a) < spritePool.index(b);
+			});
+		std::sort(m_CircleEntities.begin(), m_CircleEntities.end(), [&](entt::entity a, entt::entity b)
+			{
+				return circlePool.index(a) < circlePool.index(b);
+			});
+
+		uint32_t visible = (uint32_t)(m_SpriteEntities.size() + m_CircleEntities.size());
+		ext2d::Renderer::RecordCulling(visible, (uint32_t)(group.size() + circlePool.size()) - visible);
+	}
+
+	void Scene::RenderSprites()
+	{
+		AC_PROFILE_FUNCTION();
+		auto group = m_Registry.group<Components::SpriteRenderer>(entt::get<Components::WorldTransform>);
+
+		if (!m_Options.ParallelSprites)
+		{
+			for (entt::entity entity : m_SpriteEntities)
+			{
+				auto [sprite, transform] = group.get<Components::SpriteRenderer, Components::WorldTransform>(entity);
+				ext2d::Renderer::DrawSprite(transform.Matrix, sprite, (int)entity);
+			}
+			return;
+		}
+
+		ext2d::Renderer::DrawSprites((uint32_t)m_SpriteEntities.size(), [&](uint32_t index)
+			{
+				entt::entity entity = m_SpriteEntities[index];
+				const auto& [sprite, transform] = group.get<Components::SpriteRenderer, Components::WorldTransform>(entity);
+				return ext2d::SpriteDrawData{transform.Matrix, &sprite, (int)entity};
+			});
+	}
+
+	void Scene::RenderCircles()
+	{
+		AC_PROFILE_FUNCTION();
+		for (entt::entity entity : m_CircleEntities)
+		{
+			const auto& transform = m_Registry.get<Components::WorldTransform>(entity);
+			const auto& circle = m_Registry.get<Components::CircleRenderer>(entity);
+			ext2d::Renderer::DrawCircle(transform.Matrix, circle.Color, circle.Thickness, circle.Fade, (int)entity);
+		}
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		AC_PROFILE_FUNCTION();
+		if (m_HierarchyChanged)
+		{
+			SortHierarchy();
+		}
+
+		// Entities without bounds have no proxy, the rest follow their matrix
+		auto moveBounds = [this](entt::entity entity, const glm::mat4& matrix)
+		{
+			uint32_t index = (uint32_t)entt::to_entity(entity);
+			if (index < m_BoundsProxies.size() && m_BoundsProxies[index] != Math::AABBTree::Null)
+				UpdateBounds(entity, matrix);
+		};
+
+		// Parents come first, so a changed entity rebuilds its subtree before the sweep gets to any of it.
+		// Untouched entities only compare their local values, the parent is never looked up for them
+		std::vector<entt::entity> subtree;
+		auto view = m_Registry.view<Components::WorldTransform>();
+		for (auto&& [entity, worldTransform] : view.each())
+		{
+			const auto& transform = m_Registry.get<Components::Transform>(entity);
+			if (!worldTransform.IsStale(transform))
+				continue;
+
+			const auto* parent = m_Registry.try_get<Components::ParentRelationship>(entity);
+			worldTransform.Rebuild(transform, parent ? view.get<Components::WorldTransform>(parent->Parent).Matrix : glm::mat4(1.0f));
+			moveBounds(entity, worldTransform.Matrix);
+
+			subtree.push_back(entity);
+			while (!subtree.empty())
+			{
+				entt::entity node = subtree.back();
+				subtree.pop_back();
+
+				auto* children = m_Registry.try_get<Components::ChildRelationship>(node);
+				if (children == nullptr)
+					continue;
+
+				const glm::mat4& matrix = view.get<Components::WorldTransform>(node).Matrix;
+				for (Entity child : children->Entities)
+				{
+					auto& childTransform = view.get<Components::WorldTransform>(child);
+					childTransform.Rebuild(m_Registry.get<Components::Transform>(child), matrix);
+					moveBounds(child, childTransform.Matrix);
+					subtree.push_back(child);
+				}
+			}
+		}
+
+		if (m_BoundsStale)
+		{
+			RebuildBounds();
+			return;
+		}
+
+		for (entt::entity entity : m_BoundsPending)
+		{
+			// Destroyed entities already lost their bounds with their WorldTransform
+			if (!m_Registry.valid(entity) || !m_Registry.all_of<Components::WorldTransform>(entity))
+				continue;
+
+			if (m_Registry.any_of<Components::SpriteRenderer, Components::CircleRenderer, Components::CameraComponent, Components::BoxCollider2d,
+					Components::CircleCollider2d>(entity))
+				UpdateBounds(entity, m_Registry.get<Components::WorldTransform>(entity).Matrix);
+			else
+				RemoveBounds(entity);
+		}
+		m_BoundsPending.clear();
+	}
+
+	Entity Scene::Pick(const Math::Ray& ray)
+	{
+		AC_PROFILE_FUNCTION();
+		entt::entity nearest = entt::null;
+		float nearestDistance = std::numeric_limits<float>::max();
+
+		m_Bounds.Query([&](const Math::AABB& box)
+			{
+				float distance;
+				return ray.Intersects(box, distance) && distance < nearestDistance;
+			},
+			[&](uint32_t data)
+			{
+				entt::entity entity = (entt::entity)data;
+				float distance;
+				if (HitTest(m_Registry, entity, ray, distance) && distance < nearestDistance)
+				{
+					nearest = entity;
+					nearestDistance = distance;
+				}
+			});
+
+		return {nearest, this};
+	}
+
+	void Scene::QueryFrustum(const Math::Frustum& frustum, std::vector<Entity>& entities)
+	{
+		AC_PROFILE_FUNCTION();
+		entities.clear();
+		m_Bounds.Query([&](const Math::AABB& box)
+			{
+				return frustum.Intersects(box);
+			},
+			[&](uint32_t data)
+			{
+				// The tree only knows the enlarged boxes
+				entt::entity entity = (entt::entity)data;
+				if (frustum.Intersects(GetBounds(m_Registry, entity, m_Registry.get<Components::WorldTransform>(entity).Matrix)))
+					entities.push_back({entity, this});
+			});
+	}
+
+	void Scene::QueryColliders(const glm::vec2& point, std::vector<Entity>& entities)
+	{
+		AC_PROFILE_FUNCTION();
+		entities.clear();
+		m_Bounds.Query([&](const Math::AABB& box)
+			{
+				return point.x >= box.Min.x && point.x <= box.Max.x && point.y >= box.Min.y && point.y <= box.Max.y;
+			},
+			[&](uint32_t data)
+			{
+				entt::entity entity = (entt::entity)data;
+				if (ColliderContains(m_Registry, entity, point))
+					entities.push_back({entity, this});
+			});
+	}
+
+	void Scene::UpdateBounds(entt::entity entity, const glm::mat4& matrix)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_BoundsProxies.size())
+			m_BoundsProxies.resize(index + 1, Math::AABBTree::Null);
+
+		int32_t& proxy = m_BoundsProxies[index];
+		Math::AABB bounds = GetBounds(m_Registry, entity, matrix);
+		if (proxy == Math::AABBTree::Null)
+			proxy = m_Bounds.CreateProxy(bounds, (uint32_t)entity);
+		else
+			m_Bounds.MoveProxy(proxy, bounds);
+	}
+
+	void Scene::RemoveBounds(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_BoundsProxies.size() || m_BoundsProxies[index] == Math::AABBTree::Null)
+			return;
+
+		m_Bounds.DestroyProxy(m_BoundsProxies[index]);
+		m_BoundsProxies[index] = Math::AABBTree::Null;
+	}
+
+	void Scene::RebuildBounds()
+	{
+		AC_PROFILE_FUNCTION();
+		m_Bounds.Clear();
+		m_BoundsProxies.assign(m_BoundsProxies.size(), Math::AABBTree::Null);
+		m_BoundsPending.clear();
+
+		auto view = m_Registry.view<Components::WorldTransform>();
+		auto add = [&](entt::entity entity)
+		{
+			if (view.contains(entity))
+				UpdateBounds(entity, view.get<Components::WorldTransform>(entity).Matrix);
+		};
+		for (auto entity : m_Registry.view<Components::SpriteRenderer>())
+			add(entity);
+		for (auto entity : m_Registry.view<Components::CircleRenderer>())
+			add(entity);
+		for (auto entity : m_Registry.view<Components::CameraComponent>())
+			add(entity);
+		for (auto entity : m_Registry.view<Components::BoxCollider2d>())
+			add(entity);
+		for (auto entity : m_Registry.view<Components::CircleCollider2d>())
+			add(entity);
+
+		m_BoundsStale = false;
+	}
+
+	void Scene::OnBoundsChanged(entt::registry&, entt::entity entity)
+	{
+		if (!m_BoundsStale)
+			m_BoundsPending.push_back(entity);
+	}
+
+	void Scene::OnBoundsDestroyed(entt::registry&, entt::entity entity)
+	{
+		RemoveBounds(entity);
+	}
+
+	void Scene::SortHierarchy()
+	{
+		AC_PROFILE_FUNCTION();
+
+		std::vector<entt::entity> stack;
+		for (auto entity : m_Registry.view<Components::WorldTransform>(entt::exclude<Components::ParentRelationship>))
+		{
+			m_Registry.get<Components::WorldTransform>(entity).Depth = 0;
+			stack.push_back(entity);
+		}
+
+		while (!stack.empty())
+		{
+			entt::entity entity = stack.back();
+			stack.pop_back();
+
+			auto* children = m_Registry.try_get<Components::ChildRelationship>(entity);
+			if (children == nullptr)
+				continue;
+
+			uint32_t depth = m_Registry.get<Components::WorldTransform>(entity).Depth + 1;
+			for (Entity child : children->Entities)
+			{
+				m_Registry.get<Components::WorldTransform>(child).Depth = depth;
+				stack.push_back(child);
+			}
+		}
+
+		m_Registry.sort<Components::WorldTransform>([](const Components::WorldTransform& a, const Components::WorldTransform& b)
+			{
+				return a.Depth < b.Depth;
+			});
+		// Keep the local transforms in the same order, so the sweep reads both pools front to back
+		m_Registry.sort<Components::Transform, Components::WorldTransform>();
+		InvalidateScriptViews();
+
+		m_HierarchyChanged = false;
+	}
+
+	void Scene::OnHierarchyChanged(entt::registry&, entt::entity entity)
+	{
+		m_HierarchyChanged = true;
+
+		// The local values stay the same when an entity changes its parent, so the sweep would miss it
+		if (auto* worldTransform = m_Registry.try_get<Components::WorldTransform>(entity))
+			worldTransform->Dirty = true;
+	}
+
+	void Scene::OnTransformsMoved(entt::registry&, entt::entity)
+	{
+		InvalidateScriptViews();
+	}
+
+	void Scene::InvalidateScriptViews()
+	{
+#ifndef NO_SCRIPTING
+		if (V8Engine::instance().isRunning())
+			V8Engine::instance().InvalidateComponentViews();
+#endif // !NO_SCRIPTING
+	}
+
+	void Scene::GetTransformRuns(std::vector<std::span<Components::Transform>>& runs)
+	{
+		AC_PROFILE_FUNCTION();
+		runs.clear();
+
+		// Reverse iteration walks the packed array front to back
+		auto& storage = m_Registry.storage<Components::Transform>();
+		for (auto it = storage.rbegin(); it != storage.rend(); ++it)
+		{
+			Components::Transform* transform = &*it;
+			if (!runs.empty() && runs.back().data() + runs.back().size() == transform)
+				runs.back() = {runs.back().data(), runs.back().size() + 1};
+			else
+				runs.push_back({transform, 1});
+		}
+	}
+
+	void Scene::OnComponentChanged(entt::registry&, entt::entity entity)
+	{
+		m_ChangedEntities.insert(entity);
+	}
+
+	void Scene::OnEntityDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		m_ChangedEntities.erase(entity);
+		m_DestroyedIds.push_back(registry.get<Components::ID>(entity).UUID);
+	}
+
+	void Scene::EnableChangeTracking()
+	{
+		AC_PROFILE_FUNCTION();
+		if (m_TrackChanges)
+			return;
+
+		m_TrackChanges = true;
+		Components::SceneComponents::ForEach([&](auto type)
+			{
+				using Component = typename decltype(type)::type;
+				m_Registry.on_construct<Component>().template connect<&Scene::OnComponentChanged>(*this);
+				m_Registry.on_update<Component>().template connect<&Scene::OnComponentChanged>(*this);
+
+				// Losing the ID means the entity is gone, which is recorded by id instead
+				if constexpr (std::is_same_v<Component, Components::ID>)
+					m_Registry.on_destroy<Component>().template connect<&Scene::OnEntityDestroyed>(*this);
+				else
+					m_Registry.on_destroy<Component>().template connect<&Scene::OnComponentChanged>(*this);
+			});
+	}
+
+	void Scene::TakeChanges(std::vector<Entity>& changed, std::vector<UUID>& destroyed)
+	{
+		AC_PROFILE_FUNCTION();
+		changed.clear();
+		changed.reserve(m_ChangedEntities.size());
+		for (entt::entity entity : m_ChangedEntities)
+		{
+			// Components of a destroyed entity can be removed after its ID, which records it again
+			if (m_Registry.valid(entity) && m_Registry.all_of<Components::ID>(entity))
+				changed.push_back(Entity{entity, this});
+		}
+		m_ChangedEntities.clear();
+
+		destroyed = std::move(m_DestroyedIds);
+		m_DestroyedIds.clear();
 	}
 
 	void Scene::Snapshot()
 	{
+		AC_PROFILE_FUNCTION();
+		const SceneSnapshot* previous = m_Snapshots.empty() ? nullptr : m_Snapshots.back().get();
+		m_Snapshots.push_back(CreateRef<SceneSnapshot>(m_Registry, previous));
+
+		while (m_Snapshots.size() > std::max(m_Options.MaxSnapshots, 1u))
+		{
+			m_Snapshots.pop_front();
+		}
+	}
+
+	void Scene::LoadSnapshot(uint32_t slot)
+	{
+		AC_PROFILE_FUNCTION();
+		AC_CORE_ASSERT(slot < m_Snapshots.size(), "Snapshot slot out of range");
+		AC_CORE_ASSERT(!m_PhysicsWorld, "Snapshots can not be loaded while the scene is running");
+		if (slot >= m_Snapshots.size())
+			return;
+
+		m_Snapshots[slot]->Restore(m_Registry);
+
+		m_EntityMap.clear();
+		m_EntityMap.reserve(m_Snapshots[slot]->GetEntityCount());
+		for (auto&& [entity, id] : m_Registry.view<Components::ID>().each())
+		{
+			m_EntityMap.emplace(id.UUID, entity);
+		}
+		m_HierarchyChanged = true;
+		m_BoundsStale = true;
+		InvalidateScriptViews();
 	}
 
 	void Scene::LoadLastSnapshot()
 	{
+		if (!m_Snapshots.empty())
+			LoadSnapshot((uint32_t)m_Snapshots.size() - 1);
+	}
+
+	void Scene::DropSnapshots(uint32_t count)
+	{
+		for (uint32_t i = 0; i < count && !m_Snapshots.empty(); i++)
+		{
+			m_Snapshots.pop_back();
+		}
 	}
 
 	Entity Scene::GetPrimaryCameraEntity()
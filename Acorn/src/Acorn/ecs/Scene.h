@@ -1,6 +1,9 @@
 #pragma once
 
 #include "core/Timestep.h"
+#include "math/AABBTree.h"
+#include "physics/PhysicsWorld.h"
+#include "physics/StaticGeometry.h"
 #include "renderer/Camera.h"
 #include "renderer/EditorCamera.h"
 
@@ -10,18 +13,38 @@
 
 #include "core/UUID.h"
 
-class b2World;
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Acorn
 {
 	class Entity;
 	class SceneSerializer;
+	class SceneSnapshot;
+
+	namespace Components
+	{
+		struct Transform;
+	}
 
 	struct SceneOptions
 	{
 		bool ShowColliders = true;
 		bool ShowCameraFrustums = true;
 		bool ShowIcons = true;
+		// Generate sprite geometry on the engine thread pool
+		bool ParallelSprites = true;
+		// Only draw sprites and circles whose bounds are in view of the camera
+		bool FrustumCulling = true;
+		// Update all scripts of a file with one call into V8
+		bool BatchScriptUpdates = true;
+		// Oldest snapshots are dropped beyond this
+		uint32_t MaxSnapshots = 32;
+		// Read when the runtime starts
+		Physics2D::WorldSettings Physics;
 	};
 
 	class Scene
@@ -47,11 +70,98 @@ namespace Acorn
 
 		void RenderFromCamera(Entity entity);
 
+		/**
+		 * @brief Brings every Components::WorldTransform up to date in one parent-before-child pass.
+		 *
+		 * The transform pools are kept sorted by hierarchy depth, so this is a linear sweep. Only entities whose
+		 * local transform or parent changed, and their descendants, get their matrix rebuilt.
+		 */
+		void UpdateWorldTransforms();
+
 		SceneOptions& GetOptions() { return m_Options; }
 
+		/**
+		 * @brief Nearest sprite, circle or camera icon a ray hits, e.g. the one under the mouse.
+		 *
+		 * Goes through the bounds UpdateWorldTransforms keeps, so it sees the scene as of the last update.
+		 */
+		Entity Pick(const Math::Ray& ray);
+
+		/**
+		 * @brief Collects the sprites, circles, cameras and colliders whose bounds reach into a frustum.
+		 *
+		 * @param frustum
+		 *  E.g. the view of a camera, or a marquee selection from Math::Frustum::FromRect.
+		 */
+		void QueryFrustum(const Math::Frustum& frustum, std::vector<Entity>& entities);
+
+		/**
+		 * @brief Collects the entities whose box or circle collider contains a point in the xy plane.
+		 *
+		 * Tests the shapes the physics world builds from the components, so it works without a running simulation.
+		 */
+		void QueryColliders(const glm::vec2& point, std::vector<Entity>& entities);
+
+		/**
+		 * @brief Finds the sprites and circles a view projection sees, in the order of their pools.
+		 *
+		 * The render paths call it before drawing, the result is kept until the next call.
+		 */
+		void CollectVisible(const glm::mat4& viewProjection);
+		inline const std::vector<entt::entity>& GetVisibleSprites() const { return m_SpriteEntities; }
+		inline const std::vector<entt::entity>& GetVisibleCircles() const { return m_CircleEntities; }
+
+		/**
+		 * @brief Stores the entities and components of the scene in a new snapshot slot.
+		 *
+		 * Component pools that did not change since the previous snapshot are shared with it instead of copied.
+		 */
 		void Snapshot();
+
+		/**
+		 * @brief Puts the scene back into the state of a snapshot, which stays available.
+		 *
+		 * Entities keep their identifiers, so handles held by the editor stay valid. Only for scenes that are not
+		 * running, physics bodies are not part of a snapshot.
+		 *
+		 * @param slot
+		 *  Index of the snapshot, the oldest one is 0.
+		 */
+		void LoadSnapshot(uint32_t slot);
 		void LoadLastSnapshot();
 
+		/**
+		 * @brief Drops the newest snapshots, e.g. after restoring an older one for undo.
+		 */
+		void DropSnapshots(uint32_t count);
+		inline uint32_t GetSnapshotCount() const { return (uint32_t)m_Snapshots.size(); }
+
+		/**
+		 * @brief Starts recording which entities change, through the construct, update and destroy signals of entt.
+		 *
+		 * Off by default, so loading and copying scenes does not pay for it. Components that are written in place
+		 * are only seen if the writer calls Entity::MarkChanged.
+		 */
+		void EnableChangeTracking();
+
+		/**
+		 * @brief Hands out the changes recorded since the last call and starts a new recording.
+		 *
+		 * @param changed
+		 *  Receives the entities that were created or had a component added, updated or removed.
+		 * @param destroyed
+		 *  Receives the ids of the destroyed entities, in the order they were destroyed.
+		 */
+		void TakeChanges(std::vector<Entity>& changed, std::vector<UUID>& destroyed);
+
+		/**
+		 * @brief Splits the transform pool into runs of components that lie next to each other, in pool order.
+		 *
+		 * entt stores components in pages, a run never crosses one. The runs stay valid until a transform is added
+		 * or removed, or the hierarchy is sorted again.
+		 */
+		void GetTransformRuns(std::vector<std::span<Components::Transform>>& runs);
+
 		template <typename T>
 		std::vector<Entity> GetEntitiesWithComponent()
 		{
@@ -72,6 +182,33 @@ namespace Acorn
 		template <typename T>
 		void OnComponentAdded(Entity entity, T& component);
 
+		/**
+		 * @brief Creates entities in bulk, with the same components as CreateEntity.
+		 *
+		 * @param uuids
+		 *  Ids of the new entities, all of them have to be unused.
+		 * @param entities
+		 *  Receives the new entities in the same order.
+		 */
+		void CreateEntities(const std::vector<UUID>& uuids, std::vector<entt::entity>& entities);
+
+		void RenderSprites();
+		void RenderCircles();
+
+		void SortHierarchy();
+		void OnHierarchyChanged(entt::registry& registry, entt::entity entity);
+		void OnComponentChanged(entt::registry& registry, entt::entity entity);
+		void OnEntityDestroyed(entt::registry& registry, entt::entity entity);
+		// Scripts may hold views into the transform pool, which are dropped whenever it moves
+		void OnTransformsMoved(entt::registry& registry, entt::entity entity);
+		void InvalidateScriptViews();
+
+		void UpdateBounds(entt::entity entity, const glm::mat4& matrix);
+		void RemoveBounds(entt::entity entity);
+		void RebuildBounds();
+		void OnBoundsChanged(entt::registry& registry, entt::entity entity);
+		void OnBoundsDestroyed(entt::registry& registry, entt::entity entity);
+
 		inline const entt::registry& GetCurrentRegistry() const
 		{
 			return m_Registry;
@@ -82,10 +219,40 @@ namespace Acorn
 
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
-		b2World* m_PhysicsWorld = nullptr;
+		Scope<Physics2D::World> m_PhysicsWorld;
+		// Entity of every body, in the order of the state arrays of the physics world
+		std::vector<entt::entity> m_PhysicsEntities;
+		// Merged static colliders, shared with copies so the next play session can reuse them
+		Ref<Physics2D::StaticGeometry> m_StaticGeometry = CreateRef<Physics2D::StaticGeometry>();
+
+		// Kept in sync by CreateEntity and DestroyEntity
+		std::unordered_map<UUID, entt::entity> m_EntityMap;
 
 		SceneOptions m_Options;
 
+		// Set when the depth order of the transform pools is no longer valid
+		bool m_HierarchyChanged = true;
+
+		// Bounds of everything that can be picked or culled, kept up to date by UpdateWorldTransforms
+		Math::AABBTree m_Bounds;
+		// Proxy of an entity in m_Bounds, by entity index
+		std::vector<int32_t> m_BoundsProxies;
+		// Gained or lost a component with bounds since the last update
+		std::vector<entt::entity> m_BoundsPending;
+		// Set when pools were replaced wholesale, e.g. by a copy or a snapshot
+		bool m_BoundsStale = true;
+
+		// Entities of the sprite group, so worker threads can index into it
+		std::vector<entt::entity> m_SpriteEntities;
+		std::vector<entt::entity> m_CircleEntities;
+
+		std::deque<Ref<SceneSnapshot>> m_Snapshots;
+
+		// Recorded while change tracking is enabled
+		bool m_TrackChanges = false;
+		std::unordered_set<entt::entity> m_ChangedEntities;
+		std::vector<UUID> m_DestroyedIds;
+
 		friend class Entity;
 		friend class SceneHierarchyPanel;
 		friend class SceneSerializer;
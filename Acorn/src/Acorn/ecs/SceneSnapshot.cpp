@@ -0,0 +1,99 @@
+#include "acpch.h"
+
+#include "ecs/SceneSnapshot.h"
+
+#include "ecs/Entity.h"
+
+#include <algorithm>
+#include <concepts>
+
+namespace Acorn
+{
+	template <typename Component, typename Storage>
+	static bool PoolMatches(const PoolSnapshot<Component>& pool, const Storage& storage)
+	{
+		const entt::sparse_set& entities = storage;
+		if (pool.Entities.size() != entities.size())
+			return false;
+
+		return std::equal(entities.rbegin(), entities.rend(), pool.Entities.begin()) &&
+			   std::equal(storage.rbegin(), storage.rend(), pool.Values.begin());
+	}
+
+	template <typename Component>
+	void SceneSnapshot::Capture(entt::registry& registry, const SceneSnapshot* previous)
+	{
+		AC_PROFILE_FUNCTION();
+		auto& pool = std::get<Ref<const PoolSnapshot<Component>>>(m_Pools);
+
+		// The mutable overload always hands out a pool, creating an empty one if the scene never used the component
+		const auto& storage = registry.storage<Component>();
+		const entt::sparse_set& entities = storage;
+
+		// Comparing is cheaper than copying and keeps a history of small edits small
+		if constexpr (std::equality_comparable<Component>)
+		{
+			if (previous)
+			{
+				const auto& previousPool = std::get<Ref<const PoolSnapshot<Component>>>(previous->m_Pools);
+				if (PoolMatches(*previousPool, storage))
+				{
+					pool = previousPool;
+					m_SharedPoolCount++;
+					return;
+				}
+			}
+		}
+
+		// Reverse iteration walks the packed arrays front to back, so a restore keeps the order of the pool
+		auto copy = CreateRef<PoolSnapshot<Component>>();
+		copy->Entities.assign(entities.rbegin(), entities.rend());
+		copy->Values.assign(storage.rbegin(), storage.rend());
+		pool = copy;
+	}
+
+	template <typename Component>
+	void SceneSnapshot::RestorePool(entt::registry& registry) const
+	{
+		AC_PROFILE_FUNCTION();
+		const auto& pool = std::get<Ref<const PoolSnapshot<Component>>>(m_Pools);
+		registry.insert<Component>(pool->Entities.begin(), pool->Entities.end(), pool->Values.begin());
+	}
+
+	SceneSnapshot::SceneSnapshot(entt::registry& registry, const SceneSnapshot* previous)
+	{
+		AC_PROFILE_FUNCTION();
+		// Every entity has an ID, so this also covers entities without any other component
+		auto ids = registry.view<Components::ID>();
+		m_Entities.assign(ids.begin(), ids.end());
+
+		std::apply([&](auto&... pools)
+			{
+				(Capture<typename std::decay_t<decltype(*pools)>::ComponentType>(registry, previous), ...);
+			},
+			m_Pools);
+	}
+
+	void SceneSnapshot::Restore(entt::registry& registry) const
+	{
+		AC_PROFILE_FUNCTION();
+		registry.clear();
+
+		// Relationships and scripts store entity handles, so the identifiers have to come back unchanged
+		for (entt::entity entity : m_Entities)
+		{
+			[[maybe_unused]] entt::entity created = registry.create(entity);
+			AC_CORE_ASSERT(created == entity, "Snapshot entity could not be recreated with its identifier");
+		}
+
+		std::apply([&](auto&... pools)
+			{
+				(RestorePool<typename std::decay_t<decltype(*pools)>::ComponentType>(registry), ...);
+			},
+			m_Pools);
+
+		// Same order as the transforms, which were sorted by depth when the snapshot was taken
+		const auto& transforms = std::get<Ref<const PoolSnapshot<Components::Transform>>>(m_Pools);
+		registry.insert<Components::WorldTransform>(transforms->Entities.begin(), transforms->Entities.end());
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/Core.h"
+#include "ecs/components/ComponentRegistry.h"
+#include "ecs/components/Components.h"
+
+#include <entt/entt.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace Acorn
+{
+	/**
+	 * @brief Packed copy of one component pool, in the order of the pool.
+	 *
+	 * Immutable once captured, so snapshots can share it for as long as the pool does not change.
+	 */
+	template <typename Component>
+	struct PoolSnapshot
+	{
+		using ComponentType = Component;
+
+		std::vector<entt::entity> Entities;
+		std::vector<Component> Values;
+	};
+
+	/**
+	 * @brief Entities and components of a scene at one point in time, taken and restored by Scene.
+	 *
+	 * World transforms are not stored, they are rebuilt by the next Scene::UpdateWorldTransforms after a restore.
+	 */
+	class SceneSnapshot
+	{
+	public:
+		/**
+		 * @param previous
+		 *  Snapshot taken before this one, pools that still match it are shared instead of copied. May be null.
+		 */
+		SceneSnapshot(entt::registry& registry, const SceneSnapshot* previous);
+
+		/**
+		 * @brief Replaces everything in the registry with the snapshot, the entities keep their identifiers.
+		 */
+		void Restore(entt::registry& registry) const;
+
+		inline size_t GetEntityCount() const { return m_Entities.size(); }
+
+		/**
+		 * @return
+		 *  Number of pools shared with the previous snapshot.
+		 */
+		inline uint32_t GetSharedPoolCount() const { return m_SharedPoolCount; }
+
+	private:
+		template <typename... Component>
+		using Pools = std::tuple<Ref<const PoolSnapshot<Component>>...>;
+
+		template <typename Component>
+		void Capture(entt::registry& registry, const SceneSnapshot* previous);
+
+		template <typename Component>
+		void RestorePool(entt::registry& registry) const;
+
+	private:
+		std::vector<entt::entity> m_Entities;
+		Components::SceneComponents::Apply<Pools> m_Pools;
+		uint32_t m_SharedPoolCount = 0;
+	};
+}
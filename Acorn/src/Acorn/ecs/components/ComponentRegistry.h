@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ecs/components/Components.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Acorn::Components
+{
+	/**
+	 * @brief Compile time list of component types, so code that handles every component is written once.
+	 */
+	template <typename... Component>
+	struct TypeList
+	{
+		static constexpr size_t Count = sizeof...(Component);
+
+		/**
+		 * @brief Instantiates a template with the types of the list, e.g. a tuple of pools.
+		 */
+		template <template <typename...> typename Template>
+		using Apply = Template<Component...>;
+
+		/**
+		 * @param fn
+		 *  Called once per type, in list order, with a std::type_identity of the component.
+		 */
+		template <typename Fn>
+		static void ForEach(Fn&& fn)
+		{
+			(fn(std::type_identity<Component>{}), ...);
+		}
+	};
+
+	/**
+	 * @brief Name of a component in scene files, only defined for components that are serialized.
+	 */
+	template <typename Component>
+	struct Reflection;
+
+#define AC_REFLECT_COMPONENT(type, name)                   \
+	template <>                                            \
+	struct Reflection<type>                                \
+	{                                                      \
+		static constexpr const char* Name = name;          \
+	}
+
+	AC_REFLECT_COMPONENT(Tag, "Tag");
+	AC_REFLECT_COMPONENT(Transform, "Transform");
+	AC_REFLECT_COMPONENT(CameraComponent, "Camera");
+	AC_REFLECT_COMPONENT(SpriteRenderer, "SpriteRenderer");
+	AC_REFLECT_COMPONENT(CircleRenderer, "CircleRenderer");
+	AC_REFLECT_COMPONENT(JSScript, "JSScript");
+	AC_REFLECT_COMPONENT(RigidBody2d, "RigidBody2d");
+	AC_REFLECT_COMPONENT(BoxCollider2d, "BoxCollider2d");
+	AC_REFLECT_COMPONENT(CircleCollider2d, "CircleCollider2d");
+	AC_REFLECT_COMPONENT(ChildRelationship, "Children");
+
+#undef AC_REFLECT_COMPONENT
+
+	// Everything that belongs to the state of a scene, WorldTransform is a cache and can always be rebuilt
+	using SceneComponents = TypeList<ID,
+		Tag,
+		Transform,
+		SpriteRenderer,
+		CircleRenderer,
+		CameraComponent,
+		NativeScript,
+		JSScript,
+		RigidBody2d,
+		BoxCollider2d,
+		CircleCollider2d,
+		ParentRelationship,
+		ChildRelationship>;
+
+	// Copied onto a duplicated entity, which gets its own ID and Tag and starts without a place in the hierarchy
+	using DuplicatedComponents = TypeList<Transform,
+		SpriteRenderer,
+		CircleRenderer,
+		CameraComponent,
+		NativeScript,
+		JSScript,
+		RigidBody2d,
+		BoxCollider2d,
+		CircleCollider2d>;
+
+	// Written to YAML scenes under their reflected name, in file order
+#ifndef NO_SCRIPTING
+	using SerializedComponents = TypeList<Tag,
+		Transform,
+		CameraComponent,
+		SpriteRenderer,
+		CircleRenderer,
+		JSScript,
+		RigidBody2d,
+		BoxCollider2d,
+		CircleCollider2d,
+		ChildRelationship>;
+#else
+	using SerializedComponents = TypeList<Tag,
+		Transform,
+		CameraComponent,
+		SpriteRenderer,
+		CircleRenderer,
+		RigidBody2d,
+		BoxCollider2d,
+		CircleCollider2d,
+		ChildRelationship>;
+#endif // !NO_SCRIPTING
+}
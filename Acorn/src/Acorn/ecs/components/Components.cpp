@@ -8,46 +8,47 @@ namespace Acorn::Components
 	{
 		AC_PROFILE_FUNCTION();
 		AC_CORE_INFO("Adding child relationship {} -> {}", parent.GetComponent<Tag>().TagName, child.GetComponent<Tag>().TagName);
-		Entities.push_back(child);
 		if (child.HasComponent<ParentRelationship>())
 		{
 			child.GetComponent<ParentRelationship>().Parent.GetComponent<Components::ChildRelationship>().RemoveEntity(child);
 		}
+		Entities.push_back(child);
+		EntityIds.insert(child.GetUUID());
 		child.AddComponent<ParentRelationship>(parent);
+		parent.MarkChanged();
 	}
 
 	void ChildRelationship::RemoveEntity(Entity entity)
 	{
 		AC_PROFILE_FUNCTION();
+		entity.GetComponent<ParentRelationship>().Parent.MarkChanged();
 		Entities.erase(std::remove(Entities.begin(), Entities.end(), entity), Entities.end());
+		EntityIds.erase(entity.GetUUID());
 		entity.RemoveComponent<ParentRelationship>();
 	}
 
 	void ChildRelationship::Clear()
 	{
 		AC_PROFILE_FUNCTION();
+		if (!Entities.empty())
+			Entities.front().GetComponent<ParentRelationship>().Parent.MarkChanged();
+
 		for (Entity e : Entities)
 		{
 			e.RemoveComponent<ParentRelationship>();
 		}
 		Entities.clear();
+		EntityIds.clear();
 	}
 
 	bool ChildRelationship::Contains(const UUID& uuid)
 	{
-		AC_PROFILE_FUNCTION();
-		for (auto& entity : Entities)
-		{
-			if (entity.GetUUID() == uuid)
-				return true;
-		}
-		return false;
+		return EntityIds.find(uuid) != EntityIds.end();
 	}
 
 	bool ChildRelationship::Contains(Entity entity)
 	{
-		AC_PROFILE_FUNCTION();
-		return std::find(Entities.begin(), Entities.end(), entity) != Entities.end();
+		return EntityIds.find(entity.GetUUID()) != EntityIds.end();
 	}
 
 	bool ChildRelationship::Empty() const
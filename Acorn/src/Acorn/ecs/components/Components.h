@@ -17,6 +17,7 @@
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <magic_enum.hpp>
+#include <unordered_set>
 #include "ecs/Entity.h"
 
 namespace Acorn
@@ -33,6 +34,8 @@ namespace Acorn
 			ID(const ID&) = default;
 			ID(const Acorn::UUID& uuid)
 				: UUID(uuid) {}
+
+			bool operator==(const ID&) const = default;
 		};
 
 		struct Tag
@@ -43,6 +46,8 @@ namespace Acorn
 			Tag(const Tag&) = default;
 			Tag(const std::string& tag)
 				: TagName(tag) {}
+
+			bool operator==(const Tag&) const = default;
 		};
 
 		struct Transform
@@ -61,6 +66,8 @@ namespace Acorn
 			Transform(glm::vec3 translation, glm::vec3 rotation, glm::vec3 scale)
 				: Translation(translation), Rotation(rotation), Scale(scale) {}
 
+			bool operator==(const Transform&) const = default;
+
 			void SetFromMatrix(const glm::mat4& matrix)
 			{
 				glm::vec3 scale;
@@ -96,6 +103,45 @@ namespace Acorn
 			}
 		};
 
+		/**
+		 * @brief Cached world matrix of an entity, kept up to date by Scene::UpdateWorldTransforms.
+		 *
+		 * Transform is written directly by the editor, scripts and physics, so entt's update signals never see
+		 * those writes. Instead the matrix remembers the local values it was built from and is only rebuilt when
+		 * they differ. A rebuild carries over to the whole subtree right away, so children never look at their parent.
+		 */
+		struct WorldTransform
+		{
+			glm::mat4 Matrix = glm::mat4(1.0f);
+
+			// Local values the matrix was built from
+			glm::vec3 Translation = {0.0f, 0.0f, 0.0f};
+			glm::vec3 Rotation = {0.0f, 0.0f, 0.0f};
+			glm::vec3 Scale = {1.0f, 1.0f, 1.0f};
+
+			// Distance to the root, the pool is sorted by it so parents come before their children
+			uint32_t Depth = 0;
+			// Forces a rebuild, even if the local values match. Set when the entity gets a new parent
+			bool Dirty = true;
+
+			WorldTransform() = default;
+			WorldTransform(const WorldTransform&) = default;
+
+			bool IsStale(const Transform& transform) const
+			{
+				return Dirty || Translation != transform.Translation || Rotation != transform.Rotation || Scale != transform.Scale;
+			}
+
+			void Rebuild(const Transform& transform, const glm::mat4& parentMatrix)
+			{
+				Matrix = parentMatrix * transform.GetTransform();
+				Translation = transform.Translation;
+				Rotation = transform.Rotation;
+				Scale = transform.Scale;
+				Dirty = false;
+			}
+		};
+
 		struct SpriteRenderer
 		{
 			glm::vec4 Color{1.0f};
@@ -106,6 +152,8 @@ namespace Acorn
 			SpriteRenderer(const SpriteRenderer&) = default;
 			SpriteRenderer(glm::vec4 color)
 				: Color(color) {}
+
+			bool operator==(const SpriteRenderer&) const = default;
 		};
 
 		struct CircleRenderer
@@ -119,6 +167,8 @@ namespace Acorn
 			CircleRenderer(const CircleRenderer&) = default;
 			CircleRenderer(glm::vec4 color)
 				: Color(color) {}
+
+			bool operator==(const CircleRenderer&) const = default;
 		};
 
 		struct CameraComponent
@@ -276,14 +326,19 @@ namespace Acorn
 
 			ParentRelationship(Entity parent)
 				: Parent(parent) {}
+
+			bool operator==(const ParentRelationship&) const = default;
 		};
 
 		struct ChildRelationship
 		{
 			std::vector<Entity> Entities;
+			// Mirrors Entities for constant time membership checks
+			std::unordered_set<UUID> EntityIds;
 
 			ChildRelationship() = default;
 			ChildRelationship(const ChildRelationship&) = default;
+			bool operator==(const ChildRelationship&) const = default;
 			void AddEntity(Entity parent, Entity child, Ref<Scene> scene);
 			void RemoveEntity(Entity entity);
 			void Clear();
@@ -10,6 +10,7 @@
 #include "acpch.h"
 
 #include "ecs/components/Components.h"
+#include "physics/PhysicsWorld.h"
 
 #include <box2d/b2_body.h>
 
@@ -26,6 +27,8 @@ namespace Acorn::Components
 		AC_CORE_ASSERT(Type == BodyType::Kinematic || Type == BodyType::Dynamic, "Tried applying a force to a static body!");
 
 		b2Body* body = static_cast<b2Body*>(RuntimeBody);
+		// The world may be in the middle of a step on the physics thread
+		std::lock_guard lock(Physics2D::World::FromBody(body)->GetMutex());
 		body->ApplyForce(b2Vec2(force.x, force.y), body->GetWorldCenter(), true);
 	}
 }
\ No newline at end of file
@@ -154,7 +154,8 @@ struct v8pp::convert<Acorn::KeyCode>
 
 namespace Acorn
 {
-	std::unordered_map<std::string, V8Script*> s_Scripts;
+	// Many entities can run the same file
+	std::unordered_multimap<std::string, V8Script*> s_Scripts;
 
 	class StringVisitor : public boost::static_visitor<std::string>
 	{
@@ -217,6 +218,28 @@ public:
 		CircleCollider2d = 8,
 	};
 
+	// Stores the running index on the array, GetComponent() uses it to find the entity without a call into C++
+	// Scripts disposed during the update leave an undefined hole behind
+	static constexpr const char* UpdateDriverSource = R"(
+(function (instances, timestep, report) {
+	try {
+		for (let i = 0; i < instances.length; i++) {
+			const instance = instances[i];
+			if (instance === undefined)
+				continue;
+			instances.current = i;
+			// A throwing instance must not skip the rest of the file, like it does not in unbatched updates
+			try {
+				instance.onUpdate(timestep);
+			} catch (error) {
+				report(i, error);
+			}
+		}
+	} finally {
+		instances.current = -1;
+	}
+}))";
+
 	//===============================================================================================//
 	//											V8Engine											 //
 	//===============================================================================================//
@@ -231,10 +254,9 @@ public:
 	void V8Engine::Initialize()
 	{
 		AC_PROFILE_FUNCTION();
-		V8Import::Init();
 		// std::string const v8_flags = "--turbo_instruction_scheduling --native-code-counters --expose_gc --print_builtin_code --print_code_verbose --profile_deserialization
 		// --serialization_statistics --random-seed 314159265"; v8::V8::SetFlagsFromString(v8_flags.data(), (int)v8_flags.length());
-		v8::V8::SetFlagsFromString("--stack_trace_on_illegal --abort_on_uncaught_exception");
+		v8::V8::SetFlagsFromString(SCRIPT_RUNTIME_FLAGS);
 
 		ApplicationCommandLineArgs args = Application::Get().GetCommandLineArgs();
 		v8::V8::InitializeICUDefaultLocation(args.Args[0]);
@@ -242,6 +264,15 @@ public:
 		m_Platform = v8::platform::NewDefaultPlatform();
 		v8::V8::InitializePlatform(m_Platform.get());
 		v8::V8::Initialize();
+		// The code cache is tagged with the flags, so it opens after they are set
+		V8Import::Init();
+
+		// The snapshot is normally made by the script-snapshot build target, otherwise once here
+		std::filesystem::path nodeModulesPath = std::filesystem::path(Utils::File::ResolveResPath("res/scripts")) / "node_modules";
+		if (!m_Snapshot.Load(SCRIPT_SNAPSHOT_PATH, nodeModulesPath) && V8Snapshot::Create(SCRIPT_SNAPSHOT_PATH, nodeModulesPath))
+		{
+			m_Snapshot.Load(SCRIPT_SNAPSHOT_PATH, nodeModulesPath);
+		}
 
 		m_Running = true;
 	}
@@ -250,11 +281,20 @@ public:
 	{
 		AC_PROFILE_FUNCTION();
 
-		for (auto* it : m_Scripts)
+		// Dispose() removes the script from the list
+		while (!m_Scripts.empty())
 		{
-			it->Dispose();
+			m_Scripts.back()->Dispose();
 		}
-		m_Scripts.clear();
+
+		// Handles into the isolates have to go before the isolates do
+		m_ComponentViews.clear();
+		m_Modules.clear();
+		if (m_Isolate)
+			m_Isolate->Dispose();
+		delete m_Allocator;
+		m_Isolate	= nullptr;
+		m_Allocator = nullptr;
 
 		v8::V8::Dispose();
 		v8::V8::ShutdownPlatform();
@@ -267,16 +307,6 @@ public:
 	//                                    Static Functions                                           //
 	//===============================================================================================//
 
-	template<class T, void (T::*func)(const v8::FunctionCallbackInfo<v8::Value>&)>
-	static void JsFunctionTemplate(const v8::FunctionCallbackInfo<v8::Value>& args)
-	{
-		T* obj = static_cast<T*>(args.This()->GetAlignedPointerFromInternalField(0));
-		if(obj != nullptr)
-			(obj->*func)(args);
-		else
-			AC_CORE_WARN("JsFunctionTemplate: Object is nullptr");
-	}
-
 	static void Print(const v8::FunctionCallbackInfo<v8::Value>& args)
 	{
 		AC_PROFILE_FUNCTION();
@@ -337,6 +367,275 @@ public:
 	}
 
 
+	//===============================================================================================//
+	//										V8Engine Modules										 //
+	//===============================================================================================//
+
+	v8::Isolate* V8Engine::GetIsolate()
+	{
+		AC_CORE_ASSERT(m_Running, "V8Engine is not initialized!");
+		if (!m_Isolate)
+		{
+			AC_PROFILE_SCOPE("Creating isolate");
+			v8::Isolate::CreateParams createParams;
+			m_Allocator							= v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+			createParams.array_buffer_allocator = m_Allocator;
+			if (m_Snapshot.IsLoaded())
+			{
+				createParams.snapshot_blob		 = m_Snapshot.GetBlob();
+				createParams.external_references = V8Import::ExternalRefs();
+			}
+			m_Isolate							= v8::Isolate::New(createParams);
+		}
+		return m_Isolate;
+	}
+
+	v8::Local<v8::Context> V8Engine::CreateShellContext(V8ScriptModule& module)
+	{
+		AC_PROFILE_FUNCTION();
+		v8::Isolate* isolate = module.Isolate;
+		AC_CORE_ASSERT(isolate, "Invalid Isolate");
+		AC_CORE_ASSERT(!isolate->IsDead(), "Invalid Isolate");
+
+		v8::EscapableHandleScope handleScope(isolate);
+		v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
+		global->Set(v8::String::NewFromUtf8(isolate, "print", v8::NewStringType::kNormal).ToLocalChecked(), v8::FunctionTemplate::New(isolate, Print));
+
+		Acorn::Scripting::V8::GlobalWrapper::Bind(isolate, global);
+		Acorn::Scripting::V8::BindComponentTypes(isolate, global);
+		Acorn::Scripting::V8::TransformWrapper::Bind(isolate, global);
+
+		v8::Local<v8::External> moduleData = v8::External::New(isolate, &module);
+		global->Set(v8pp::to_v8(isolate, "GetComponent"), v8::FunctionTemplate::New(isolate, &V8Script::GetComponentCallback, moduleData));
+		global->Set(v8pp::to_v8(isolate, "GetComponentView"), v8::FunctionTemplate::New(isolate, &V8Script::GetComponentViewCallback, moduleData));
+		global->Set(v8pp::to_v8(isolate, "GetComponentViews"), v8::FunctionTemplate::New(isolate, &V8Script::GetComponentViewsCallback, moduleData));
+
+		v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr, global);
+
+		return handleScope.Escape(context);
+	}
+
+	V8ScriptModule* V8Engine::GetModule(const std::string& jsFilePath)
+	{
+		auto it = m_Modules.find(jsFilePath);
+		if (it != m_Modules.end())
+		{
+			return it->second.get();
+		}
+
+		AC_PROFILE_FUNCTION();
+		AC_CORE_ASSERT(std::filesystem::exists(jsFilePath), "Failed to find compiled script!");
+		std::string sourceCode = Utils::File::ReadFile(jsFilePath);
+
+		Scope<V8ScriptModule> module = CreateScope<V8ScriptModule>();
+		v8::Isolate* isolate		 = GetIsolate();
+		module->Isolate				 = isolate;
+
+		v8::Isolate::Scope isolate_scope(isolate);
+		v8::HandleScope handle_scope(isolate);
+
+		v8::Local<v8::Context> context = CreateShellContext(*module);
+		AC_CORE_ASSERT(!context.IsEmpty(), "Failed to create V8 context!");
+		context->Global()->Set(context, v8pp::to_v8(isolate, "global"), context->Global());
+		module->Context.Reset(isolate, context);
+
+		v8::Context::Scope context_scope(context);
+		v8::TryCatch trycatch(isolate);
+		// Contexts of a snapshot isolate inherit require and the builtin packages from it
+		if (!m_Snapshot.IsLoaded())
+			V8Import::BindCommonJSRequire(context, context->Global());
+		V8Import::BindImport(isolate);
+
+		// Goes through the code cache like the modules it imports
+		v8::Local<v8::Module> script;
+		if (!V8Import::LoadModule(sourceCode, jsFilePath.c_str(), context).ToLocal(&script))
+		{
+			ReportException(isolate, &trycatch);
+			return nullptr;
+		}
+
+		V8Import::AddModulePath(isolate, script->ScriptId(), jsFilePath);
+
+		auto maybeInstantiated = script->InstantiateModule(context, V8Import::CallResolve);
+		if (trycatch.HasCaught())
+		{
+			ReportException(isolate, &trycatch);
+			return nullptr;
+		}
+		AC_CORE_ASSERT(maybeInstantiated.IsJust() && maybeInstantiated.ToChecked(), "Failed to instantiate module!");
+
+		v8::MaybeLocal<v8::Value> v = script->Evaluate(context);
+		if (script->GetStatus() == v8::Module::kErrored)
+		{
+			AC_CORE_ERROR("{0}", *v8::String::Utf8Value(isolate, script->GetException()));
+			AC_ASSERT_NOT_REACHED();
+			return nullptr;
+		}
+		AC_CORE_ASSERT(script->GetStatus() == v8::Module::kEvaluated, "Failed to evaluate module!");
+		auto result = v.ToLocalChecked();
+		AC_CORE_ASSERT(result->IsPromise(), "Module export is not a promise!");
+
+		auto promise = v8::Local<v8::Promise>::Cast(result);
+		AC_CORE_ASSERT(promise->State() == v8::Promise::kFulfilled, "Module export failed, because the promise couldn't be fulfilled!");
+
+		auto ns = script->GetModuleNamespace();
+		AC_CORE_ASSERT(!ns.IsEmpty() && ns->IsObject(), "Module namespace is not an object!");
+		auto nsObject = v8::Local<v8::Object>::Cast(ns);
+
+		auto defaultExport = nsObject->Get(context, v8pp::to_v8(isolate, "default")).ToLocalChecked();
+		AC_CORE_ASSERT(defaultExport->IsFunction(), "Default export is not a function!");
+		v8::Local<v8::Function> classObj = v8::Local<v8::Function>::Cast(defaultExport);
+		AC_CORE_ASSERT(classObj->IsConstructor());
+
+		module->Class.Reset(isolate, classObj);
+		module->Name = v8pp::from_v8<std::string>(isolate, classObj->GetDebugName());
+
+		v8::ScriptCompiler::Source driverSource(v8pp::to_v8(isolate, UpdateDriverSource));
+		v8::Local<v8::Value> driver = v8::ScriptCompiler::Compile(context, &driverSource).ToLocalChecked()->Run(context).ToLocalChecked();
+		AC_CORE_ASSERT(driver->IsFunction(), "Update driver is not a function!");
+		module->UpdateDriver.Reset(isolate, driver.As<v8::Function>());
+		v8::Local<v8::Function> reportError = v8::Function::New(context, &V8Script::ReportUpdateErrorCallback, v8::External::New(isolate, module.get())).ToLocalChecked();
+		module->ReportUpdateError.Reset(isolate, reportError);
+		AC_CORE_TRACE("Compiled {} ({}) once for all of its entities", jsFilePath, module->Name);
+
+		return m_Modules.emplace(jsFilePath, std::move(module)).first->second.get();
+	}
+
+	void V8Engine::UpdateScripts(Timestep ts, bool batched)
+	{
+		AC_PROFILE_FUNCTION();
+		for (auto& [path, module] : m_Modules)
+		{
+			Timer timer;
+			module->Dispatching = true;
+			if (batched && !module->Scripts.empty())
+			{
+				DispatchUpdate(*module, ts);
+			}
+			else
+			{
+				for (size_t i = 0; i < module->Scripts.size(); i++)
+				{
+					if (module->Scripts[i])
+						module->Scripts[i]->OnUpdate(ts);
+				}
+			}
+			module->Dispatching = false;
+
+			// Drop the scripts that were disposed by the update, the instance array is rebuilt on the next dispatch
+			auto& scripts = module->Scripts;
+			scripts.erase(std::remove(scripts.begin(), scripts.end(), nullptr), scripts.end());
+			module->LastUpdateTime = timer.ElapsedMillis();
+		}
+	}
+
+	void V8Engine::DispatchUpdate(V8ScriptModule& module, Timestep ts)
+	{
+		AC_PROFILE_FUNCTION();
+		v8::Isolate* isolate = module.Isolate;
+		v8::Isolate::Scope isolate_scope(isolate);
+		v8::HandleScope handle_scope(isolate);
+
+		v8::Local<v8::Context> context = module.Context.Get(isolate);
+		v8::Context::Scope context_scope(context);
+
+		if (module.InstancesChanged)
+		{
+			v8::Local<v8::Array> instances = v8::Array::New(isolate, (int)module.Scripts.size());
+			for (uint32_t i = 0; i < module.Scripts.size(); i++)
+			{
+				instances->Set(context, i, module.Scripts[i]->m_Instance.Get(isolate)).Check();
+			}
+			module.Instances.Reset(isolate, instances);
+			module.InstancesChanged = false;
+		}
+
+		v8::Local<v8::Value> args[] = {module.Instances.Get(isolate), v8::Number::New(isolate, ts.GetSeconds()), module.ReportUpdateError.Get(isolate)};
+		v8::TryCatch tryCatch(isolate);
+		if (module.UpdateDriver.Get(isolate)->Call(context, v8::Undefined(isolate), 3, args).IsEmpty())
+		{
+			ReportException(isolate, &tryCatch);
+		}
+	}
+
+	std::vector<V8ScriptTiming> V8Engine::GetUpdateTimings() const
+	{
+		std::vector<V8ScriptTiming> timings;
+		for (const auto& [path, module] : m_Modules)
+		{
+			if (!module->Scripts.empty())
+				timings.push_back({module->Name, (uint32_t)module->Scripts.size(), module->LastUpdateTime});
+		}
+		return timings;
+	}
+
+	size_t V8Engine::MeasureHeap()
+	{
+		// Garbage of compiling and evaluating the modules would otherwise count as used
+		v8::Isolate* isolate = GetIsolate();
+		isolate->LowMemoryNotification();
+
+		v8::HeapStatistics heap;
+		isolate->GetHeapStatistics(&heap);
+		return heap.used_heap_size();
+	}
+
+	void V8Engine::BeginHeapMeasurement()
+	{
+		AC_PROFILE_FUNCTION();
+		m_HeapBeforeLoad	= MeasureHeap();
+		m_ScriptsBeforeLoad = m_Scripts.size();
+	}
+
+	void V8Engine::ReportHeapUsage()
+	{
+		AC_PROFILE_FUNCTION();
+		size_t used		   = MeasureHeap();
+		size_t scriptCount = m_Scripts.size() - std::min(m_Scripts.size(), m_ScriptsBeforeLoad);
+		size_t grownKiB	   = (used - std::min(used, m_HeapBeforeLoad)) / 1024;
+
+		// Every script used to have an isolate of its own, so the baseline is what each of them paid on top
+		AC_CORE_INFO("[V8]: Loading {} scripts in {} modules grew the heap from {} KiB to {} KiB, {} KiB per script", scriptCount, m_Modules.size(),
+			m_HeapBeforeLoad / 1024, used / 1024, scriptCount > 0 ? grownKiB / scriptCount : 0);
+	}
+
+	const V8CodeCacheStats& V8Engine::GetCodeCacheStats() const
+	{
+		return V8Import::s_Data.CodeCache.GetStats();
+	}
+
+	void V8Engine::TrackComponentView(v8::Isolate* isolate, v8::Local<v8::Float32Array> view)
+	{
+		ComponentView& tracked = m_ComponentViews.emplace_back();
+		tracked.Isolate		   = isolate;
+		tracked.Buffer.Reset(isolate, view->Buffer());
+	}
+
+	void V8Engine::InvalidateComponentViews()
+	{
+		if (m_ComponentViews.empty())
+		{
+			return;
+		}
+
+		AC_PROFILE_FUNCTION();
+		for (ComponentView& view : m_ComponentViews)
+		{
+			v8::Isolate::Scope isolate_scope(view.Isolate);
+			v8::HandleScope handle_scope(view.Isolate);
+			v8::Local<v8::ArrayBuffer> buffer = view.Buffer.Get(view.Isolate);
+			if (buffer->IsDetachable())
+				buffer->Detach();
+		}
+		m_ComponentViews.clear();
+
+		for (V8Script* script : m_Scripts)
+		{
+			script->m_TransformView.Reset();
+			script->m_TransformViews.Reset();
+		}
+	}
+
 	//===============================================================================================//
 	//											V8Script											 //
 	//===============================================================================================//
@@ -350,7 +649,7 @@ public:
 		// V8Script(std::string("res/scripts/test.ts"));
 	}
 
-	V8Script::V8Script(Entity entity, const std::string& filePath) : m_Isolate(NULL), m_Entity(entity)
+	V8Script::V8Script(Entity entity, const std::string& filePath) : m_Entity(entity)
 	{
 		AC_CORE_ASSERT(filePath.ends_with(".ts"), "Script must be a typescript file!");
 		m_TSFilePath = filePath;
@@ -363,11 +662,12 @@ public:
 
 	V8Script::~V8Script()
 	{
-		m_Isolate->Dispose();
-		m_Isolate = nullptr;
-		V8Engine::instance().RemoveScript(this);
+		Dispose();
 
-		s_Scripts.erase(s_Scripts.find(m_TSFilePath));
+		auto [begin, end] = s_Scripts.equal_range(m_TSFilePath);
+		auto it			  = std::find_if(begin, end, [this](const auto& entry) { return entry.second == this; });
+		if (it != end)
+			s_Scripts.erase(it);
 	}
 
 	void V8Script::GetComponent(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -399,199 +699,165 @@ public:
 		}
 	}
 
-	// TODO ts->js filename interop
-	void V8Script::Load(Entity entity)
+	// Views skip the wrapper objects, the Float32Array is the component memory itself
+	static bool IsViewable(v8::Isolate* isolate, const v8::FunctionCallbackInfo<v8::Value>& args)
 	{
-		if (m_Isolate)
+		if (args.Length() != 1 || !args[0]->IsInt32() || v8pp::from_v8<Acorn::Scripting::V8::ComponentTypes>(isolate, args[0]) != Acorn::Scripting::V8::ComponentTypes::Transform)
 		{
-			return;
+			isolate->ThrowException(v8::Exception::TypeError(v8pp::to_v8(isolate, "Only ComponentTypes.Transform has views")));
+			return false;
 		}
+		return true;
+	}
 
+	void V8Script::GetComponentView(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
 		AC_PROFILE_FUNCTION();
-		V8Engine::instance().AddScript(this);
-
-		v8::Isolate::CreateParams create_params;
-		create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-
-		m_Isolate = v8::Isolate::New(create_params);
-
-		std::string sourceCode = Utils::File::ReadFile(m_JSFilePath);
-
-		std::string md5Hash = Utils::File::MD5HashString(sourceCode);
-
-		AC_CORE_TRACE("TSCompilation succeeded");
-
-		AC_CORE_ASSERT(std::filesystem::exists(m_JSFilePath), "Failed to find compiled script!");
+		v8::Isolate* isolate = args.GetIsolate();
+		if (!IsViewable(isolate, args))
+			return;
 
-		v8::Isolate::Scope isolate_scope(m_Isolate);
-		// Block for destroying handle scope before creating startup blob
+		if (m_TransformView.IsEmpty())
 		{
-			// Create a stack-allocated handle scope.
-			v8::HandleScope handle_scope(m_Isolate);
-
-			v8::Local<v8::Context> context = CreateShellContext();
-
-			context->Global()->Set(context, v8pp::to_v8(m_Isolate, "global"), context->Global());
+			v8::Local<v8::Float32Array> view = TransformWrapper::View(isolate, &m_Entity.GetComponent<Transform>());
+			V8Engine::instance().TrackComponentView(isolate, view);
+			m_TransformView.Reset(isolate, view);
+		}
+		args.GetReturnValue().Set(m_TransformView.Get(isolate));
+	}
 
-			AC_CORE_TRACE("Serialized Context!");
+	void V8Script::GetComponentViews(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
+		AC_PROFILE_FUNCTION();
+		v8::Isolate* isolate = args.GetIsolate();
+		if (!IsViewable(isolate, args))
+			return;
 
-			m_Context = v8::Persistent<v8::Context, v8::CopyablePersistentTraits<v8::Context>>(m_Isolate, context);
+		if (m_TransformViews.IsEmpty())
+		{
+			std::vector<std::span<Components::Transform>> runs;
+			m_Entity.GetScene()->GetTransformRuns(runs);
 
-			AC_CORE_ASSERT(!context.IsEmpty(), "Failed to create V8 context!");
-			// Enter the context for compiling and running the hello world script.
-			v8::Context::Scope context_scope(context);
+			V8Engine& engine			   = V8Engine::instance();
+			v8::Local<v8::Context> context = isolate->GetCurrentContext();
+			v8::Local<v8::Array> views	   = v8::Array::New(isolate, (int)runs.size());
+			for (uint32_t i = 0; i < runs.size(); i++)
 			{
+				v8::Local<v8::Float32Array> view = TransformWrapper::View(isolate, runs[i].data(), runs[i].size());
+				engine.TrackComponentView(isolate, view);
+				views->Set(context, i, view).Check();
+			}
+			m_TransformViews.Reset(isolate, views);
+		}
+		args.GetReturnValue().Set(m_TransformViews.Get(isolate));
+	}
 
-				v8::TryCatch trycatch(m_Isolate);
-				V8Import::BindCommonJSRequire(context, context->Global());
-				V8Import::BindImport(m_Isolate);
-				// Create a string containing the JavaScript source code.
-				v8::Local<v8::String> source = v8::String::NewFromUtf8(m_Isolate, sourceCode.c_str(), v8::NewStringType::kNormal).ToLocalChecked();
-				v8::Local<v8::String> resource = v8pp::to_v8(m_Isolate, m_JSFilePath);
-
-				v8::ScriptOrigin origin(resource, 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
-
-				// Compile the source code.
-				v8::ScriptCompiler::Source scriptSource(source, origin);
-				v8::Local<v8::Module> script = v8::ScriptCompiler::CompileModule(m_Isolate, &scriptSource).ToLocalChecked();
-
-				if(script->GetStatus() == v8::Module::kErrored)
-				{
-					auto exception = script->GetException();
-					AC_CORE_ERROR("{0}", *v8::String::Utf8Value(m_Isolate, exception));
-					ReportException(m_Isolate, &trycatch);
-					return;
-				}
-
-				V8Import::AddModulePath(script->ScriptId(), m_JSFilePath);
-
-				auto maybeInstantiated = script->InstantiateModule(context, V8Import::CallResolve);
-				AC_CORE_ASSERT(maybeInstantiated.IsJust() && maybeInstantiated.ToChecked(), "Failed to instantiate module!");
-
-				if(trycatch.HasCaught())
-				{
-					ReportException(m_Isolate, &trycatch);
-					return;
-				}
-
-				v8::MaybeLocal<v8::Value> v = script->Evaluate(context);
-				if(script->GetStatus() == v8::Module::kErrored)
-				{
-					auto exception = script->GetException();
-					AC_CORE_ERROR("{0}", *v8::String::Utf8Value(m_Isolate, exception));
-					AC_ASSERT_NOT_REACHED();
-					return;
-				}
-				AC_CORE_ASSERT(script->GetStatus() == v8::Module::kEvaluated, "Failed to evaluate module!");
-				auto module = v.ToLocalChecked();
-				AC_CORE_ASSERT(module->IsPromise(), "Module export is not a promise!");
-
-				auto promise = v8::Local<v8::Promise>::Cast(module);
-				AC_CORE_ASSERT(promise->State() == v8::Promise::kFulfilled, "Module export failed, because the promise couldn't be fulfilled!");
-				auto maybe = promise->Result();
-				if(trycatch.HasCaught())
-				{
-					ReportException(m_Isolate, &trycatch);
-					return;
-				}
-				AC_CORE_ASSERT(!maybe.IsEmpty(), "Failed to get module export!");
-
-				auto ns = script->GetModuleNamespace();
-				AC_CORE_ASSERT(!ns.IsEmpty(), "Failed to get module namespace!");
-				AC_CORE_ASSERT(ns->IsObject(), "Module namespace is not an object!");
-
-				auto nsObject = v8::Local<v8::Object>::Cast(ns);
-
-				auto defaultExport = nsObject->Get(context, v8pp::to_v8(m_Isolate, "default")).ToLocalChecked();
-				AC_CORE_ASSERT(defaultExport->IsFunction(), "Default export is not a function!");
-				v8::Local<v8::Function> classObj = v8::Local<v8::Function>::Cast(defaultExport);
-
-				AC_CORE_ASSERT(classObj->IsConstructor());
-
-				AC_CORE_TRACE("Class Object Name: {}", *v8::String::Utf8Value(m_Isolate, classObj->GetName()));
-
-				m_Name = v8pp::from_v8<std::string>(m_Isolate, classObj->GetDebugName());
-
-				auto obj = classObj->NewInstanceWithSideEffectType(context, 0, nullptr, v8::SideEffectType::kHasSideEffectToReceiver).ToLocalChecked().As<v8::Object>();
-				v8::Local<v8::Object> instance = obj.As<v8::Object>();
-				AC_CORE_ASSERT(instance->IsObject(), "Failed to create instance!");
-				auto protoStr = instance->ObjectProtoToString(context).ToLocalChecked();
-				AC_CORE_TRACE("Class Object Prototype: {}", *v8::String::Utf8Value(m_Isolate, protoStr));
+	// TODO ts->js filename interop
+	void V8Script::Load(Entity entity)
+	{
+		if (m_Module)
+		{
+			return;
+		}
 
-				{
-//					Acorn::Scripting::V8::ScriptSuperClass* superClass = v8pp::class_<Acorn::Scripting::V8::ScriptSuperClass>::unwrap_object(m_Isolate, instance);
-//					AC_CORE_ASSERT(!!superClass, "Every script must inherit from ScriptSuperClass!");
-//					superClass->SetEntity(entity);
+		AC_PROFILE_FUNCTION();
+		V8Engine& engine = V8Engine::instance();
+		engine.AddScript(this);
 
-					// Acorn::Scripting::V8::ScriptSuperClass& superClass = ScriptSuperClassWrapper::Unwrap(m_Isolate, instance);
-					// superClass.SetEntity(entity);
-				}
+		V8ScriptModule* module = engine.GetModule(m_JSFilePath);
+		if (!module)
+		{
+			return;
+		}
+		m_Module = module;
+		m_Name	 = module->Name;
 
-				m_Class.Reset(m_Isolate, classObj);
+		v8::Isolate* isolate = module->Isolate;
+		v8::Isolate::Scope isolate_scope(isolate);
+		v8::HandleScope handle_scope(isolate);
 
-				v8::Local<v8::Object> prototype = instance->GetPrototype().As<v8::Object>();
-				AC_CORE_ASSERT(prototype->IsObject(), "Prototype is not an object!");
+		v8::Local<v8::Context> context = module->Context.Get(isolate);
+		v8::Context::Scope context_scope(context);
 
-				auto keys = prototype->GetPropertyNames(context).ToLocalChecked();
-				AC_CORE_TRACE("Prototype: ");
-				for(uint32_t i = 0; i < keys->Length(); i++)
-				{
-					auto key = keys->Get(context, i).ToLocalChecked();
-					auto name = v8pp::from_v8<std::string>(m_Isolate, key);
-					AC_CORE_TRACE("\t{0}", name);
-				}
+		v8::TryCatch trycatch(isolate);
 
-				auto instanceKeys = instance->GetPropertyNames(context).ToLocalChecked();
-				AC_CORE_TRACE("Instance: ");
-				for(uint32_t i = 0; i < instanceKeys->Length(); i++)
-				{
-					auto key = instanceKeys->Get(context, i).ToLocalChecked();
-					auto name = v8pp::from_v8<std::string>(m_Isolate, key);
-					AC_CORE_TRACE("\t{0}", name);
-				}
+		// The constructor may already ask for components
+		module->Current = this;
 
-				auto keys2 = instance->GetOwnPropertyNames(context).ToLocalChecked();
-				AC_CORE_TRACE("Instance: ");
-				for(uint32_t i = 0; i < keys2->Length(); i++)
-				{
-					auto key = keys2->Get(context, i).ToLocalChecked();
-					auto name = v8pp::from_v8<std::string>(m_Isolate, key);
-					AC_CORE_TRACE("\t{0}", name);
-				}
+		v8::Local<v8::Function> classObj = module->Class.Get(isolate);
+		v8::Local<v8::Object> instance;
+		if (!classObj->NewInstanceWithSideEffectType(context, 0, nullptr, v8::SideEffectType::kHasSideEffectToReceiver).ToLocal(&instance))
+		{
+			module->Current = nullptr;
+			ReportException(isolate, &trycatch);
+			return;
+		}
 
-				// TODO make optional
-				v8::Local<v8::Function> onUpdateFunc = instance->Get(context, v8pp::to_v8(m_Isolate, "onUpdate")).ToLocalChecked().As<v8::Function>();
-				AC_CORE_ASSERT(onUpdateFunc->IsFunction());
-				AC_CORE_TRACE("OnUpdate: {}", v8pp::from_v8<std::string>(m_Isolate, onUpdateFunc->TypeOf(m_Isolate)));
-				m_OnUpdate.Reset(m_Isolate, onUpdateFunc);
+		v8::Local<v8::Object> prototype = instance->GetPrototype().As<v8::Object>();
+		AC_CORE_ASSERT(prototype->IsObject(), "Prototype is not an object!");
 
-				v8::Local<v8::Function> onCreateFunc = prototype->Get(context, v8pp::to_v8(m_Isolate, "onCreate")).ToLocalChecked().As<v8::Function>();
-				AC_CORE_ASSERT(onCreateFunc->IsFunction(), "Script must implement OnCreate!");
-				AC_CORE_TRACE("OnCreate: {}", v8pp::from_v8<std::string>(m_Isolate, onCreateFunc->TypeOf(m_Isolate)));
-				auto ret = onCreateFunc->Call(context, instance, 0, nullptr);
+		// TODO make optional
+		v8::Local<v8::Function> onUpdateFunc = instance->Get(context, v8pp::to_v8(isolate, "onUpdate")).ToLocalChecked().As<v8::Function>();
+		AC_CORE_ASSERT(onUpdateFunc->IsFunction());
+		m_OnUpdate.Reset(isolate, onUpdateFunc);
+		m_Instance.Reset(isolate, instance);
 
-				if (ret.IsEmpty() && trycatch.HasCaught())
-				{
-					ReportException(m_Isolate, &trycatch);
-				}
-				else if (ret.IsEmpty())
-				{
-					AC_CORE_ERROR("[V8]: Failed to call OnCreate!");
-					AC_CORE_BREAK();
-				}
+		v8::Local<v8::Function> onCreateFunc = prototype->Get(context, v8pp::to_v8(isolate, "onCreate")).ToLocalChecked().As<v8::Function>();
+		AC_CORE_ASSERT(onCreateFunc->IsFunction(), "Script must implement OnCreate!");
+		auto ret = onCreateFunc->Call(context, instance, 0, nullptr);
+		module->Current = nullptr;
 
-			}
+		if (ret.IsEmpty() && trycatch.HasCaught())
+		{
+			ReportException(isolate, &trycatch);
 		}
+		else if (ret.IsEmpty())
+		{
+			AC_CORE_ERROR("[V8]: Failed to call OnCreate!");
+			AC_CORE_BREAK();
+		}
+
+		module->Scripts.push_back(this);
+		module->InstancesChanged = true;
 	}
 
 	void V8Script::Dispose()
 	{
 		AC_PROFILE_FUNCTION();
-		AC_CORE_INFO("V8 Isolate {} != {}", (void*) m_Isolate, (void*) NULL);
-		// FIXME we can do better
-		//  Keep the isolate alive until the end of the program
-		m_Isolate->Dispose();
-		m_Isolate = nullptr;
+		// The module and its isolate stay with the engine, the next load of the same file reuses them
+		if (m_Module)
+		{
+			auto& scripts = m_Module->Scripts;
+			if (m_Module->Dispatching)
+			{
+				// The update driver is still walking the instance array, shifting the scripts would hand GetComponent() the wrong entity
+				auto it = std::find(scripts.begin(), scripts.end(), this);
+				if (it != scripts.end())
+				{
+					*it = nullptr;
+					if (!m_Module->Instances.IsEmpty())
+					{
+						v8::Isolate* isolate = m_Module->Isolate;
+						v8::HandleScope handle_scope(isolate);
+						v8::Local<v8::Array> instances = m_Module->Instances.Get(isolate);
+						uint32_t index				   = (uint32_t)(it - scripts.begin());
+						// Scripts loaded during the update are not part of the array yet
+						if (index < instances->Length())
+							instances->Set(m_Module->Context.Get(isolate), index, v8::Undefined(isolate)).Check();
+					}
+				}
+			}
+			else
+			{
+				scripts.erase(std::remove(scripts.begin(), scripts.end(), this), scripts.end());
+			}
+			m_Module->InstancesChanged = true;
+		}
+		m_OnUpdate.Reset();
+		m_Instance.Reset();
+		m_TransformView.Reset();
+		m_TransformViews.Reset();
+		m_Module = nullptr;
 		V8Engine::instance().RemoveScript(this);
 	}
 
@@ -613,7 +879,7 @@ public:
 		// 		if (changeType == filewatch::Event::modified)
 		// 		{
 		// 			AC_CORE_INFO("File {} changed!", path);
-		// 			V8Script* script = s_Scripts[path];
+		// 			V8Script* script = s_Scripts.find(path)->second;
 		// 			if (script)
 		// 			{
 		// 				script->Compile();
@@ -630,70 +896,110 @@ public:
 	void V8Script::OnUpdate(Timestep ts, Camera* camera)
 	{
 		AC_PROFILE_FUNCTION();
-		Timer timer;
-		AC_CORE_ASSERT(m_Isolate != nullptr, "V8 Isolate is null!");
+		if (!m_Module)
+		{
+			return;
+		}
 
-		v8::Isolate::Scope isolate_scope(m_Isolate);
+		v8::Isolate* isolate = m_Module->Isolate;
+		v8::Isolate::Scope isolate_scope(isolate);
 		{
-			v8::HandleScope handle_scope(m_Isolate);
+			v8::HandleScope handle_scope(isolate);
 
-			v8::Local<v8::Context> context = v8::Local<v8::Context>::New(m_Isolate, m_Context);
+			v8::Local<v8::Context> context = m_Module->Context.Get(isolate);
 
 			v8::Context::Scope context_scope(context);
 			{
 				AC_CORE_ASSERT(!m_OnUpdate.IsEmpty(), "V8 OnUpdate is null!");
-				AC_CORE_ASSERT(!m_Class.IsEmpty(), "V8 Script Instance is null!");
-				AC_CORE_ASSERT(!context.IsEmpty(), "V8 Context is null!");
+				AC_CORE_ASSERT(!m_Instance.IsEmpty(), "V8 Script Instance is null!");
 
-				v8::Local<v8::Value> time = v8::Number::New(m_Isolate, ts.GetSeconds());
+				v8::Local<v8::Value> time = v8::Number::New(isolate, ts.GetSeconds());
 
 				v8::Local<v8::Value> args[1]	 = { time };
-				v8::Local<v8::Function> onUpdate = v8::Local<v8::Function>::New(m_Isolate, m_OnUpdate);
-				v8::Local<v8::Object> instance	 = v8::Local<v8::Object>::New(m_Isolate, m_Class);
-				v8::TryCatch tryCatch(m_Isolate);
+				v8::Local<v8::Function> onUpdate = m_OnUpdate.Get(isolate);
+				v8::Local<v8::Object> instance	 = m_Instance.Get(isolate);
+				v8::TryCatch tryCatch(isolate);
+				m_Module->Current			  = this;
 				v8::MaybeLocal<v8::Value> res = onUpdate->Call(context, instance, 1, args);
+				m_Module->Current			  = nullptr;
 
 				if (tryCatch.HasCaught())
 				{
-//					if (!tryCatch.Message().IsEmpty())
-//						AC_CORE_ERROR("[V8]: Error on Update: {}", v8pp::from_v8<std::string>(m_Isolate, tryCatch.Message()->Get()));
-//					else
-//						AC_CORE_ERROR("[V8]: Unknown Error on Update");
-					ReportException(m_Isolate, &tryCatch);
+					ReportException(isolate, &tryCatch);
 				}
 
 				AC_CORE_ASSERT(!res.IsEmpty(), "V8 OnUpdate failed!");
 				AC_CORE_ASSERT(res.ToLocalChecked()->IsUndefined(), "V8 OnUpdate returned a value!");
-
-				m_LastExecutionTime = timer.ElapsedMillis();
 			}
 		}
 	}
 
-	v8::Local<v8::Context> V8Script::CreateShellContext()
+	V8Script* V8Script::GetCallingScript(const v8::FunctionCallbackInfo<v8::Value>& args)
 	{
-		AC_PROFILE_FUNCTION();
-		AC_CORE_ASSERT(m_Isolate, "Invalid Isolate");
-		AC_CORE_ASSERT(!m_Isolate->IsDead(), "Invalid Isolate");
-
-		v8::EscapableHandleScope handleScope(m_Isolate);
-		v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(m_Isolate);
-		global->Set(v8::String::NewFromUtf8(m_Isolate, "print", v8::NewStringType::kNormal).ToLocalChecked(), v8::FunctionTemplate::New(m_Isolate, Print));
+		// Every entity running the file shares the context, the module knows which one is calling
+		V8ScriptModule* module = static_cast<V8ScriptModule*>(args.Data().As<v8::External>()->Value());
+		V8Script* script		= module->Current;
+		if (script == nullptr && !module->Instances.IsEmpty())
+		{
+			// Batched updates only mark the index of the running instance
+			v8::Isolate* isolate		   = args.GetIsolate();
+			v8::Local<v8::Context> context = isolate->GetCurrentContext();
+			v8::Local<v8::Value> current;
+			if (module->Instances.Get(isolate)->Get(context, v8pp::to_v8(isolate, "current")).ToLocal(&current) && current->IsInt32())
+			{
+				int32_t index = current.As<v8::Int32>()->Value();
+				if (index >= 0 && index < (int32_t)module->Scripts.size())
+					script = module->Scripts[index];
+			}
+		}
 
-		Acorn::Scripting::V8::GlobalWrapper::Bind(m_Isolate, global);
-		Acorn::Scripting::V8::BindComponentTypes(m_Isolate, global);
-		Acorn::Scripting::V8::TransformWrapper::Bind(m_Isolate, global);
+		return script;
+	}
 
-		auto createFuncTemplate = v8::FunctionTemplate::New(m_Isolate, &JsFunctionTemplate<V8Script, &V8Script::GetComponent>);
-		global->Set(v8pp::to_v8(m_Isolate, "GetComponent"), createFuncTemplate);
+	void V8Script::ReportUpdateErrorCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
+		V8ScriptModule* module		   = static_cast<V8ScriptModule*>(args.Data().As<v8::External>()->Value());
+		v8::Isolate* isolate		   = args.GetIsolate();
+		v8::Local<v8::Context> context = isolate->GetCurrentContext();
+		v8::HandleScope handle_scope(isolate);
 
-		global->SetInternalFieldCount(1);
+		int32_t index	 = args[0]->Int32Value(context).FromMaybe(-1);
+		V8Script* script = index >= 0 && index < (int32_t)module->Scripts.size() ? module->Scripts[index] : nullptr;
+		if (script)
+			AC_CORE_ERROR("[V8]: {}.onUpdate threw for entity {} ({})", module->Name, script->m_Entity.GetName(), (std::string)script->m_Entity.GetUUID());
+		else
+			AC_CORE_ERROR("[V8]: {}.onUpdate threw", module->Name);
+
+		// The stack of an Error already starts with its message and has the location of the throw
+		v8::Local<v8::Value> error = args[1];
+		v8::Local<v8::Value> stack;
+		if (error->IsObject() && error.As<v8::Object>()->Get(context, v8pp::to_v8(isolate, "stack")).ToLocal(&stack) && stack->IsString())
+			error = stack;
+		AC_CORE_ERROR("{0}", *v8::String::Utf8Value(isolate, error));
+	}
 
-		v8::Local<v8::Context> context = v8::Context::New(m_Isolate, nullptr, global);
+	void V8Script::GetComponentCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
+		if (V8Script* script = GetCallingScript(args))
+			script->GetComponent(args);
+		else
+			AC_CORE_WARN("GetComponent called outside of a script callback");
+	}
 
-		context->Global()->SetAlignedPointerInInternalField(0, (void*)this);
+	void V8Script::GetComponentViewCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
+		if (V8Script* script = GetCallingScript(args))
+			script->GetComponentView(args);
+		else
+			AC_CORE_WARN("GetComponentView called outside of a script callback");
+	}
 
-		return handleScope.Escape(context);
+	void V8Script::GetComponentViewsCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
+	{
+		if (V8Script* script = GetCallingScript(args))
+			script->GetComponentViews(args);
+		else
+			AC_CORE_WARN("GetComponentViews called outside of a script callback");
 	}
 
 	template <typename T>
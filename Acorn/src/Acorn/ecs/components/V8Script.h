@@ -5,6 +5,8 @@
 #include "core/Timestep.h"
 #include "ecs/Scene.h"
 #include "ecs/Entity.h"
+#include "utils/v8/V8CodeCache.h"
+#include "utils/v8/V8Snapshot.h"
 
 #include <boost/variant.hpp>
 
@@ -45,6 +47,44 @@ namespace Acorn
 		glm::mat4 PrimaryCameraViewProjectionMatrix;
 	};
 
+	class V8Script;
+
+	/**
+	 * @brief A compiled script file, shared by every entity that runs it.
+	 *
+	 * The module is compiled and evaluated once in a context of the shared isolate, entities only create an
+	 * instance of its default export.
+	 */
+	struct V8ScriptModule
+	{
+		v8::Isolate* Isolate = nullptr;
+		v8::Global<v8::Context> Context;
+		v8::Global<v8::Function> Class;
+		std::string Name;
+
+		// Loaded scripts of the file, in the order of the instance array handed to the update driver
+		std::vector<V8Script*> Scripts;
+		v8::Global<v8::Array> Instances;
+		bool InstancesChanged = false;
+		// Set while the scripts update, disposed scripts are only nulled out so the indices stay valid
+		bool Dispatching = false;
+		// Calls onUpdate of every instance, so a batched update enters V8 once per file
+		v8::Global<v8::Function> UpdateDriver;
+		// Handed to the driver, logs an instance whose onUpdate threw along with its entity
+		v8::Global<v8::Function> ReportUpdateError;
+		float LastUpdateTime = 0.0f;
+
+		// Script whose callback is running, GetComponent() resolves to its entity
+		V8Script* Current = nullptr;
+	};
+
+	struct V8ScriptTiming
+	{
+		std::string Name;
+		uint32_t ScriptCount;
+		float Milliseconds;
+	};
+
 	// TODO rename to TSScript
 	class V8Script
 	{
@@ -74,18 +114,28 @@ namespace Acorn
 
 		inline std::string GetFilePath() const { return m_TSFilePath; }
 
-		inline float GetLastElapsedTime() const { return m_LastExecutionTime; }
-
 		inline const TSScriptData& GetScriptData() const { return m_Data; }
 
 	private:
-		// v8::Local<v8::Context> CreateShellContext();
-		v8::Local<v8::Context> CreateShellContext();
-
 		void GetComponent(const v8::FunctionCallbackInfo<v8::Value>& args);
+		void GetComponentView(const v8::FunctionCallbackInfo<v8::Value>& args);
+		void GetComponentViews(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+		/**
+		 * @brief The script whose callback is running in the context of a module.
+		 *
+		 * @return
+		 *  Null if the call did not come from onCreate or onUpdate.
+		 */
+		static V8Script* GetCallingScript(const v8::FunctionCallbackInfo<v8::Value>& args);
+		static void GetComponentCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
+		static void GetComponentViewCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
+		static void GetComponentViewsCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
+		static void ReportUpdateErrorCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 	private:
-		v8::Isolate* m_Isolate;
+		// Owned by the V8Engine, null until loaded
+		V8ScriptModule* m_Module = nullptr;
 
 		std::string m_TSFilePath = "";
 		std::string m_JSFilePath = "";
@@ -94,16 +144,14 @@ namespace Acorn
 		TSScriptData m_Data;
 		std::unordered_map<std::string, boost::variant<bool, float, std::string>> m_Parameters;
 
-		v8::Persistent<v8::Context, v8::CopyablePersistentTraits<v8::Context>> m_Context;
-
-		v8::Persistent<v8::Object> m_Class;
-		v8::Persistent<v8::Function> m_OnUpdate;
+		v8::Global<v8::Object> m_Instance;
+		v8::Global<v8::Function> m_OnUpdate;
 
-		// Scope<v8::SnapshotCreator> m_SnapshotCreator;
+		// Handed out by GetComponentView(s), dropped by V8Engine::InvalidateComponentViews
+		v8::Global<v8::Float32Array> m_TransformView;
+		v8::Global<v8::Array> m_TransformViews;
 
 		Entity m_Entity;
-
-		float m_LastExecutionTime = 0.0f;
 	};
 
 	class V8Engine
@@ -148,6 +196,41 @@ namespace Acorn
 
 		inline bool isRunning() const { return m_Running; }
 
+		/**
+		 * @brief Runs onUpdate of every loaded script.
+		 *
+		 * @param batched
+		 *  Enter V8 once per script file and let a driver loop over its instances, instead of once per script.
+		 */
+		void UpdateScripts(Timestep ts, bool batched = true);
+
+		/**
+		 * @brief Time the last UpdateScripts() spent in each script file that has loaded scripts.
+		 */
+		std::vector<V8ScriptTiming> GetUpdateTimings() const;
+
+		/**
+		 * @brief Remembers the used heap and script count, call before the scripts of a scene are loaded.
+		 */
+		void BeginHeapMeasurement();
+
+		/**
+		 * @brief Logs how much the heap grew since BeginHeapMeasurement() and what it comes to per loaded script.
+		 */
+		void ReportHeapUsage();
+
+		/**
+		 * @brief Lookups of compiled modules in the on-disk code cache since the engine started.
+		 */
+		const V8CodeCacheStats& GetCodeCacheStats() const;
+
+		/**
+		 * @brief Detaches every component view handed to scripts, e.g. because the components are about to move.
+		 *
+		 * A detached view has a length of 0, scripts ask for a new one when they see that.
+		 */
+		void InvalidateComponentViews();
+
 		~V8Engine();
 
 	private:
@@ -156,12 +239,56 @@ namespace Acorn
 		void Initialize();
 		void Shutdown();
 
+		/**
+		 * @brief The module of a script file, compiled on first use.
+		 *
+		 * @return
+		 *  Null if the file failed to compile or evaluate.
+		 */
+		V8ScriptModule* GetModule(const std::string& jsFilePath);
+
+		/**
+		 * @brief The isolate every module runs in, created on first use.
+		 */
+		v8::Isolate* GetIsolate();
+
+		/**
+		 * @brief Used heap of the isolate after a full garbage collection.
+		 */
+		size_t MeasureHeap();
+
+		v8::Local<v8::Context> CreateShellContext(V8ScriptModule& module);
+		void DispatchUpdate(V8ScriptModule& module, Timestep ts);
+
+		/**
+		 * @brief Remembers the buffer of a view, so InvalidateComponentViews() can detach it.
+		 */
+		void TrackComponentView(v8::Isolate* isolate, v8::Local<v8::Float32Array> view);
+
 	private:
+		struct ComponentView
+		{
+			v8::Isolate* Isolate = nullptr;
+			v8::Global<v8::ArrayBuffer> Buffer;
+		};
+
 		bool m_Running = false;
 
 		V8Data m_Data;
 
 		std::unique_ptr<v8::Platform> m_Platform;
+		// Not loaded if neither a valid one was found nor one could be made, contexts are then built by hand
+		V8Snapshot m_Snapshot;
+
+		// Updates run on the main thread one file after the other, so all modules share one isolate
+		v8::Isolate* m_Isolate = nullptr;
+		v8::ArrayBuffer::Allocator* m_Allocator = nullptr;
+		size_t m_HeapBeforeLoad = 0;
+		size_t m_ScriptsBeforeLoad = 0;
+		// Keyed by the path of the compiled javascript file
+		std::unordered_map<std::string, Scope<V8ScriptModule>> m_Modules;
+		// Views into the component pools of the running scene
+		std::vector<ComponentView> m_ComponentViews;
 
 		std::vector<V8Script*> m_Scripts; // TODO change to a ref
 	};
@@ -0,0 +1,244 @@
+#include "acpch.h"
+
+#include "math/AABBTree.h"
+
+#include <algorithm>
+
+namespace Acorn::Math
+{
+	// How much larger than the given box a proxy is stored, relative to its size plus a floor for flat boxes
+	static constexpr float FatMargin = 0.1f;
+	static constexpr float MinMargin = 0.01f;
+
+	static AABB Fatten(const AABB& box)
+	{
+		return box.Expanded((box.Max - box.Min) * FatMargin + MinMargin);
+	}
+
+	int32_t AABBTree::CreateProxy(const AABB& box, uint32_t data)
+	{
+		int32_t proxy = AllocateNode();
+		m_Nodes[proxy].Box = Fatten(box);
+		m_Nodes[proxy].Data = data;
+		m_Nodes[proxy].Height = 0;
+		InsertLeaf(proxy);
+		m_ProxyCount++;
+		return proxy;
+	}
+
+	void AABBTree::DestroyProxy(int32_t proxy)
+	{
+		AC_CORE_ASSERT(m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].Height == 0, "Not a proxy");
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+		m_ProxyCount--;
+	}
+
+	bool AABBTree::MoveProxy(int32_t proxy, const AABB& box)
+	{
+		AC_CORE_ASSERT(m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].Height == 0, "Not a proxy");
+		// A box that shrank a lot is refitted as well, or the proxy would keep reporting overlaps it no longer has
+		const AABB& fat = m_Nodes[proxy].Box;
+		if (fat.Contains(box) && Fatten(Fatten(box)).Contains(fat))
+			return false;
+
+		RemoveLeaf(proxy);
+		m_Nodes[proxy].Box = Fatten(box);
+		InsertLeaf(proxy);
+		return true;
+	}
+
+	void AABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = Null;
+		m_FreeList = Null;
+		m_ProxyCount = 0;
+	}
+
+	int32_t AABBTree::AllocateNode()
+	{
+		if (m_FreeList == Null)
+		{
+			m_Nodes.emplace_back();
+			return (int32_t)m_Nodes.size() - 1;
+		}
+
+		int32_t node = m_FreeList;
+		m_FreeList = m_Nodes[node].Parent;
+		m_Nodes[node] = Node();
+		return node;
+	}
+
+	void AABBTree::FreeNode(int32_t node)
+	{
+		m_Nodes[node].Parent = m_FreeList;
+		m_Nodes[node].Height = -1;
+		m_FreeList = node;
+	}
+
+	void AABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == Null)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = Null;
+			return;
+		}
+
+		// Walk down to the sibling that makes the tree grow the least
+		const AABB leafBox = m_Nodes[leaf].Box;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const Node& node = m_Nodes[index];
+			float area = node.Box.SurfaceArea();
+			float combinedArea = node.Box.Union(leafBox).SurfaceArea();
+
+			// Pairing with this node pushes everything below it down a level
+			float cost = 2.0f * combinedArea;
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const AABB& childBox = m_Nodes[child].Box;
+				float grownArea = childBox.Union(leafBox).SurfaceArea();
+				if (m_Nodes[child].IsLeaf())
+					return grownArea + inheritanceCost;
+				return grownArea - childBox.SurfaceArea() + inheritanceCost;
+			};
+			float cost1 = descendCost(node.Child1);
+			float cost2 = descendCost(node.Child2);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+			index = cost1 < cost2 ? node.Child1 : node.Child2;
+		}
+
+		int32_t sibling = index;
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+
+		Node& parent = m_Nodes[newParent];
+		parent.Parent = oldParent;
+		parent.Box = leafBox.Union(m_Nodes[sibling].Box);
+		parent.Height = m_Nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent == Null)
+			m_Root = newParent;
+		else if (m_Nodes[oldParent].Child1 == sibling)
+			m_Nodes[oldParent].Child1 = newParent;
+		else
+			m_Nodes[oldParent].Child2 = newParent;
+
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		Refit(m_Nodes[leaf].Parent);
+	}
+
+	void AABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = Null;
+			return;
+		}
+
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		// The sibling takes the place of the parent
+		m_Nodes[sibling].Parent = grandParent;
+		FreeNode(parent);
+
+		if (grandParent == Null)
+		{
+			m_Root = sibling;
+			return;
+		}
+
+		if (m_Nodes[grandParent].Child1 == parent)
+			m_Nodes[grandParent].Child1 = sibling;
+		else
+			m_Nodes[grandParent].Child2 = sibling;
+		Refit(grandParent);
+	}
+
+	void AABBTree::Refit(int32_t index)
+	{
+		while (index != Null)
+		{
+			index = Balance(index);
+
+			Node& node = m_Nodes[index];
+			const Node& child1 = m_Nodes[node.Child1];
+			const Node& child2 = m_Nodes[node.Child2];
+			node.Height = 1 + std::max(child1.Height, child2.Height);
+			node.Box = child1.Box.Union(child2.Box);
+
+			index = node.Parent;
+		}
+	}
+
+	int32_t AABBTree::Balance(int32_t indexA)
+	{
+		Node& a = m_Nodes[indexA];
+		if (a.IsLeaf() || a.Height < 2)
+			return indexA;
+
+		int32_t indexB = a.Child1;
+		int32_t indexC = a.Child2;
+		Node& b = m_Nodes[indexB];
+		Node& c = m_Nodes[indexC];
+
+		int32_t balance = c.Height - b.Height;
+		if (balance >= -1 && balance <= 1)
+			return indexA;
+
+		// The deeper child takes the place of A, A takes the shallower of its children
+		bool rotateC = balance > 1;
+		int32_t indexUp = rotateC ? indexC : indexB;
+		int32_t indexOther = rotateC ? indexB : indexC;
+		Node& up = m_Nodes[indexUp];
+		Node& other = m_Nodes[indexOther];
+
+		int32_t indexF = up.Child1;
+		int32_t indexG = up.Child2;
+		Node& f = m_Nodes[indexF];
+		Node& g = m_Nodes[indexG];
+
+		up.Child1 = indexA;
+		up.Parent = a.Parent;
+		a.Parent = indexUp;
+
+		if (up.Parent == Null)
+			m_Root = indexUp;
+		else if (m_Nodes[up.Parent].Child1 == indexA)
+			m_Nodes[up.Parent].Child1 = indexUp;
+		else
+			m_Nodes[up.Parent].Child2 = indexUp;
+
+		int32_t indexKeep = f.Height > g.Height ? indexF : indexG;
+		int32_t indexGive = f.Height > g.Height ? indexG : indexF;
+		Node& keep = m_Nodes[indexKeep];
+		Node& give = m_Nodes[indexGive];
+
+		up.Child2 = indexKeep;
+		if (rotateC)
+			a.Child2 = indexGive;
+		else
+			a.Child1 = indexGive;
+		give.Parent = indexA;
+
+		a.Box = other.Box.Union(give.Box);
+		a.Height = 1 + std::max(other.Height, give.Height);
+		up.Box = a.Box.Union(keep.Box);
+		up.Height = 1 + std::max(a.Height, keep.Height);
+
+		return indexUp;
+	}
+}
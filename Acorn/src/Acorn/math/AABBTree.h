@@ -0,0 +1,110 @@
+#pragma once
+
+#include "math/Bounds.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Acorn::Math
+{
+	/**
+	 * @brief Dynamic bounding volume tree, the same scheme box2d uses for its broad phase, in 3d.
+	 *
+	 * Every proxy stores a box that is a bit larger than the one it was given, so small movements do not touch the
+	 * tree at all. Leaves are inserted next to the sibling that grows the tree the least and the tree is kept
+	 * balanced by rotations, so queries stay logarithmic no matter the order of inserts.
+	 */
+	class AABBTree
+	{
+	public:
+		static constexpr int32_t Null = -1;
+
+		/**
+		 * @param data
+		 *  Handed to query callbacks, e.g. an entity.
+		 * @return
+		 *  Id of the proxy, stays the same until it is destroyed.
+		 */
+		int32_t CreateProxy(const AABB& box, uint32_t data);
+		void DestroyProxy(int32_t proxy);
+
+		/**
+		 * @return
+		 *  True if the box left the enlarged box of the proxy and it was moved in the tree.
+		 */
+		bool MoveProxy(int32_t proxy, const AABB& box);
+
+		void Clear();
+
+		inline uint32_t GetData(int32_t proxy) const { return m_Nodes[proxy].Data; }
+		inline const AABB& GetFatBounds(int32_t proxy) const { return m_Nodes[proxy].Box; }
+		inline uint32_t GetProxyCount() const { return m_ProxyCount; }
+		inline int32_t GetHeight() const { return m_Root == Null ? 0 : m_Nodes[m_Root].Height; }
+
+		/**
+		 * @param overlaps
+		 *  Tests a box of the tree, subtrees it rejects are skipped.
+		 * @param fn
+		 *  Called with the data of every proxy whose enlarged box passed, callers do their own exact test.
+		 */
+		template <typename Overlaps, typename Fn>
+		void Query(Overlaps&& overlaps, Fn&& fn) const
+		{
+			if (m_Root == Null)
+				return;
+
+			std::vector<int32_t> stack;
+			stack.reserve(64);
+			stack.push_back(m_Root);
+			while (!stack.empty())
+			{
+				const Node& node = m_Nodes[stack.back()];
+				stack.pop_back();
+
+				if (!overlaps(node.Box))
+					continue;
+
+				if (node.IsLeaf())
+				{
+					fn(node.Data);
+					continue;
+				}
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+
+	private:
+		struct Node
+		{
+			AABB Box;
+			// Next free node while the node is unused
+			int32_t Parent = Null;
+			int32_t Child1 = Null;
+			int32_t Child2 = Null;
+			// Leaves are 0, unused nodes -1
+			int32_t Height = -1;
+			uint32_t Data = 0;
+
+			inline bool IsLeaf() const { return Child1 == Null; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t node);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+
+		/**
+		 * @brief Refits the boxes and heights from a node up to the root, rotating where one side got too deep.
+		 */
+		void Refit(int32_t node);
+		int32_t Balance(int32_t node);
+
+	private:
+		std::vector<Node> m_Nodes;
+		int32_t m_Root = Null;
+		int32_t m_FreeList = Null;
+		uint32_t m_ProxyCount = 0;
+	};
+}
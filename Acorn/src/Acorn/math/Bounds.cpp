@@ -0,0 +1,82 @@
+#include "acpch.h"
+
+#include "math/Bounds.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <limits>
+
+namespace Acorn::Math
+{
+	AABB AABB::FromQuad(const glm::mat4& transform)
+	{
+		// A linear transform of a box is bounded by the center plus the absolute half extents along each axis
+		glm::vec3 center = glm::vec3(transform[3]);
+		glm::vec3 extent = 0.5f * (glm::abs(glm::vec3(transform[0])) + glm::abs(glm::vec3(transform[1])));
+		return {center - extent, center + extent};
+	}
+
+	Ray Ray::FromScreen(const glm::vec2& ndc, const glm::mat4& viewProjection)
+	{
+		glm::mat4 inverse = glm::inverse(viewProjection);
+		glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+		nearPoint /= nearPoint.w;
+		farPoint /= farPoint.w;
+		return {glm::vec3(nearPoint), glm::normalize(glm::vec3(farPoint - nearPoint))};
+	}
+
+	bool Ray::Intersects(const AABB& box, float& distance) const
+	{
+		// Slab test, an axis the ray runs parallel to divides by zero and gives infinite bounds
+		glm::vec3 inverse = 1.0f / Direction;
+		glm::vec3 t1 = (box.Min - Origin) * inverse;
+		glm::vec3 t2 = (box.Max - Origin) * inverse;
+		glm::vec3 tMin = glm::min(t1, t2);
+		glm::vec3 tMax = glm::max(t1, t2);
+
+		float enter = glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.0f));
+		float exit = glm::min(glm::min(tMax.x, tMax.y), tMax.z);
+		distance = enter;
+		return enter <= exit;
+	}
+
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		// Gribb and Hartmann, each plane is the w row plus or minus one of the others
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = {viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]};
+
+		m_Planes[0] = rows[3] + rows[0];
+		m_Planes[1] = rows[3] - rows[0];
+		m_Planes[2] = rows[3] + rows[1];
+		m_Planes[3] = rows[3] - rows[1];
+		m_Planes[4] = rows[3] + rows[2];
+		m_Planes[5] = rows[3] - rows[2];
+	}
+
+	Frustum Frustum::FromRect(const glm::mat4& viewProjection, const glm::vec2& ndcMin, const glm::vec2& ndcMax)
+	{
+		// Maps the rectangle onto the whole screen
+		glm::vec2 center = (ndcMin + ndcMax) * 0.5f;
+		glm::vec2 size = glm::max(glm::abs(ndcMax - ndcMin), glm::vec2(std::numeric_limits<float>::epsilon()));
+		glm::mat4 rect = glm::scale(glm::mat4(1.0f), {2.0f / size.x, 2.0f / size.y, 1.0f}) *
+						 glm::translate(glm::mat4(1.0f), {-center.x, -center.y, 0.0f});
+		return Frustum(rect * viewProjection);
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		for (const glm::vec4& plane : m_Planes)
+		{
+			// The corner furthest along the normal
+			glm::vec3 corner = {plane.x >= 0.0f ? box.Max.x : box.Min.x,
+								plane.y >= 0.0f ? box.Max.y : box.Min.y,
+								plane.z >= 0.0f ? box.Max.z : box.Min.z};
+			if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+				return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Acorn::Math
+{
+	/**
+	 * @brief Axis aligned bounding box.
+	 */
+	struct AABB
+	{
+		glm::vec3 Min = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Max = {0.0f, 0.0f, 0.0f};
+
+		/**
+		 * @brief Bounds of the unit quad the 2d renderer draws sprites and circles with, after a transform.
+		 */
+		static AABB FromQuad(const glm::mat4& transform);
+
+		inline AABB Union(const AABB& other) const { return {glm::min(Min, other.Min), glm::max(Max, other.Max)}; }
+		inline AABB Expanded(const glm::vec3& margin) const { return {Min - margin, Max + margin}; }
+
+		inline bool Contains(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+		}
+
+		inline bool Overlaps(const AABB& other) const
+		{
+			return glm::all(glm::lessThanEqual(Min, other.Max)) && glm::all(glm::greaterThanEqual(Max, other.Min));
+		}
+
+		inline float SurfaceArea() const
+		{
+			glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+	};
+
+	struct Ray
+	{
+		glm::vec3 Origin = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Direction = {0.0f, 0.0f, -1.0f};
+
+		/**
+		 * @brief Ray through a point of the screen.
+		 *
+		 * @param ndc
+		 *  Point in normalized device coordinates, -1 to 1 from the bottom left.
+		 */
+		static Ray FromScreen(const glm::vec2& ndc, const glm::mat4& viewProjection);
+
+		/**
+		 * @param distance
+		 *  Set to where the ray enters the box, in multiples of Direction.
+		 */
+		bool Intersects(const AABB& box, float& distance) const;
+	};
+
+	/**
+	 * @brief The volume a view projection sees, as six planes pointing inwards.
+	 */
+	class Frustum
+	{
+	public:
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		/**
+		 * @brief Part of the view inside a rectangle on the screen, e.g. a marquee selection.
+		 *
+		 * @param ndcMin
+		 *  Corner of the rectangle in normalized device coordinates, as is ndcMax.
+		 */
+		static Frustum FromRect(const glm::mat4& viewProjection, const glm::vec2& ndcMin, const glm::vec2& ndcMax);
+
+		/**
+		 * @brief Conservative, a box near an edge of the frustum can pass without touching it.
+		 */
+		bool Intersects(const AABB& box) const;
+
+	private:
+		std::array<glm::vec4, 6> m_Planes;
+	};
+}
@@ -1,9 +1,10 @@
 #include "acpch.h"
 
-#include "ecs/Entity.h"
 #include "ecs/components/Components.h"
 #include "physics/Collider.h"
+#include "physics/PhysicsWorld.h"
 
+#include <box2d/b2_body.h>
 #include <box2d/b2_circle_shape.h>
 #include <box2d/b2_fixture.h>
 #include <box2d/b2_math.h>
@@ -22,22 +23,28 @@ namespace Acorn
 		bool BoxCollider::IsInside(const glm::vec2& point)
 		{
 			AC_PROFILE_FUNCTION();
+			if (m_SharesFixture)
+			{
+				// Static, so this never changes while the world steps
+				glm::vec2 local = point - m_WorldCenter;
+				float c = glm::cos(m_WorldAngle), s = glm::sin(m_WorldAngle);
+				local = {c * local.x + s * local.y, -s * local.x + c * local.y};
+				return glm::abs(local.x) <= m_WorldHalfSize.x && glm::abs(local.y) <= m_WorldHalfSize.y;
+			}
+
 			b2Fixture* fixture = static_cast<b2Fixture*>(m_RuntimeFixture);
 			b2Shape* shape = static_cast<b2Shape*>(fixture->GetShape());
 
 			AC_CORE_ASSERT(fixture && shape, "Fixture or shape is null!");
 
+			std::lock_guard lock(World::FromBody(fixture->GetBody())->GetMutex());
 			return shape->TestPoint(fixture->GetBody()->GetTransform(), b2Vec2(point.x, point.y));
 		}
 
-		void BoxCollider::CreateFixture(Entity entity, const Components::Transform& transform)
+		void BoxCollider::CreateFixture(b2Body* body, const Components::RigidBody2d& rigidBody, const Components::Transform& transform)
 		{
 			AC_PROFILE_FUNCTION();
-			AC_CORE_ASSERT(entity.HasComponent<Components::RigidBody2d>(), "Entity does not have a RigidBody2d component!");
-
-			Components::RigidBody2d rigidBody = entity.GetComponent<Components::RigidBody2d>();
-
-			b2Body* body = static_cast<b2Body*>(rigidBody.RuntimeBody);
+			AC_CORE_ASSERT(body, "Collider needs the body of its RigidBody2d!");
 
 			b2PolygonShape shape;
 			shape.SetAsBox(m_Size.x * transform.Scale.x, m_Size.y * transform.Scale.y, b2Vec2{m_Offset.x, m_Offset.y}, 0.0f);
@@ -50,6 +57,16 @@ namespace Acorn
 			fixtureDef.restitutionThreshold = rigidBody.RestitutionThreshold;
 
 			m_RuntimeFixture = body->CreateFixture(&fixtureDef);
+			m_SharesFixture = false;
+		}
+
+		void BoxCollider::AttachStaticFixture(void* fixture, const glm::vec2& center, const glm::vec2& halfSize, float angle)
+		{
+			m_RuntimeFixture = fixture;
+			m_SharesFixture = true;
+			m_WorldCenter = center;
+			m_WorldHalfSize = halfSize;
+			m_WorldAngle = angle;
 		}
 
 		CircleCollider::CircleCollider(const glm::vec2& offset, float radius)
@@ -62,17 +79,15 @@ namespace Acorn
 			AC_PROFILE_FUNCTION();
 			b2Fixture* fixture = static_cast<b2Fixture*>(m_RuntimeFixture);
 			b2Shape* shape = static_cast<b2Shape*>(fixture->GetShape());
+
+			std::lock_guard lock(World::FromBody(fixture->GetBody())->GetMutex());
 			return shape->TestPoint(fixture->GetBody()->GetTransform(), b2Vec2(point.x, point.y));
 		}
 
-		void CircleCollider::CreateFixture(Entity entity, const Components::Transform& transform)
+		void CircleCollider::CreateFixture(b2Body* body, const Components::RigidBody2d& rigidBody, const Components::Transform& transform)
 		{
 			AC_PROFILE_FUNCTION();
-			AC_CORE_ASSERT(entity.HasComponent<Components::RigidBody2d>(), "Entity does not have a RigidBody2d component!");
-
-			Components::RigidBody2d rigidBody = entity.GetComponent<Components::RigidBody2d>();
-
-			b2Body* body = static_cast<b2Body*>(rigidBody.RuntimeBody);
+			AC_CORE_ASSERT(body, "Collider needs the body of its RigidBody2d!");
 
 			b2CircleShape shape;
 			shape.m_p = b2Vec2{m_Offset.x, m_Offset.y};
@@ -5,11 +5,13 @@
 
 #include <glm/glm.hpp>
 
+class b2Body;
+
 namespace Acorn
 {
-	class Entity;
 	namespace Components
 	{
+		struct RigidBody2d;
 		struct Transform;
 	}
 
@@ -23,7 +25,7 @@ namespace Acorn
 			virtual ~Collider() = default;
 
 			virtual bool IsInside(const glm::vec2& point) = 0;
-			virtual void CreateFixture(Entity entity, const Components::Transform& transform) = 0;
+			virtual void CreateFixture(b2Body* body, const Components::RigidBody2d& rigidBody, const Components::Transform& transform) = 0;
 
 			const glm::vec2& GetOffset() const { return m_Offset; }
 			glm::vec2& GetOffset() { return m_Offset; }
@@ -35,7 +37,7 @@ namespace Acorn
 
 			glm::vec2 m_Offset = glm::vec2{0.0f};
 
-			void* m_RuntimeFixture;
+			void* m_RuntimeFixture = nullptr;
 		};
 
 		class BoxCollider : public Collider
@@ -47,14 +49,28 @@ namespace Acorn
 			~BoxCollider() {}
 
 			virtual bool IsInside(const glm::vec2& point) override;
-			virtual void CreateFixture(Entity entity, const Components::Transform& transform) override;
+			virtual void CreateFixture(b2Body* body, const Components::RigidBody2d& rigidBody, const Components::Transform& transform) override;
 
 			const glm::vec2& GetSize() const { return m_Size; }
 			glm::vec2& GetSize() { return m_Size; }
 			void SetSize(const glm::vec2& size) { m_Size = size; }
 
+			/**
+			 * @brief Attaches the collider to a fixture of the shared static body, which can cover more than this box.
+			 *
+			 * @param center
+			 *  Center of this box in world space, IsInside() tests against it instead of the fixture.
+			 */
+			void AttachStaticFixture(void* fixture, const glm::vec2& center, const glm::vec2& halfSize, float angle);
+
 		private:
 			glm::vec2 m_Size = glm::vec2{1.0f};
+
+			// Set by AttachStaticFixture
+			bool m_SharesFixture = false;
+			glm::vec2 m_WorldCenter = glm::vec2{0.0f};
+			glm::vec2 m_WorldHalfSize = glm::vec2{0.0f};
+			float m_WorldAngle = 0.0f;
 		};
 
 		class CircleCollider : public Collider
@@ -66,7 +82,7 @@ namespace Acorn
 			~CircleCollider() {}
 
 			virtual bool IsInside(const glm::vec2& point) override;
-			virtual void CreateFixture(Entity entity, const Components::Transform& transform) override;
+			virtual void CreateFixture(b2Body* body, const Components::RigidBody2d& rigidBody, const Components::Transform& transform) override;
 
 			float GetRadius() const { return m_Radius; }
 			float& GetRadius() { return m_Radius; }
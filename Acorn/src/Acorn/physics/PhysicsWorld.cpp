@@ -0,0 +1,192 @@
+#include "acpch.h"
+
+#include "physics/PhysicsWorld.h"
+
+#include <box2d/b2_body.h>
+#include <box2d/b2_world.h>
+
+#include <algorithm>
+
+namespace Acorn
+{
+	namespace Physics2D
+	{
+		World::World(const glm::vec2& gravity, const WorldSettings& settings)
+			: m_World(new b2World(b2Vec2(gravity.x, gravity.y))), m_Settings(settings)
+		{
+			// The thread always takes fixed steps, a frame time is not known to it
+			m_Settings.Threaded &= m_Settings.FixedStep;
+			m_Settings.StepRate = std::max(m_Settings.StepRate, 1.0f);
+			m_Settings.MaxStepsPerFrame = std::max(m_Settings.MaxStepsPerFrame, 1u);
+		}
+
+		World::~World()
+		{
+			{
+				std::lock_guard lock(m_StateMutex);
+				m_Stopping = true;
+			}
+			m_StepsRequested.notify_one();
+			if (m_Thread.joinable())
+				m_Thread.join();
+
+			// Destroys the bodies as well
+			delete m_World;
+		}
+
+		uint32_t World::AddBody(b2Body* body)
+		{
+			AC_CORE_ASSERT(!m_Thread.joinable(), "Bodies have to be added before the world is started");
+			body->GetUserData().pointer = reinterpret_cast<uintptr_t>(this);
+			m_Bodies.push_back(body);
+			return (uint32_t)m_Bodies.size() - 1;
+		}
+
+		World* World::FromBody(b2Body* body)
+		{
+			World* world = reinterpret_cast<World*>(body->GetUserData().pointer);
+			AC_CORE_ASSERT(world, "Body was not added to a world");
+			return world;
+		}
+
+		void World::Start()
+		{
+			AC_PROFILE_FUNCTION();
+			m_Front.Current.resize(m_Bodies.size());
+			for (size_t i = 0; i < m_Bodies.size(); i++)
+			{
+				const b2Vec2& position = m_Bodies[i]->GetPosition();
+				m_Front.Current[i] = {{position.x, position.y}, m_Bodies[i]->GetAngle()};
+			}
+			m_Front.Previous = m_Front.Current;
+			m_Front.InMoving.assign(m_Bodies.size(), 0);
+			m_Front.WasMoving.assign(m_Bodies.size(), 0);
+
+			m_MovableBodies.clear();
+			for (uint32_t i = 0; i < (uint32_t)m_Bodies.size(); i++)
+			{
+				if (m_Bodies[i]->GetType() != b2_staticBody)
+					m_MovableBodies.push_back(i);
+			}
+
+			if (m_Settings.Threaded)
+			{
+				m_Back = m_Front;
+				m_Published = m_Front;
+				m_Thread = std::thread(&World::RunThread, this);
+			}
+		}
+
+		void World::Step(float timestep, StateBuffer& buffer)
+		{
+			AC_PROFILE_FUNCTION();
+			std::lock_guard lock(m_WorldMutex);
+			m_World->Step(timestep, m_Settings.VelocityIterations, m_Settings.PositionIterations);
+
+			// Static bodies keep the pose they started with, sleeping ones the pose they fell asleep in
+			for (uint32_t i : m_MovableBodies)
+			{
+				const b2Body* body = m_Bodies[i];
+				const b2Vec2& position = body->GetPosition();
+				BodyState& current = buffer.Current[i];
+				bool changed = current.Position.x != position.x || current.Position.y != position.y || current.Angle != body->GetAngle();
+
+				buffer.Previous[i] = current;
+				current = {{position.x, position.y}, body->GetAngle()};
+
+				bool moving = body->IsAwake() || changed;
+				if (moving || buffer.WasMoving[i])
+					buffer.MarkMoving(i);
+				buffer.WasMoving[i] = moving;
+			}
+			buffer.Steps++;
+		}
+
+		void World::RunThread()
+		{
+			const float stepTime = 1.0f / m_Settings.StepRate;
+			while (true)
+			{
+				{
+					std::unique_lock lock(m_StateMutex);
+					m_StepsRequested.wait(lock, [this]()
+						{
+							return m_Stopping || m_PendingSteps > 0;
+						});
+					if (m_Stopping)
+						return;
+
+					m_PendingSteps--;
+				}
+
+				Step(stepTime, m_Back);
+
+				// Copied rather than swapped, the next step needs the poses it starts from
+				std::lock_guard lock(m_StateMutex);
+				m_Published.Previous = m_Back.Previous;
+				m_Published.Current = m_Back.Current;
+				m_Published.WasMoving = m_Back.WasMoving;
+				m_Published.Steps = m_Back.Steps;
+				// The frame may not have picked up the last publish, its bodies must not get lost
+				m_Published.MergeMoving(m_Back);
+				m_Back.ClearMoving(false);
+				m_HasPublished = true;
+			}
+		}
+
+		void World::Advance(float timestep)
+		{
+			AC_PROFILE_FUNCTION();
+			if (!m_Settings.FixedStep)
+			{
+				Step(timestep, m_Front);
+				m_Alpha = 1.0f;
+				return;
+			}
+
+			const float stepTime = 1.0f / m_Settings.StepRate;
+			m_Accumulator += timestep;
+
+			uint32_t steps = (uint32_t)(m_Accumulator / stepTime);
+			if (steps > m_Settings.MaxStepsPerFrame)
+			{
+				// Drops the time that does not fit, the simulation falls behind instead of stalling the frame
+				steps = m_Settings.MaxStepsPerFrame;
+				m_Accumulator = steps * stepTime;
+			}
+			m_Accumulator -= steps * stepTime;
+			m_Alpha = m_Settings.Interpolate ? m_Accumulator / stepTime : 1.0f;
+
+			if (!m_Settings.Threaded)
+			{
+				for (uint32_t i = 0; i < steps; i++)
+				{
+					Step(stepTime, m_Front);
+				}
+				return;
+			}
+
+			{
+				std::lock_guard lock(m_StateMutex);
+				// A thread that falls behind does not get an ever growing backlog
+				m_PendingSteps = std::min(m_PendingSteps + steps, m_Settings.MaxStepsPerFrame);
+				if (m_HasPublished)
+				{
+					// Bodies the reader has not cleared yet stay in the list
+					m_Published.MergeMoving(m_Front);
+					std::swap(m_Front, m_Published);
+					m_Published.ClearMoving(false);
+					m_HasPublished = false;
+				}
+			}
+			m_StepsRequested.notify_one();
+		}
+
+		BodyState World::GetInterpolatedState(uint32_t index) const
+		{
+			const BodyState& previous = m_Front.Previous[index];
+			const BodyState& current = m_Front.Current[index];
+			return {glm::mix(previous.Position, current.Position, m_Alpha), glm::mix(previous.Angle, current.Angle, m_Alpha)};
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <glm/glm.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class b2Body;
+class b2World;
+
+namespace Acorn
+{
+	namespace Physics2D
+	{
+		struct WorldSettings
+		{
+			// Steps the world with a constant time step, otherwise once per frame with the frame time
+			bool FixedStep = true;
+			// Steps per second of the fixed step
+			float StepRate = 60.0f;
+			int32_t VelocityIterations = 6;
+			int32_t PositionIterations = 2;
+			// Frames slower than this many steps slow the simulation down, instead of piling up more steps
+			uint32_t MaxStepsPerFrame = 8;
+			// Blends between the last two steps, so bodies move smoothly when the frame rate is not the step rate
+			bool Interpolate = true;
+			// Steps on a thread of its own, frames use the latest finished step and never wait for one
+			bool Threaded = false;
+		};
+
+		/**
+		 * @brief Pose of a body after a step.
+		 */
+		struct BodyState
+		{
+			glm::vec2 Position = {0.0f, 0.0f};
+			float Angle = 0.0f;
+		};
+
+		/**
+		 * @brief Owns the box2d world of a running scene and decides when it is stepped.
+		 *
+		 * Bodies are registered once, their poses after the last two steps are kept in arrays in registration order.
+		 * With a physics thread these arrays are triple buffered: the thread fills its own, publishes it with a
+		 * pointer swap, and the frame picks up the latest published one, so neither side waits for the other.
+		 */
+		class World
+		{
+		public:
+			World(const glm::vec2& gravity, const WorldSettings& settings);
+			~World();
+
+			World(const World&) = delete;
+			World& operator=(const World&) = delete;
+
+			/**
+			 * @brief The box2d world, only touch it before Start() or while holding GetMutex().
+			 */
+			inline b2World* GetB2World() { return m_World; }
+			inline std::mutex& GetMutex() { return m_WorldMutex; }
+			inline const WorldSettings& GetSettings() const { return m_Settings; }
+
+			/**
+			 * @brief Registers a body created in this world, has to happen before Start().
+			 *
+			 * @return
+			 *  Index of the body in the state arrays.
+			 */
+			uint32_t AddBody(b2Body* body);
+			inline void ReserveBodies(size_t count) { m_Bodies.reserve(count); }
+
+			/**
+			 * @brief Records the initial poses and starts the physics thread, if there is one.
+			 */
+			void Start();
+
+			/**
+			 * @brief Advances the simulation by the time of a frame.
+			 *
+			 * In fixed step mode the frame time is accumulated and as many steps as fit are taken, the rest becomes
+			 * the interpolation factor.
+			 */
+			void Advance(float timestep);
+
+			/**
+			 * @return
+			 *  Pose of a body between the last two steps, as far as the frame time has progressed.
+			 */
+			BodyState GetInterpolatedState(uint32_t index) const;
+
+			/**
+			 * @brief Bodies whose pose changed in any step since the last ClearMovingBodies().
+			 *
+			 * Static bodies never show up, sleeping ones only up to the step after they stopped, so their final pose is
+			 * written once more. Everything else keeps the pose it was last given. A frame can take several steps, so
+			 * the list collects all of them until the reader clears it.
+			 */
+			inline const std::vector<uint32_t>& GetMovingBodies() const { return m_Front.Moving; }
+
+			/**
+			 * @brief Starts a new list of moving bodies, once the poses of the current one were read.
+			 *
+			 * Bodies that moved in the last step stay in it, their interpolated pose changes every frame until the next step.
+			 */
+			inline void ClearMovingBodies() { m_Front.ClearMoving(true); }
+
+			inline uint32_t GetBodyCount() const { return (uint32_t)m_Bodies.size(); }
+			inline uint64_t GetStepCount() const { return m_Front.Steps; }
+
+			/**
+			 * @return
+			 *  The world a body was registered with, to lock it before touching the body from outside a step.
+			 */
+			static World* FromBody(b2Body* body);
+
+		private:
+			struct StateBuffer
+			{
+				std::vector<BodyState> Previous;
+				std::vector<BodyState> Current;
+				std::vector<uint32_t> Moving;
+				// Per body, whether it is in Moving
+				std::vector<uint8_t> InMoving;
+				// Per body, whether it moved in the last step
+				std::vector<uint8_t> WasMoving;
+				uint64_t Steps = 0;
+
+				inline void MarkMoving(uint32_t body)
+				{
+					if (!InMoving[body])
+					{
+						InMoving[body] = 1;
+						Moving.push_back(body);
+					}
+				}
+
+				inline void MergeMoving(const StateBuffer& other)
+				{
+					for (uint32_t body : other.Moving)
+						MarkMoving(body);
+				}
+
+				inline void ClearMoving(bool keepLastStep)
+				{
+					size_t kept = 0;
+					for (uint32_t body : Moving)
+					{
+						if (keepLastStep && WasMoving[body])
+							Moving[kept++] = body;
+						else
+							InMoving[body] = 0;
+					}
+					Moving.resize(kept);
+				}
+			};
+
+			void Step(float timestep, StateBuffer& buffer);
+			void RunThread();
+
+		private:
+			b2World* m_World;
+			WorldSettings m_Settings;
+			std::vector<b2Body*> m_Bodies;
+			// Bodies that are not static, the only ones whose pose is read back after a step
+			std::vector<uint32_t> m_MovableBodies;
+			std::mutex m_WorldMutex;
+
+			float m_Accumulator = 0.0f;
+			float m_Alpha = 1.0f;
+
+			// Read by the frame
+			StateBuffer m_Front;
+
+			// Shared with the physics thread, guarded by m_StateMutex
+			std::mutex m_StateMutex;
+			std::condition_variable m_StepsRequested;
+			StateBuffer m_Published;
+			bool m_HasPublished = false;
+			uint32_t m_PendingSteps = 0;
+			bool m_Stopping = false;
+
+			// Physics thread only
+			StateBuffer m_Back;
+			std::thread m_Thread;
+		};
+	}
+}
@@ -0,0 +1,154 @@
+#include "acpch.h"
+
+#include "physics/StaticGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace Acorn
+{
+	namespace Physics2D
+	{
+		// A row of touching boxes
+		struct Row
+		{
+			float MinX;
+			float MaxX;
+			float Y;
+			uint32_t First;
+			uint32_t Count;
+		};
+
+		static auto SortKey(const BodyMaterial& material, float halfHeight)
+		{
+			return std::make_tuple(material.Density, material.Friction, material.Restitution, material.RestitutionThreshold, halfHeight);
+		}
+
+		// Tiles are placed by hand or snapped to a grid, small errors in their positions must not stop them from merging
+		static bool NearlyEqual(float a, float b, float tolerance)
+		{
+			return std::abs(a - b) <= tolerance;
+		}
+
+		void StaticGeometry::Begin(size_t expectedCount)
+		{
+			m_Boxes.clear();
+			m_Boxes.reserve(expectedCount);
+		}
+
+		void StaticGeometry::Add(const StaticBox& box)
+		{
+			m_Boxes.push_back(box);
+		}
+
+		bool StaticGeometry::Build()
+		{
+			AC_PROFILE_FUNCTION();
+			if (m_Built && m_Boxes == m_BuiltBoxes)
+				return true;
+
+			std::swap(m_Boxes, m_BuiltBoxes);
+			Merge();
+			m_Built = true;
+			return false;
+		}
+
+		void StaticGeometry::Merge()
+		{
+			AC_PROFILE_FUNCTION();
+			m_Merged.clear();
+			m_Members.clear();
+			m_Members.reserve(m_BuiltBoxes.size());
+
+			std::vector<uint32_t> aligned;
+			aligned.reserve(m_BuiltBoxes.size());
+			for (uint32_t i = 0; i < (uint32_t)m_BuiltBoxes.size(); i++)
+			{
+				const StaticBox& box = m_BuiltBoxes[i];
+				if (box.Angle == 0.0f)
+				{
+					aligned.push_back(i);
+					continue;
+				}
+
+				// Rotated boxes stay on their own
+				m_Merged.push_back({box.Center, box.HalfSize, box.Angle, box.Material, (uint32_t)m_Members.size(), 1});
+				m_Members.push_back(i);
+			}
+
+			// Boxes that can share a row end up next to each other, ordered from left to right
+			std::sort(aligned.begin(), aligned.end(), [this](uint32_t a, uint32_t b)
+				{
+					const StaticBox& lhs = m_BuiltBoxes[a];
+					const StaticBox& rhs = m_BuiltBoxes[b];
+					return std::tuple_cat(SortKey(lhs.Material, lhs.HalfSize.y), std::make_tuple(lhs.HalfSize.x, lhs.Center.y, lhs.Center.x)) <
+						   std::tuple_cat(SortKey(rhs.Material, rhs.HalfSize.y), std::make_tuple(rhs.HalfSize.x, rhs.Center.y, rhs.Center.x));
+				});
+
+			std::vector<Row> rows;
+			for (uint32_t i = 0; i < (uint32_t)aligned.size();)
+			{
+				const StaticBox& first = m_BuiltBoxes[aligned[i]];
+				float tolerance = 1e-3f * std::min(first.HalfSize.x, first.HalfSize.y);
+
+				uint32_t end = i + 1;
+				for (; end < aligned.size(); end++)
+				{
+					const StaticBox& previous = m_BuiltBoxes[aligned[end - 1]];
+					const StaticBox& box = m_BuiltBoxes[aligned[end]];
+					if (box.Material != first.Material || box.HalfSize != first.HalfSize || !NearlyEqual(box.Center.y, first.Center.y, tolerance) ||
+						!NearlyEqual(box.Center.x - previous.Center.x, 2.0f * first.HalfSize.x, tolerance))
+						break;
+				}
+
+				const StaticBox& last = m_BuiltBoxes[aligned[end - 1]];
+				rows.push_back({first.Center.x - first.HalfSize.x, last.Center.x + last.HalfSize.x, first.Center.y, i, end - i});
+				i = end;
+			}
+
+			// Rows that can be stacked end up next to each other, ordered from bottom to top
+			std::sort(rows.begin(), rows.end(), [&](const Row& a, const Row& b)
+				{
+					const StaticBox& lhs = m_BuiltBoxes[aligned[a.First]];
+					const StaticBox& rhs = m_BuiltBoxes[aligned[b.First]];
+					return std::tuple_cat(SortKey(lhs.Material, lhs.HalfSize.y), std::make_tuple(a.MinX, a.MaxX, a.Y)) <
+						   std::tuple_cat(SortKey(rhs.Material, rhs.HalfSize.y), std::make_tuple(b.MinX, b.MaxX, b.Y));
+				});
+
+			for (uint32_t i = 0; i < (uint32_t)rows.size();)
+			{
+				const Row& first = rows[i];
+				const StaticBox& box = m_BuiltBoxes[aligned[first.First]];
+				float tolerance = 1e-3f * std::min(box.HalfSize.x, box.HalfSize.y);
+
+				uint32_t end = i + 1;
+				for (; end < rows.size(); end++)
+				{
+					const Row& row = rows[end];
+					const StaticBox& rowBox = m_BuiltBoxes[aligned[row.First]];
+					if (rowBox.Material != box.Material || rowBox.HalfSize.y != box.HalfSize.y || !NearlyEqual(row.MinX, first.MinX, tolerance) ||
+						!NearlyEqual(row.MaxX, first.MaxX, tolerance) || !NearlyEqual(row.Y - rows[end - 1].Y, 2.0f * box.HalfSize.y, tolerance))
+						break;
+				}
+
+				MergedBox merged;
+				merged.Center = {(first.MinX + first.MaxX) * 0.5f, (first.Y + rows[end - 1].Y) * 0.5f};
+				merged.HalfSize = {(first.MaxX - first.MinX) * 0.5f, (rows[end - 1].Y - first.Y) * 0.5f + box.HalfSize.y};
+				merged.Angle = 0.0f;
+				merged.Material = box.Material;
+				merged.FirstMember = (uint32_t)m_Members.size();
+				for (uint32_t r = i; r < end; r++)
+				{
+					for (uint32_t j = 0; j < rows[r].Count; j++)
+						m_Members.push_back(aligned[rows[r].First + j]);
+				}
+				merged.MemberCount = (uint32_t)m_Members.size() - merged.FirstMember;
+				m_Merged.push_back(merged);
+				i = end;
+			}
+
+			AC_CORE_TRACE("Merged {} static boxes into {}", m_BuiltBoxes.size(), m_Merged.size());
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Acorn
+{
+	namespace Physics2D
+	{
+		struct BodyMaterial
+		{
+			float Density = 1.0f;
+			float Friction = 1.0f;
+			float Restitution = 0.0f;
+			float RestitutionThreshold = 0.5f;
+
+			bool operator==(const BodyMaterial&) const = default;
+		};
+
+		/**
+		 * @brief Box collider of a static body, in world space.
+		 */
+		struct StaticBox
+		{
+			glm::vec2 Center = {0.0f, 0.0f};
+			glm::vec2 HalfSize = {0.5f, 0.5f};
+			float Angle = 0.0f;
+			BodyMaterial Material;
+			// Identifies the collider to the caller, e.g. its entity
+			uint32_t Owner = 0;
+
+			bool operator==(const StaticBox&) const = default;
+		};
+
+		/**
+		 * @brief Box that replaces a group of adjacent static boxes, or a single one that could not be merged.
+		 */
+		struct MergedBox
+		{
+			glm::vec2 Center;
+			glm::vec2 HalfSize;
+			float Angle;
+			BodyMaterial Material;
+			// Range of GetMember()
+			uint32_t FirstMember;
+			uint32_t MemberCount;
+		};
+
+		/**
+		 * @brief Merges the box colliders of static bodies, e.g. the tiles of a tilemap, into as few boxes as possible.
+		 *
+		 * Axis aligned boxes of the same size and material that touch are first joined into rows, rows that span the
+		 * same columns are then stacked. The result is kept and handed out again as long as the boxes added for the
+		 * next build are exactly the same, so a scene that is played repeatedly merges its tiles only once.
+		 */
+		class StaticGeometry
+		{
+		public:
+			/**
+			 * @brief Starts collecting the boxes of the next build.
+			 */
+			void Begin(size_t expectedCount = 0);
+			void Add(const StaticBox& box);
+
+			/**
+			 * @return
+			 *  True if the merged boxes of the previous build were reused.
+			 */
+			bool Build();
+
+			// Whether boxes were added since Begin()
+			inline bool IsEmpty() const { return m_Boxes.empty(); }
+			inline const std::vector<MergedBox>& GetMergedBoxes() const { return m_Merged; }
+
+			/**
+			 * @return
+			 *  The box a merged box was made of, index is in the range FirstMember and MemberCount describe.
+			 */
+			inline const StaticBox& GetMember(uint32_t index) const { return m_BuiltBoxes[m_Members[index]]; }
+
+		private:
+			void Merge();
+
+		private:
+			std::vector<StaticBox> m_Boxes;
+
+			// Result of the last build and the boxes it was made from
+			std::vector<StaticBox> m_BuiltBoxes;
+			std::vector<MergedBox> m_Merged;
+			std::vector<uint32_t> m_Members;
+			bool m_Built = false;
+		};
+	}
+}
@@ -0,0 +1,73 @@
+#include "acpch.h"
+
+#include "renderer/2d/DrawList.h"
+
+#include <array>
+#include <cstring>
+
+namespace Acorn::ext2d
+{
+	namespace DrawKey
+	{
+		uint64_t Create(uint8_t layer, float depth, uint8_t shader, uint16_t texture, bool backToFront)
+		{
+			// Map the float onto an unsigned integer with the same ordering, flip all bits of negatives and only the sign of positives
+			uint32_t depthBits;
+			std::memcpy(&depthBits, &depth, sizeof(depthBits));
+			depthBits = (depthBits & 0x80000000u) ? ~depthBits : depthBits | 0x80000000u;
+
+			if (backToFront)
+				return ((uint64_t)layer << 56) | ((uint64_t)(depthBits >> 8) << 32) | ((uint64_t)shader << 24) | ((uint64_t)texture << 8) | 1;
+
+			return ((uint64_t)layer << 56) | ((uint64_t)shader << 48) | ((uint64_t)texture << 32) | ((uint64_t)(depthBits >> 8) << 8);
+		}
+	}
+
+	void DrawList::Sort()
+	{
+		AC_PROFILE_FUNCTION();
+
+		// The lowest byte only holds flags that are the same within a layer
+		constexpr uint32_t firstByte = 1;
+		constexpr uint32_t byteCount = 8;
+
+		if (m_Commands.size() < 2)
+			return;
+
+		std::array<std::array<uint32_t, 256>, byteCount> histograms = {};
+		for (const Command& command : m_Commands)
+		{
+			for (uint32_t byte = firstByte; byte < byteCount; byte++)
+			{
+				histograms[byte][(command.Key >> (byte * 8)) & 0xff]++;
+			}
+		}
+
+		m_Scratch.resize(m_Commands.size());
+
+		for (uint32_t byte = firstByte; byte < byteCount; byte++)
+		{
+			std::array<uint32_t, 256>& histogram = histograms[byte];
+
+			// Every key shares this byte, the pass would not change the order
+			uint8_t firstDigit = (m_Commands.front().Key >> (byte * 8)) & 0xff;
+			if (histogram[firstDigit] == m_Commands.size())
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t& count : histogram)
+			{
+				uint32_t bucketSize = count;
+				count = offset;
+				offset += bucketSize;
+			}
+
+			for (const Command& command : m_Commands)
+			{
+				m_Scratch[histogram[(command.Key >> (byte * 8)) & 0xff]++] = command;
+			}
+
+			m_Commands.swap(m_Scratch);
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Acorn::ext2d
+{
+	/**
+	 * @brief 64 bit sort key of a deferred draw, draws are emitted in ascending key order.
+	 *
+	 * By texture:    | layer (8) | shader (8) | texture (16) | depth (24) | flags (8) |
+	 * Back to front: | layer (8) | depth (24) | shader (8) | texture (16) | flags (8) |
+	 *
+	 * Grouping by shader and texture first puts sprites sharing a texture into one batch no matter their depth, but a
+	 * translucent sprite then only blends right over sprites of its own texture. Layers that may hold translucent draws
+	 * sort back to front (ascending z) across all textures instead, at the cost of more batches. Every draw of a layer
+	 * uses the same layout, which flag bit 0 records so the fields can be read back.
+	 */
+	namespace DrawKey
+	{
+		uint64_t Create(uint8_t layer, float depth, uint8_t shader, uint16_t texture, bool backToFront = false);
+
+		inline bool IsBackToFront(uint64_t key) { return (key & 1) != 0; }
+		inline uint8_t GetLayer(uint64_t key) { return (uint8_t)(key >> 56); }
+		inline uint8_t GetShader(uint64_t key) { return (uint8_t)(key >> (IsBackToFront(key) ? 24 : 48)); }
+		inline uint16_t GetTexture(uint64_t key) { return (uint16_t)(key >> (IsBackToFront(key) ? 8 : 32)); }
+	}
+
+	class DrawList
+	{
+	public:
+		struct Command
+		{
+			uint64_t Key;
+			// Index into the payload owned by the submitter
+			uint32_t Index;
+		};
+
+	public:
+		void Push(uint64_t key, uint32_t index) { m_Commands.push_back({key, index}); }
+		void Clear() { m_Commands.clear(); }
+		void Reserve(size_t count) { m_Commands.reserve(count); }
+
+		/**
+		 * @brief Stable LSD radix sort of the commands by key.
+		 *
+		 * Passes over bytes that are equal for every key are skipped, so typical scenes (one layer, one shader) only pay for the texture and depth bytes.
+		 * The flags byte is not sorted on, it is the same for every draw of a layer.
+		 */
+		void Sort();
+
+		inline const std::vector<Command>& GetCommands() const { return m_Commands; }
+		inline size_t Size() const { return m_Commands.size(); }
+		inline bool Empty() const { return m_Commands.empty(); }
+
+	private:
+		std::vector<Command> m_Commands;
+		std::vector<Command> m_Scratch;
+	};
+}
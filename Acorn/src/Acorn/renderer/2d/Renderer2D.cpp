@@ -1,11 +1,14 @@
 #include "acpch.h"
 
+#include "renderer/2d/DrawList.h"
 #include "renderer/2d/Renderer2D.h"
 #include "renderer/BatchRenderer.h"
+#include "renderer/InstancedBatchRenderer.h"
 #include "renderer/RenderCommand.h"
 #include "renderer/Shader.h"
 #include "renderer/UniformBuffer.h"
 #include "renderer/VertexArray.h"
+#include "utils/ThreadPool.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -34,16 +37,49 @@ namespace Acorn::ext2d
 		int EntityId;
 	};
 
+	// Columns 0, 1 and 3 of the transform, a quad has no extent along its local z so column 2 is never used
+	struct QuadInstance
+	{
+		glm::vec3 Right;
+		glm::vec3 Up;
+		glm::vec3 Translation;
+		glm::vec4 Color;
+		// Min and max texture coordinates
+		glm::vec4 TexRect;
+		float TexIndex;
+		float TilingFactor;
+
+		int EntityId = -1;
+	};
+
+	struct CircleInstance
+	{
+		glm::vec3 Right;
+		glm::vec3 Up;
+		glm::vec3 Translation;
+		glm::vec4 Color;
+		float Thickness;
+		float Fade;
+
+		int EntityId;
+	};
+
 	struct Renderer2dStorage
 	{
 		Ref<Texture2d> WhiteTexture;
 		Ref<Shader> TextureShader;
 		Ref<Shader> CircleShader;
+		Ref<Shader> InstancedTextureShader;
+		Ref<Shader> InstancedCircleShader;
 
 		glm::vec4 QuadVertexPositions[4];
 
 		Scope<BatchRenderer<QuadVertex, 6, 4>> QuadRenderer;
 		Scope<BatchRenderer<CircleVertex, 6, 4>> CircleRenderer;
+		Scope<InstancedBatchRenderer<QuadInstance>> QuadInstanceRenderer;
+		Scope<InstancedBatchRenderer<CircleInstance>> CircleInstanceRenderer;
+
+		GeometryMode Geometry = GeometryMode::Vertices;
 
 		struct CameraData
 		{
@@ -52,13 +88,184 @@ namespace Acorn::ext2d
 
 		CameraData CameraBuffer;
 		Ref<UniformBuffer> CameraUniformBuffer;
+
+		// Sorted submission
+		SubmissionMode Submission = SubmissionMode::Immediate;
+		uint8_t Layer = 0;
+		LayerOrder Order = LayerOrder::BackToFront;
+
+		DrawList DeferredDraws;
+		std::vector<std::array<QuadVertex, 4>> DeferredQuads;
+		std::vector<std::array<CircleVertex, 4>> DeferredCircles;
+		std::vector<QuadInstance> DeferredQuadInstances;
+		std::vector<CircleInstance> DeferredCircleInstances;
+		// Textures referenced by the draw keys, by first use in the current scene
+		std::vector<Ref<Texture2d>> DeferredTextures;
+		std::unordered_map<const Texture2d*, uint16_t> DeferredTextureIds;
+
+		// Parallel sprite generation, kept between frames to reuse the memory
+		std::vector<std::array<QuadVertex, 4>> SpriteVertices;
+		std::vector<QuadInstance> SpriteInstances;
+		std::vector<const Ref<Texture2d>*> SpriteTextures;
+
+		CullingStats Culling;
 	};
 
+	static constexpr glm::vec2 QuadTexCoords[] = {
+		{0.0f, 0.0f},
+		{1.0f, 0.0f},
+		{1.0f, 1.0f},
+		{0.0f, 1.0f}};
+
+	// Below this many sprites per thread the hand off costs more than it saves
+	static constexpr uint32_t MinSpritesPerThread = 1024;
+
+	// Shader part of the draw key
+	static constexpr uint8_t QuadShaderId = 0;
+	static constexpr uint8_t CircleShaderId = 1;
+	static constexpr uint8_t QuadInstanceShaderId = 2;
+	static constexpr uint8_t CircleInstanceShaderId = 3;
+
 	static Renderer2dStorage s_Data;
 
-	void Renderer::Init()
+	static uint16_t GetDeferredTextureId(const Ref<Texture2d>& texture)
+	{
+		auto [it, inserted] = s_Data.DeferredTextureIds.try_emplace(texture.get(), (uint16_t)s_Data.DeferredTextures.size());
+		if (inserted)
+		{
+			AC_CORE_ASSERT(s_Data.DeferredTextures.size() < UINT16_MAX, "Too many textures in one scene for sorted submission!");
+			s_Data.DeferredTextures.push_back(texture);
+		}
+
+		return it->second;
+	}
+
+	static uint64_t GetDrawKey(float depth, uint8_t shader, uint16_t texture)
+	{
+		return DrawKey::Create(s_Data.Layer, depth, shader, texture, s_Data.Order == LayerOrder::BackToFront);
+	}
+
+	static void SubmitQuad(const Ref<Texture2d>& texture, const std::array<QuadVertex, 4>& vertices, float depth)
+	{
+		if (s_Data.Submission == SubmissionMode::Immediate)
+		{
+			s_Data.QuadRenderer->Draw(texture, vertices);
+			return;
+		}
+
+		s_Data.DeferredDraws.Push(GetDrawKey(depth, QuadShaderId, GetDeferredTextureId(texture)), (uint32_t)s_Data.DeferredQuads.size());
+		s_Data.DeferredQuads.push_back(vertices);
+	}
+
+	static void SubmitQuad(const Ref<Texture2d>& texture, const QuadInstance& instance)
+	{
+		if (s_Data.Submission == SubmissionMode::Immediate)
+		{
+			s_Data.QuadInstanceRenderer->Draw(texture, instance);
+			return;
+		}
+
+		s_Data.DeferredDraws.Push(GetDrawKey(instance.Translation.z, QuadInstanceShaderId, GetDeferredTextureId(texture)), (uint32_t)s_Data.DeferredQuadInstances.size());
+		s_Data.DeferredQuadInstances.push_back(instance);
+	}
+
+	static void SubmitCircle(const std::array<CircleVertex, 4>& vertices, float depth)
+	{
+		if (s_Data.Submission == SubmissionMode::Immediate)
+		{
+			s_Data.CircleRenderer->Draw(vertices);
+			return;
+		}
+
+		s_Data.DeferredDraws.Push(GetDrawKey(depth, CircleShaderId, 0), (uint32_t)s_Data.DeferredCircles.size());
+		s_Data.DeferredCircles.push_back(vertices);
+	}
+
+	static void SubmitCircle(const CircleInstance& instance)
+	{
+		if (s_Data.Submission == SubmissionMode::Immediate)
+		{
+			s_Data.CircleInstanceRenderer->Draw(instance);
+			return;
+		}
+
+		s_Data.DeferredDraws.Push(GetDrawKey(instance.Translation.z, CircleInstanceShaderId, 0), (uint32_t)s_Data.DeferredCircleInstances.size());
+		s_Data.DeferredCircleInstances.push_back(instance);
+	}
+
+	static void FillQuadVertices(std::array<QuadVertex, 4>& vertices, const glm::mat4& transform, const glm::vec4& tint, const glm::vec2* texCoords, float tilingfactor, int entityId)
+	{
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			vertices[i].Position = transform * s_Data.QuadVertexPositions[i];
+			vertices[i].Color = tint;
+			vertices[i].TexCoord = texCoords[i];
+			vertices[i].TexIndex = 0;
+			vertices[i].TilingFactor = tilingfactor;
+			vertices[i].EntityId = entityId;
+		}
+	}
+
+	static QuadInstance CreateQuadInstance(const glm::mat4& transform, const glm::vec4& tint, const glm::vec4& texRect, float tilingfactor, int entityId)
+	{
+		QuadInstance instance;
+		instance.Right = transform[0];
+		instance.Up = transform[1];
+		instance.Translation = transform[3];
+		instance.Color = tint;
+		instance.TexRect = texRect;
+		instance.TexIndex = 0;
+		instance.TilingFactor = tilingfactor;
+		instance.EntityId = entityId;
+		return instance;
+	}
+
+	/**
+	 * @brief Sort the recorded draws and feed them into the batches, textures are contiguous afterwards so slots only run out once all are in use.
+	 */
+	static void EmitDeferredDraws()
+	{
+		AC_PROFILE_FUNCTION();
+
+		s_Data.DeferredDraws.Sort();
+
+		for (const DrawList::Command& command : s_Data.DeferredDraws.GetCommands())
+		{
+			switch (DrawKey::GetShader(command.Key))
+			{
+				case QuadShaderId:
+					s_Data.QuadRenderer->Draw(s_Data.DeferredTextures[DrawKey::GetTexture(command.Key)], s_Data.DeferredQuads[command.Index]);
+					break;
+				case CircleShaderId:
+					s_Data.CircleRenderer->Draw(s_Data.DeferredCircles[command.Index]);
+					break;
+				case QuadInstanceShaderId:
+					s_Data.QuadInstanceRenderer->Draw(s_Data.DeferredTextures[DrawKey::GetTexture(command.Key)], s_Data.DeferredQuadInstances[command.Index]);
+					break;
+				case CircleInstanceShaderId:
+					s_Data.CircleInstanceRenderer->Draw(s_Data.DeferredCircleInstances[command.Index]);
+					break;
+				default:
+					AC_CORE_ASSERT(false, "Unknown shader in draw key!");
+					break;
+			}
+		}
+
+		s_Data.DeferredDraws.Clear();
+		s_Data.DeferredQuads.clear();
+		s_Data.DeferredCircles.clear();
+		s_Data.DeferredQuadInstances.clear();
+		s_Data.DeferredCircleInstances.clear();
+		s_Data.DeferredTextures.clear();
+		s_Data.DeferredTextureIds.clear();
+	}
+
+	void Renderer::Init(const RendererSpecs& specs)
 	{
 		AC_PROFILE_FUNCTION();
+		s_Data.Submission = specs.Submission;
+		s_Data.Geometry = specs.Geometry;
+
 		BufferLayout layout = {
 			{ShaderDataType::Float3, "a_Position"},
 			{ShaderDataType::Float4, "a_Color"},
@@ -80,7 +287,7 @@ namespace Acorn::ext2d
 		s_Data.QuadVertexPositions[3] = {-0.5f, 0.5f, 0.0f, 1.0f};
 
 		std::array<uint32_t, 6> indices = {0, 1, 2, 2, 3, 0};
-		s_Data.QuadRenderer = CreateScope<BatchRenderer<QuadVertex, 6, 4>>(s_Data.TextureShader, indices, layout);
+		s_Data.QuadRenderer = CreateScope<BatchRenderer<QuadVertex, 6, 4>>(s_Data.TextureShader, indices, layout, specs.VertexStreaming);
 		s_Data.CameraUniformBuffer = UniformBuffer::Create(sizeof(Renderer2dStorage::CameraData), 0);
 
 		BufferLayout circleLayout = {
@@ -93,7 +300,38 @@ namespace Acorn::ext2d
 		};
 
 		s_Data.CircleShader = Shader::Create(Acorn::Utils::File::ResolveResPath("res/shaders/Circle.shader"));
-		s_Data.CircleRenderer = CreateScope<BatchRenderer<CircleVertex, 6, 4>>(s_Data.CircleShader, indices, circleLayout);
+		s_Data.CircleRenderer = CreateScope<BatchRenderer<CircleVertex, 6, 4>>(s_Data.CircleShader, indices, circleLayout, specs.VertexStreaming);
+
+		BufferLayout quadInstanceLayout(
+			{
+				{ShaderDataType::Float3, "a_Right"},
+				{ShaderDataType::Float3, "a_Up"},
+				{ShaderDataType::Float3, "a_Translation"},
+				{ShaderDataType::Float4, "a_Color"},
+				{ShaderDataType::Float4, "a_TexRect"},
+				{ShaderDataType::Float, "a_TexIndex"},
+				{ShaderDataType::Float, "a_TilingFactor"},
+				{ShaderDataType::Int, "a_EntityId"},
+			},
+			true);
+
+		s_Data.InstancedTextureShader = Shader::Create(Acorn::Utils::File::ResolveResPath("res/shaders/TexturedInstanced.shader"));
+		s_Data.QuadInstanceRenderer = CreateScope<InstancedBatchRenderer<QuadInstance>>(s_Data.InstancedTextureShader, quadInstanceLayout, specs.VertexStreaming);
+
+		BufferLayout circleInstanceLayout(
+			{
+				{ShaderDataType::Float3, "a_Right"},
+				{ShaderDataType::Float3, "a_Up"},
+				{ShaderDataType::Float3, "a_Translation"},
+				{ShaderDataType::Float4, "a_Color"},
+				{ShaderDataType::Float, "a_Thickness"},
+				{ShaderDataType::Float, "a_Fade"},
+				{ShaderDataType::Int, "a_EntityId"},
+			},
+			true);
+
+		s_Data.InstancedCircleShader = Shader::Create(Acorn::Utils::File::ResolveResPath("res/shaders/CircleInstanced.shader"));
+		s_Data.CircleInstanceRenderer = CreateScope<InstancedBatchRenderer<CircleInstance>>(s_Data.InstancedCircleShader, circleInstanceLayout, specs.VertexStreaming);
 	}
 
 	void Renderer::ShutDown()
@@ -103,11 +341,22 @@ namespace Acorn::ext2d
 		s_Data.WhiteTexture.reset();
 		s_Data.TextureShader.reset();
 		s_Data.CircleShader.reset();
+		s_Data.InstancedTextureShader.reset();
+		s_Data.InstancedCircleShader.reset();
 
 		s_Data.QuadRenderer.reset();
 		s_Data.CircleRenderer.reset();
+		s_Data.QuadInstanceRenderer.reset();
+		s_Data.CircleInstanceRenderer.reset();
 
 		s_Data.CameraUniformBuffer.reset();
+
+		s_Data.DeferredTextures.clear();
+		s_Data.DeferredTextureIds.clear();
+
+		s_Data.SpriteVertices = {};
+		s_Data.SpriteInstances = {};
+		s_Data.SpriteTextures = {};
 	}
 
 	void Renderer::BeginScene(const EditorCamera& camera)
@@ -119,6 +368,10 @@ namespace Acorn::ext2d
 
 		s_Data.QuadRenderer->Begin();
 		s_Data.CircleRenderer->Begin();
+		s_Data.QuadInstanceRenderer->Begin();
+		s_Data.CircleInstanceRenderer->Begin();
+		s_Data.Layer = 0;
+		s_Data.Order = LayerOrder::BackToFront;
 	}
 
 	void Renderer::BeginScene(const Camera& camera, const glm::mat4& transform)
@@ -130,15 +383,64 @@ namespace Acorn::ext2d
 
 		s_Data.QuadRenderer->Begin();
 		s_Data.CircleRenderer->Begin();
+		s_Data.QuadInstanceRenderer->Begin();
+		s_Data.CircleInstanceRenderer->Begin();
+		s_Data.Layer = 0;
+		s_Data.Order = LayerOrder::BackToFront;
 	}
 
 	void Renderer::EndScene()
 	{
 		AC_PROFILE_FUNCTION();
 
+		if (!s_Data.DeferredDraws.Empty())
+		{
+			EmitDeferredDraws();
+		}
+
 		s_Data.CameraUniformBuffer->Bind();
 		s_Data.QuadRenderer->End();
 		s_Data.CircleRenderer->End();
+		s_Data.QuadInstanceRenderer->End();
+		s_Data.CircleInstanceRenderer->End();
+	}
+
+	void Renderer::EndFrame()
+	{
+		AC_PROFILE_FUNCTION();
+
+		s_Data.QuadRenderer->EndFrame();
+		s_Data.CircleRenderer->EndFrame();
+		s_Data.QuadInstanceRenderer->EndFrame();
+		s_Data.CircleInstanceRenderer->EndFrame();
+	}
+
+	void Renderer::SetSubmissionMode(SubmissionMode mode)
+	{
+		AC_CORE_ASSERT(s_Data.DeferredDraws.Empty(), "Submission mode can't change while a scene is recorded!");
+		s_Data.Submission = mode;
+	}
+
+	SubmissionMode Renderer::GetSubmissionMode()
+	{
+		return s_Data.Submission;
+	}
+
+	void Renderer::SetGeometryMode(GeometryMode mode)
+	{
+		AC_CORE_ASSERT(s_Data.DeferredDraws.Empty(), "Geometry mode can't change while a scene is recorded!");
+		s_Data.Geometry = mode;
+	}
+
+	GeometryMode Renderer::GetGeometryMode()
+	{
+		return s_Data.Geometry;
+	}
+
+	void Renderer::SetLayer(uint8_t layer, LayerOrder order)
+	{
+		s_Data.Layer = layer;
+		s_Data.Order = order;
 	}
 
 	void Renderer::FillQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
@@ -213,22 +515,19 @@ namespace Acorn::ext2d
 	{
 		AC_PROFILE_FUNCTION();
 
-		constexpr size_t quadVertexCount = 4;
 		const glm::vec2* texCoords = subTexture->GetTexCoords();
 
-		std::array<QuadVertex, quadVertexCount> vertices;
-
-		for (size_t i = 0; i < quadVertexCount; i++)
+		if (s_Data.Geometry == GeometryMode::Instanced)
 		{
-			vertices[i].Position = transform * s_Data.QuadVertexPositions[i];
-			vertices[i].Color = tint;
-			vertices[i].TexCoord = texCoords[i];
-			vertices[i].TexIndex = 0;
-			vertices[i].TilingFactor = tilingfactor;
-			vertices[i].EntityId = entityId;
+			glm::vec4 texRect = {texCoords[0].x, texCoords[0].y, texCoords[2].x, texCoords[2].y};
+			SubmitQuad(subTexture->GetTexture(), CreateQuadInstance(transform, tint, texRect, tilingfactor, entityId));
+			return;
 		}
 
-		s_Data.QuadRenderer->Draw(subTexture->GetTexture(), vertices);
+		std::array<QuadVertex, 4> vertices;
+		FillQuadVertices(vertices, transform, tint, texCoords, tilingfactor, entityId);
+
+		SubmitQuad(subTexture->GetTexture(), vertices, transform[3][2]);
 	}
 
 	void Renderer::FillQuad(const glm::mat4& transform, const Ref<Texture2d>& texture, float tilingfactor /*= 1.0f*/)
@@ -240,32 +539,36 @@ namespace Acorn::ext2d
 	{
 		AC_PROFILE_FUNCTION();
 
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 texCoords[] = {
-			{0.0f, 0.0f},
-			{1.0f, 0.0f},
-			{1.0f, 1.0f},
-			{0.0f, 1.0f}};
-
-		std::array<QuadVertex, quadVertexCount> vertices;
-
-		for (size_t i = 0; i < quadVertexCount; i++)
+		if (s_Data.Geometry == GeometryMode::Instanced)
 		{
-			vertices[i].Position = transform * s_Data.QuadVertexPositions[i];
-			vertices[i].Color = tint;
-			vertices[i].TexCoord = texCoords[i];
-			vertices[i].TexIndex = 0;
-			vertices[i].TilingFactor = tilingfactor;
-			vertices[i].EntityId = entityId;
+			SubmitQuad(texture, CreateQuadInstance(transform, tint, {0.0f, 0.0f, 1.0f, 1.0f}, tilingfactor, entityId));
+			return;
 		}
 
-		s_Data.QuadRenderer->Draw(texture, vertices);
+		std::array<QuadVertex, 4> vertices;
+		FillQuadVertices(vertices, transform, tint, QuadTexCoords, tilingfactor, entityId);
+
+		SubmitQuad(texture, vertices, transform[3][2]);
 	}
 
 	void Renderer::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade, int entityId)
 	{
 		AC_PROFILE_FUNCTION();
 
+		if (s_Data.Geometry == GeometryMode::Instanced)
+		{
+			CircleInstance instance;
+			instance.Right = transform[0];
+			instance.Up = transform[1];
+			instance.Translation = transform[3];
+			instance.Color = color;
+			instance.Thickness = thickness;
+			instance.Fade = fade;
+			instance.EntityId = entityId;
+			SubmitCircle(instance);
+			return;
+		}
+
 		constexpr size_t quadVertexCount = 4;
 
 		std::array<CircleVertex, quadVertexCount> vertices;
@@ -280,7 +583,7 @@ namespace Acorn::ext2d
 			vertices[i].EntityId = entityId;
 		}
 
-		s_Data.CircleRenderer->Draw(vertices);
+		SubmitCircle(vertices, transform[3][2]);
 	}
 
 	//==============================================================================================
@@ -354,33 +657,147 @@ namespace Acorn::ext2d
 		}
 	}
 
+	void Renderer::DrawSprites(uint32_t count, const std::function<SpriteDrawData(uint32_t index)>& getSprite)
+	{
+		AC_PROFILE_FUNCTION();
+
+		if (count == 0)
+			return;
+
+		Utils::ThreadPool& pool = Utils::ThreadPool::Get();
+		s_Data.SpriteTextures.resize(count);
+
+		if (s_Data.Geometry == GeometryMode::Instanced)
+		{
+			s_Data.SpriteInstances.resize(count);
+			pool.ParallelFor(count, MinSpritesPerThread, [&](uint32_t begin, uint32_t end)
+				{
+					for (uint32_t i = begin; i < end; i++)
+					{
+						SpriteDrawData data = getSprite(i);
+						bool textured = (bool)data.Sprite->Texture;
+
+						s_Data.SpriteTextures[i] = textured ? &data.Sprite->Texture : &s_Data.WhiteTexture;
+						s_Data.SpriteInstances[i] = CreateQuadInstance(data.Transform, data.Sprite->Color, {0.0f, 0.0f, 1.0f, 1.0f}, textured ? data.Sprite->TilingFactor : 1.0f, data.EntityId);
+					}
+				});
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				SubmitQuad(*s_Data.SpriteTextures[i], s_Data.SpriteInstances[i]);
+			}
+			return;
+		}
+
+		s_Data.SpriteVertices.resize(count);
+		pool.ParallelFor(count, MinSpritesPerThread, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					SpriteDrawData data = getSprite(i);
+					bool textured = (bool)data.Sprite->Texture;
+
+					s_Data.SpriteTextures[i] = textured ? &data.Sprite->Texture : &s_Data.WhiteTexture;
+					FillQuadVertices(s_Data.SpriteVertices[i], data.Transform, data.Sprite->Color, QuadTexCoords, textured ? data.Sprite->TilingFactor : 1.0f, data.EntityId);
+				}
+			});
+
+		if (s_Data.Submission == SubmissionMode::Sorted)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto& vertices = s_Data.SpriteVertices[i];
+				// The quad center lies halfway between opposite corners
+				SubmitQuad(*s_Data.SpriteTextures[i], vertices, (vertices[0].Position.z + vertices[2].Position.z) * 0.5f);
+			}
+			return;
+		}
+
+		// Consecutive sprites sharing a texture go into the batch as one block copy
+		static_assert(sizeof(std::array<QuadVertex, 4>) == 4 * sizeof(QuadVertex), "Sprite vertices have to be contiguous");
+		const QuadVertex* vertices = s_Data.SpriteVertices.front().data();
+		uint32_t runStart = 0;
+		for (uint32_t i = 1; i <= count; i++)
+		{
+			if (i == count || s_Data.SpriteTextures[i]->get() != s_Data.SpriteTextures[runStart]->get())
+			{
+				s_Data.QuadRenderer->DrawBatch(std::span<const QuadVertex>(vertices + runStart * 4, (i - runStart) * 4), *s_Data.SpriteTextures[runStart]);
+				runStart = i;
+			}
+		}
+	}
+
 	//================================================================
 	//   Renderer Stats
 	//================================================================
 
 	uint32_t Renderer::GetDrawCalls()
 	{
-		return s_Data.QuadRenderer->GetStats().DrawCalls + s_Data.CircleRenderer->GetStats().DrawCalls;
+		return s_Data.QuadRenderer->GetStats().DrawCalls + s_Data.CircleRenderer->GetStats().DrawCalls +
+			   s_Data.QuadInstanceRenderer->GetStats().DrawCalls + s_Data.CircleInstanceRenderer->GetStats().DrawCalls;
+	}
+
+	static uint32_t GetInstanceCount()
+	{
+		return s_Data.QuadInstanceRenderer->GetStats().ObjectCount + s_Data.CircleInstanceRenderer->GetStats().ObjectCount;
 	}
 
 	uint32_t Renderer::GetQuadCount()
 	{
-		return s_Data.QuadRenderer->GetStats().ObjectCount + s_Data.CircleRenderer->GetStats().ObjectCount;
+		return s_Data.QuadRenderer->GetStats().ObjectCount + s_Data.CircleRenderer->GetStats().ObjectCount + GetInstanceCount();
 	}
 
+	// Instanced quads are counted with the vertices and indices the GPU expands them to
+
 	uint32_t Renderer::GetIndexCount()
 	{
-		return s_Data.QuadRenderer->GetStats().GetTotalIndexCount() + s_Data.CircleRenderer->GetStats().GetTotalIndexCount();
+		return s_Data.QuadRenderer->GetStats().GetTotalIndexCount() + s_Data.CircleRenderer->GetStats().GetTotalIndexCount() + GetInstanceCount() * 6;
 	}
 
 	uint32_t Renderer::GetVertexCount()
 	{
-		return s_Data.QuadRenderer->GetStats().GetTotalVertexCount() + s_Data.CircleRenderer->GetStats().GetTotalVertexCount();
+		return s_Data.QuadRenderer->GetStats().GetTotalVertexCount() + s_Data.CircleRenderer->GetStats().GetTotalVertexCount() + GetInstanceCount() * 4;
+	}
+
+	float Renderer::GetStallTime()
+	{
+		return s_Data.QuadRenderer->GetStats().StallTime + s_Data.CircleRenderer->GetStats().StallTime +
+			   s_Data.QuadInstanceRenderer->GetStats().StallTime + s_Data.CircleInstanceRenderer->GetStats().StallTime;
+	}
+
+	BatchBreaks Renderer::GetBatchBreaks()
+	{
+		std::array<uint32_t, (size_t)BatchBreakReason::Count> total = {};
+		for (size_t i = 0; i < total.size(); i++)
+		{
+			total[i] = s_Data.QuadRenderer->GetStats().Breaks[i] + s_Data.CircleRenderer->GetStats().Breaks[i] +
+					   s_Data.QuadInstanceRenderer->GetStats().Breaks[i] + s_Data.CircleInstanceRenderer->GetStats().Breaks[i];
+		}
+
+		BatchBreaks breaks;
+		breaks.BatchFull = total[(size_t)BatchBreakReason::BatchFull];
+		breaks.TextureSlotsFull = total[(size_t)BatchBreakReason::TextureSlotsFull];
+		breaks.Reserve = total[(size_t)BatchBreakReason::Reserve];
+		return breaks;
+	}
+
+	void Renderer::RecordCulling(uint32_t visible, uint32_t culled)
+	{
+		s_Data.Culling.Visible += visible;
+		s_Data.Culling.Culled += culled;
+	}
+
+	CullingStats Renderer::GetCullingStats()
+	{
+		return s_Data.Culling;
 	}
 
 	void Renderer::ResetStats()
 	{
+		s_Data.Culling = {};
 		s_Data.QuadRenderer->ResetStats();
 		s_Data.CircleRenderer->ResetStats();
+		s_Data.QuadInstanceRenderer->ResetStats();
+		s_Data.CircleInstanceRenderer->ResetStats();
 	}
 }
\ No newline at end of file
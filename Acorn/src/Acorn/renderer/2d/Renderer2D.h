@@ -1,5 +1,6 @@
 #pragma once
 
+#include "renderer/Buffer.h"
 #include "renderer/Camera.h"
 #include "renderer/EditorCamera.h"
 #include "renderer/Texture.h"
@@ -8,18 +9,99 @@
 
 #include "SubTexture2d.h"
 
+#include <functional>
+
 namespace Acorn::ext2d //Extension 2d
 {
+	enum class SubmissionMode : uint8_t
+	{
+		// Draws go straight into the batches in call order
+		Immediate = 0,
+		// Draws are recorded and sorted by layer at EndScene, then as the LayerOrder of each layer asks
+		Sorted,
+	};
+
+	enum class LayerOrder : uint8_t
+	{
+		// Back to front across all textures, so translucent draws blend over everything behind them
+		BackToFront = 0,
+		// By shader and texture, then back to front, so textures only get rebound when needed
+		ByTexture,
+	};
+
+	enum class GeometryMode : uint8_t
+	{
+		// Every quad is expanded to 4 vertices on the CPU
+		Vertices = 0,
+		// One record per quad, the vertex shader expands the corners
+		Instanced,
+	};
+
+	struct RendererSpecs
+	{
+		// How the quad and circle batches are streamed to the GPU
+		BufferStreamingMode VertexStreaming = BufferStreamingMode::PersistentMapped;
+		SubmissionMode Submission = SubmissionMode::Immediate;
+		GeometryMode Geometry = GeometryMode::Vertices;
+	};
+
+	// Number of batches that had to be flushed before EndScene, by reason
+	struct BatchBreaks
+	{
+		uint32_t BatchFull = 0;
+		uint32_t TextureSlotsFull = 0;
+		uint32_t Reserve = 0;
+	};
+
+	// Sprites and circles a scene handed to the renderer or left out, because they were outside the view
+	struct CullingStats
+	{
+		uint32_t Visible = 0;
+		uint32_t Culled = 0;
+	};
+
+	struct SpriteDrawData
+	{
+		glm::mat4 Transform;
+		const Components::SpriteRenderer* Sprite;
+		int EntityId;
+	};
+
 	class Renderer
 	{
 	public:
-		static void Init();
+		static void Init(const RendererSpecs& specs = RendererSpecs());
 		static void ShutDown();
 
 		static void BeginScene(const EditorCamera& camera);
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void EndScene();
 
+		/**
+		 * @brief Fence the streamed vertex data of all scenes drawn this frame, called by the application once per frame.
+		 */
+		static void EndFrame();
+
+		/**
+		 * @brief Switch between immediate and sorted submission, has to be called outside of BeginScene/EndScene.
+		 */
+		static void SetSubmissionMode(SubmissionMode mode);
+		static SubmissionMode GetSubmissionMode();
+
+		/**
+		 * @brief Switch between CPU expanded and instanced quads and circles, has to be called outside of BeginScene/EndScene.
+		 */
+		static void SetGeometryMode(GeometryMode mode);
+		static GeometryMode GetGeometryMode();
+
+		/**
+		 * @brief Layer of the following draws, lower layers are drawn first. Only used by SubmissionMode::Sorted, reset by BeginScene.
+		 *
+		 * @param order
+		 *  LayerOrder::ByTexture batches better, but only layers of opaque draws should use it. All draws of a layer have to use the same order.
+		 */
+		static void SetLayer(uint8_t layer, LayerOrder order = LayerOrder::BackToFront);
+
 		//==========
 		//Primitives
 		//==========
@@ -59,6 +141,16 @@ namespace Acorn::ext2d //Extension 2d
 		//Sprites
 		static void DrawSprite(const glm::mat4& transform, Components::SpriteRenderer& sprite, int entityId);
 
+		/**
+		 * @brief Draw count sprites, generating their geometry on the engine thread pool.
+		 *
+		 * Every thread fills its own slice of the frame's geometry, the slices are handed to the batches in index order afterwards.
+		 *
+		 * @param getSprite
+		 *  Called concurrently for disjoint indices in [0, count), must only read shared state.
+		 */
+		static void DrawSprites(uint32_t count, const std::function<SpriteDrawData(uint32_t index)>& getSprite);
+
 		//Circles
 		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityId = -1);
 
@@ -68,6 +160,11 @@ namespace Acorn::ext2d //Extension 2d
 		static uint32_t GetQuadCount();
 		static uint32_t GetVertexCount();
 		static uint32_t GetIndexCount();
+		// Milliseconds spent waiting for the GPU to release vertex memory
+		static float GetStallTime();
+		static BatchBreaks GetBatchBreaks();
+		static void RecordCulling(uint32_t visible, uint32_t culled);
+		static CullingStats GetCullingStats();
 		static void ResetStats();
 
 	private:
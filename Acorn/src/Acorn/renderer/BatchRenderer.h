@@ -7,10 +7,29 @@
 #include "renderer/VertexArray.h"
 #include "utils/PlatformCapabilities.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace Acorn
 {
+	/**
+	 * @brief Why a batch had to be flushed before the end of the scene.
+	 */
+	enum class BatchBreakReason : uint8_t
+	{
+		// All MAX_BATCH_SIZE objects are used
+		BatchFull = 0,
+		// Every texture slot is bound to a different texture
+		TextureSlotsFull,
+		// Reserve() asked for more objects than were left
+		Reserve,
+		Count,
+	};
+
 	template <typename Vertex, size_t IndicesPerObject, size_t VerticesPerObject, bool DrawLines = false>
 	class BatchRenderer
 	{
@@ -19,13 +38,16 @@ namespace Acorn
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t ObjectCount = 0;
+			// Milliseconds spent waiting for the GPU to release vertex memory
+			float StallTime = 0.0f;
+			std::array<uint32_t, (size_t)BatchBreakReason::Count> Breaks = {};
 
 			uint32_t GetTotalVertexCount() const { return ObjectCount * VerticesPerObject; }
 			uint32_t GetTotalIndexCount() const { return ObjectCount * IndicesPerObject; }
 		};
 
 	public:
-		BatchRenderer(const Ref<Shader>& shader, const std::array<uint32_t, IndicesPerObject>& indices, const BufferLayout& layout)
+		BatchRenderer(const Ref<Shader>& shader, const std::array<uint32_t, IndicesPerObject>& indices, const BufferLayout& layout, BufferStreamingMode streamingMode = BufferStreamingMode::SubData)
 			: m_Shader(shader)
 		{
 			m_TextureSlots.resize(PlatformCapabilities::GetMaxTextureUnits());
@@ -33,17 +55,23 @@ namespace Acorn
 			//Setup vertex array
 			m_VertexArray = VertexArray::Create();
 
-			m_VertexBuffer = VertexBuffer::Create(MAX_BATCH_SIZE * VerticesPerObject * sizeof(Vertex));
+			m_VertexBuffer = StreamingVertexBuffer::Create(MAX_BATCH_SIZE * VerticesPerObject * sizeof(Vertex), streamingMode);
 			m_VertexBuffer->SetLayout(layout);
 
 			m_VertexArray->AddVertexBuffer(m_VertexBuffer);
 
-			m_VertexBufferBase = new Vertex[MAX_BATCH_SIZE * IndicesPerObject];
+			// Mapped buffers get written directly, everything else needs a CPU side copy to upload from
+			if (m_VertexBuffer->GetMode() != BufferStreamingMode::PersistentMapped)
+			{
+				m_StagingBuffer = new Vertex[MAX_BATCH_SIZE * VerticesPerObject];
+			}
+			m_VertexBufferBase = AcquireVertexMemory();
+			m_VertexBufferPtr = m_VertexBufferBase;
 
 			//Setup index buffer
 			uint32_t* bufferIndices = new uint32_t[MAX_BATCH_SIZE * IndicesPerObject];
 			uint32_t offset = 0;
-			for (size_t i = 0; i < MAX_BATCH_SIZE; i += indices.size())
+			for (size_t i = 0; i < MAX_BATCH_SIZE * IndicesPerObject; i += indices.size())
 			{
 				for (size_t j = 0; j < indices.size(); j++)
 				{
@@ -72,7 +100,7 @@ namespace Acorn
 
 		~BatchRenderer()
 		{
-			delete[] m_VertexBufferBase;
+			delete[] m_StagingBuffer;
 		}
 
 		void Begin()
@@ -83,22 +111,33 @@ namespace Acorn
 
 			m_TextureSlotIndex = m_MinTextureSlotIndex;
 			m_IndexCount = 0;
+			m_VertexBufferBase = AcquireVertexMemory();
 			m_VertexBufferPtr = m_VertexBufferBase;
+
+			m_LastTexture = nullptr;
 		}
 
 		void End()
 		{
+			// Nothing to draw, a zero count would draw the whole index buffer
+			if (m_IndexCount == 0)
+				return;
+
 			m_Shader->Bind();
 			m_VertexArray->Bind();
 			// uint32_t size = (uint32_t)((uint8_t*)m_VertexBufferPtr - (uint8_t*)m_VertexBufferBase);
 			uint32_t size = (m_IndexCount / IndicesPerObject) * VerticesPerObject * sizeof(Vertex);
-			m_VertexBuffer->SetData(m_VertexBufferBase, size);
+			uint32_t offset = m_VertexBuffer->Commit(m_VertexBufferBase, size);
 
-			Flush();
+			Flush(offset / sizeof(Vertex));
+			m_VertexBuffer->Advance();
 			m_VertexArray->Unbind();
+
+			m_Statistics.StallTime += m_VertexBuffer->GetStallTime();
+			m_VertexBuffer->ResetStallTime();
 		}
 
-		void Flush()
+		void Flush(uint32_t baseVertex = 0)
 		{
 			for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
 			{
@@ -108,20 +147,51 @@ namespace Acorn
 			m_Shader->Bind();
 			m_VertexArray->Bind();
 			if constexpr (DrawLines)
-				RenderCommand::DrawLines(m_VertexArray, m_IndexCount);
+				RenderCommand::DrawLines(m_VertexArray, m_IndexCount, baseVertex);
 			else
-				RenderCommand::DrawIndexed(m_VertexArray, m_IndexCount);
+				RenderCommand::DrawIndexed(m_VertexArray, m_IndexCount, baseVertex);
 
 			m_Statistics.DrawCalls++;
 		}
 
-		void FlushAndReset()
+		/**
+		 * @brief Hand the batches of this frame over to the GPU, has to be called once per frame after End().
+		 */
+		void EndFrame()
 		{
+			m_VertexBuffer->EndFrame();
+		}
+
+		void FlushAndReset(BatchBreakReason reason)
+		{
+			m_Statistics.Breaks[(size_t)reason]++;
+
 			End();
 			m_IndexCount = 0;
+			m_VertexBufferBase = AcquireVertexMemory();
 			m_VertexBufferPtr = m_VertexBufferBase;
 
 			m_TextureSlotIndex = m_MinTextureSlotIndex;
+			m_LastTexture = nullptr;
+		}
+
+		/**
+		 * @brief Make sure the next objectCount objects fit into the current batch without flushing in between.
+		 *
+		 * @param objectCount
+		 *  Number of objects that are about to be drawn. Requests bigger than the batch size only guarantee an empty batch.
+		 */
+		void Reserve(uint32_t objectCount)
+		{
+			if (objectCount > GetRemainingObjects())
+			{
+				FlushAndReset(BatchBreakReason::Reserve);
+			}
+		}
+
+		inline uint32_t GetRemainingObjects() const
+		{
+			return MAX_BATCH_SIZE - m_IndexCount / IndicesPerObject;
 		}
 
 		void AddDefaultTexture(const Ref<Texture2d>& texture)
@@ -133,9 +203,9 @@ namespace Acorn
 
 		void Draw(const std::array<Vertex, VerticesPerObject>& vertices)
 		{
-			if (m_IndexCount > MAX_BATCH_SIZE * IndicesPerObject)
+			if (m_IndexCount >= MAX_BATCH_SIZE * IndicesPerObject)
 			{
-				FlushAndReset();
+				FlushAndReset(BatchBreakReason::BatchFull);
 			}
 
 			for (size_t i = 0; i < vertices.size(); i++)
@@ -150,9 +220,9 @@ namespace Acorn
 
 		void Draw(uint32_t textureIndex, const std::array<Vertex, VerticesPerObject>& vertices)
 		{
-			if (m_IndexCount > MAX_BATCH_SIZE * IndicesPerObject)
+			if (m_IndexCount >= MAX_BATCH_SIZE * IndicesPerObject)
 			{
-				FlushAndReset();
+				FlushAndReset(BatchBreakReason::BatchFull);
 			}
 
 			AC_CORE_ASSERT(textureIndex < m_MinTextureSlotIndex, "Texture index is out of range!");
@@ -170,31 +240,12 @@ namespace Acorn
 		//TODO template check for Vertex.TexIndex
 		void Draw(const Ref<Texture2d>& texture, const std::array<Vertex, VerticesPerObject>& vertices)
 		{
-			if (m_IndexCount > MAX_BATCH_SIZE * IndicesPerObject)
+			if (m_IndexCount >= MAX_BATCH_SIZE * IndicesPerObject)
 			{
-				FlushAndReset();
+				FlushAndReset(BatchBreakReason::BatchFull);
 			}
 
-			float textureIndex = -1.0f;
-			for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
-			{
-				if (m_TextureSlots[i] == texture)
-				{
-					textureIndex = (float)i;
-					break;
-				}
-			}
-
-			if (textureIndex == -1.0f)
-			{
-				if (m_TextureSlotIndex >= m_TextureSlots.size())
-				{
-					FlushAndReset();
-				}
-				m_TextureSlots[m_TextureSlotIndex] = texture;
-				textureIndex = (float)m_TextureSlotIndex;
-				m_TextureSlotIndex++;
-			}
+			float textureIndex = GetTextureIndex(texture);
 
 			for (uint32_t i = 0; i < VerticesPerObject; i++)
 			{
@@ -208,6 +259,86 @@ namespace Acorn
 			m_Statistics.ObjectCount++;
 		}
 
+		/**
+		 * @brief Copy a contiguous run of objects into the batch.
+		 *
+		 * The vertices are block copied, the batch only gets checked for overflow once per (partial) run.
+		 *
+		 * @param vertices
+		 *  VerticesPerObject vertices for every object, in draw order.
+		 */
+		void DrawBatch(std::span<const Vertex> vertices)
+		{
+			AC_PROFILE_FUNCTION();
+			static_assert(std::is_trivially_copyable_v<Vertex>, "DrawBatch requires a trivially copyable vertex type!");
+			AC_CORE_ASSERT(vertices.size() % VerticesPerObject == 0, "Vertex count has to be a multiple of VerticesPerObject!");
+
+			const Vertex* source = vertices.data();
+			uint32_t objectsLeft = (uint32_t)(vertices.size() / VerticesPerObject);
+
+			while (objectsLeft > 0)
+			{
+				if (GetRemainingObjects() == 0)
+				{
+					FlushAndReset(BatchBreakReason::BatchFull);
+				}
+
+				uint32_t objectCount = std::min(objectsLeft, GetRemainingObjects());
+				uint32_t vertexCount = objectCount * VerticesPerObject;
+
+				std::memcpy(m_VertexBufferPtr, source, vertexCount * sizeof(Vertex));
+
+				m_VertexBufferPtr += vertexCount;
+				source += vertexCount;
+				objectsLeft -= objectCount;
+
+				m_IndexCount += objectCount * IndicesPerObject;
+				m_Statistics.ObjectCount += objectCount;
+			}
+		}
+
+		/**
+		 * @brief Copy a contiguous run of objects sharing one texture into the batch.
+		 *
+		 * Same as DrawBatch(vertices), but the texture slot is only resolved once per (partial) run and written into every vertex.
+		 */
+		void DrawBatch(std::span<const Vertex> vertices, const Ref<Texture2d>& texture)
+		{
+			AC_PROFILE_FUNCTION();
+			static_assert(std::is_trivially_copyable_v<Vertex>, "DrawBatch requires a trivially copyable vertex type!");
+			AC_CORE_ASSERT(vertices.size() % VerticesPerObject == 0, "Vertex count has to be a multiple of VerticesPerObject!");
+
+			const Vertex* source = vertices.data();
+			uint32_t objectsLeft = (uint32_t)(vertices.size() / VerticesPerObject);
+
+			while (objectsLeft > 0)
+			{
+				if (GetRemainingObjects() == 0)
+				{
+					FlushAndReset(BatchBreakReason::BatchFull);
+				}
+
+				// Has to be resolved after the flush, since flushing resets the texture slots
+				float textureIndex = GetTextureIndex(texture);
+
+				uint32_t objectCount = std::min(objectsLeft, GetRemainingObjects());
+				uint32_t vertexCount = objectCount * VerticesPerObject;
+
+				std::memcpy(m_VertexBufferPtr, source, vertexCount * sizeof(Vertex));
+				for (uint32_t i = 0; i < vertexCount; i++)
+				{
+					m_VertexBufferPtr[i].TexIndex = textureIndex;
+				}
+
+				m_VertexBufferPtr += vertexCount;
+				source += vertexCount;
+				objectsLeft -= objectCount;
+
+				m_IndexCount += objectCount * IndicesPerObject;
+				m_Statistics.ObjectCount += objectCount;
+			}
+		}
+
 		Ref<Shader> GetShader()
 		{
 			return m_Shader;
@@ -217,11 +348,65 @@ namespace Acorn
 		{
 			return m_Statistics;
 		}
+
+		BufferStreamingMode GetStreamingMode() const
+		{
+			return m_VertexBuffer->GetMode();
+		}
+
 		void ResetStats()
 		{
 			memset(&m_Statistics, 0, sizeof(Statistics));
 		}
 
+	private:
+		/**
+		 * @brief Get the memory the next batch gets written to, either the mapped region of the vertex buffer or the staging buffer.
+		 */
+		Vertex* AcquireVertexMemory()
+		{
+			void* mapped = m_VertexBuffer->Acquire();
+			return mapped ? (Vertex*)mapped : m_StagingBuffer;
+		}
+
+		/**
+		 * @brief Find the slot of texture in the current batch, or bind it to a new one (flushing if all slots are taken).
+		 */
+		float GetTextureIndex(const Ref<Texture2d>& texture)
+		{
+			// Consecutive draws mostly share a texture, so skip the slot search for those
+			if (m_LastTexture == texture.get())
+			{
+				return m_LastTextureIndex;
+			}
+
+			float textureIndex = -1.0f;
+			for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
+			{
+				if (m_TextureSlots[i] == texture)
+				{
+					textureIndex = (float)i;
+					break;
+				}
+			}
+
+			if (textureIndex == -1.0f)
+			{
+				if (m_TextureSlotIndex >= m_TextureSlots.size())
+				{
+					FlushAndReset(BatchBreakReason::TextureSlotsFull);
+				}
+				m_TextureSlots[m_TextureSlotIndex] = texture;
+				textureIndex = (float)m_TextureSlotIndex;
+				m_TextureSlotIndex++;
+			}
+
+			m_LastTexture = texture.get();
+			m_LastTextureIndex = textureIndex;
+
+			return textureIndex;
+		}
+
 	private:
 		static constexpr uint32_t MAX_BATCH_SIZE = 10000;
 
@@ -230,12 +415,16 @@ namespace Acorn
 
 		uint32_t m_MinTextureSlotIndex = 0;
 
+		Vertex* m_StagingBuffer = nullptr;
 		Vertex* m_VertexBufferBase = nullptr;
 		Vertex* m_VertexBufferPtr = nullptr;
 		std::vector<Ref<Texture2d>> m_TextureSlots;
 
+		const Texture2d* m_LastTexture = nullptr;
+		float m_LastTextureIndex = 0.0f;
+
 		Ref<VertexArray> m_VertexArray;
-		Ref<VertexBuffer> m_VertexBuffer;
+		Ref<StreamingVertexBuffer> m_VertexBuffer;
 		Ref<Shader> m_Shader;
 
 		Statistics m_Statistics;
@@ -38,6 +38,21 @@ namespace Acorn
 		}
 	}
 
+	Ref<StreamingVertexBuffer> StreamingVertexBuffer::Create(uint32_t batchSize, BufferStreamingMode mode)
+	{
+		switch (Renderer::GetApi())
+		{
+			case RendererApi::Api::None:
+				AC_CORE_ASSERT(false, "RendererAPI::None Not implemented yet!");
+				return nullptr;
+			case RendererApi::Api::OpenGL:
+				return CreateRef<OpenGLStreamingVertexBuffer>(batchSize, mode);
+			default:
+				AC_CORE_ASSERT(false, "Not implemented yet!");
+				return nullptr;
+		}
+	}
+
 	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count)
 	{
 		switch (Renderer::GetApi())
@@ -116,8 +116,19 @@ namespace Acorn
 			CalculateOffsetsAndStride();
 		}
 
+		/**
+		 * @param perInstance
+		 *  Advance the attributes once per instance instead of once per vertex.
+		 */
+		BufferLayout(const std::initializer_list<BufferElement>& elements, bool perInstance)
+			: m_Elements(elements), m_PerInstance(perInstance)
+		{
+			CalculateOffsetsAndStride();
+		}
+
 		inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 		inline uint32_t GetStride() const { return m_Stride; }
+		inline bool IsPerInstance() const { return m_PerInstance; }
 
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
 		std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
@@ -138,6 +149,7 @@ namespace Acorn
 	private:
 		std::vector<BufferElement> m_Elements;
 		uint32_t m_Stride = 0;
+		bool m_PerInstance = false;
 	};
 
 	class VertexBuffer
@@ -159,6 +171,79 @@ namespace Acorn
 		static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
 	};
 
+	/**
+	 * @brief How a StreamingVertexBuffer gets its per frame data to the GPU.
+	 */
+	enum class BufferStreamingMode : uint8_t
+	{
+		/// glBufferSubData into a single buffer, may stall while the GPU still reads the last batch
+		SubData = 0,
+		/// Reallocate (orphan) the storage before every upload, so the driver can hand out fresh memory
+		Orphaning,
+		/// Write straight into a persistently mapped buffer split into fenced regions, falls back to Orphaning if unsupported
+		PersistentMapped,
+	};
+
+	/**
+	 * @brief Vertex buffer for data that gets rewritten every batch.
+	 *
+	 * A batch is written into the memory returned by Acquire(), published with Commit() and,
+	 * once the draw calls reading it are issued, retired with Advance().
+	 * The batches of a frame share one region, EndFrame() hands the region over to the GPU.
+	 * GetData()/GetDataPtr() return the memory of the current batch if the buffer is persistently mapped, nullptr otherwise.
+	 */
+	class StreamingVertexBuffer : public VertexBuffer
+	{
+	public:
+		static constexpr uint32_t RegionCount = 3;
+		// Full size batches a region holds before a frame has to spill into the next one
+		static constexpr uint32_t BatchesPerRegion = 4;
+
+	public:
+		virtual ~StreamingVertexBuffer() {}
+
+		/**
+		 * @brief Get the memory the next batch can be written to directly.
+		 *
+		 * Blocks until the GPU finished reading the region.
+		 *
+		 * @return Pointer to at least batchSize writable bytes, or nullptr if the buffer can't be written directly
+		 */
+		virtual void* Acquire() = 0;
+
+		/**
+		 * @brief Publish the next batch.
+		 *
+		 * @param data
+		 *  The memory returned by Acquire(), or the batch itself if Acquire() returned nullptr.
+		 * @param size
+		 *  Size of the batch in bytes, at most batchSize.
+		 *
+		 * @return Byte offset of the batch inside the buffer
+		 */
+		virtual uint32_t Commit(const void* data, uint32_t size) = 0;
+
+		/**
+		 * @brief Retire the current batch, has to be called after the draw calls using it were issued.
+		 */
+		virtual void Advance() = 0;
+
+		/**
+		 * @brief Fence the batches written this frame, the next Acquire() continues in the next region.
+		 */
+		virtual void EndFrame() = 0;
+
+		virtual BufferStreamingMode GetMode() const = 0;
+
+		/**
+		 * @brief Time in milliseconds spent waiting on the GPU since the last ResetStallTime().
+		 */
+		virtual float GetStallTime() const = 0;
+		virtual void ResetStallTime() = 0;
+
+		static Ref<StreamingVertexBuffer> Create(uint32_t batchSize, BufferStreamingMode mode);
+	};
+
 	class IndexBuffer
 	{
 	public:
@@ -239,11 +239,11 @@ namespace Acorn
 			s_Data.QuadRenderer->Draw(0, vertices);
 		}
 
-		void Renderer::DrawCameraFrustum(const Components::CameraComponent& camera, const Components::Transform& transform)
+		void Renderer::DrawCameraFrustum(const Components::CameraComponent& camera, const glm::mat4& transform)
 		{
 			if (camera.Camera.GetProjectionType() == SceneCamera::ProjectionType::Perspective)
 			{
-				glm::mat4 cameraToWorld = camera.Camera.GetProjection() * glm::inverse(transform.GetTransform());
+				glm::mat4 cameraToWorld = camera.Camera.GetProjection() * glm::inverse(transform);
 				glm::vec3 axisX = cameraToWorld[0];
 				glm::vec3 axisY = cameraToWorld[1];
 				glm::vec3 axisZ = cameraToWorld[2];
@@ -273,7 +273,7 @@ namespace Acorn
 
 				for (size_t i = 0; i < 8; i++)
 				{
-					v[i] = v[i] + transform.Translation;
+					v[i] = v[i] + glm::vec3(transform[3]);
 				}
 
 				DrawLine(v[0], v[1]);
@@ -291,15 +291,15 @@ namespace Acorn
 			}
 		}
 
-		void Renderer::DrawB2dCollider(const Components::BoxCollider2d& collider, const Components::Transform& transform)
+		void Renderer::DrawB2dCollider(const Components::BoxCollider2d& collider, const glm::mat4& transform)
 		{
 			// This makes sure the collider is offset AND at z=0
-			glm::vec4 offset = glm::vec4(collider.GetOffset(), -transform.Translation.z, 0.0f);
+			glm::vec4 offset = glm::vec4(collider.GetOffset(), -transform[3].z, 0.0f);
 
-			glm::vec3 tl = ((glm::mat4)transform) * (glm::vec4{-collider.GetSize(), 0.0f, 1.0f} + offset);
-			glm::vec3 tr = ((glm::mat4)transform) * (glm::vec4{collider.GetSize().x, -collider.GetSize().y, 0.0f, 1.0f} + offset);
-			glm::vec3 bl = ((glm::mat4)transform) * (glm::vec4{-collider.GetSize().x, collider.GetSize().y, 0.0f, 1.0f} + offset);
-			glm::vec3 br = ((glm::mat4)transform) * (glm::vec4{collider.GetSize(), 0.0f, 1.0f} + offset);
+			glm::vec3 tl = transform * (glm::vec4{-collider.GetSize(), 0.0f, 1.0f} + offset);
+			glm::vec3 tr = transform * (glm::vec4{collider.GetSize().x, -collider.GetSize().y, 0.0f, 1.0f} + offset);
+			glm::vec3 bl = transform * (glm::vec4{-collider.GetSize().x, collider.GetSize().y, 0.0f, 1.0f} + offset);
+			glm::vec3 br = transform * (glm::vec4{collider.GetSize(), 0.0f, 1.0f} + offset);
 
 			constexpr glm::vec4 color{0.0f, 0.0f, 1.0f, 1.0f};
 
@@ -310,17 +310,20 @@ namespace Acorn
 			DrawLine(tl, br, color);
 		}
 
-		void Renderer::DrawB2dCollider(const Components::CircleCollider2d& collider, const Components::Transform& transform)
+		void Renderer::DrawB2dCollider(const Components::CircleCollider2d& collider, const glm::mat4& transform)
 		{
 			AC_PROFILE_FUNCTION();
 
+			glm::vec3 translation = transform[3];
+			glm::vec3 scale = {glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))};
+
 			constexpr size_t quadVertexCount = 4;
 			constexpr glm::vec4 color{0.0f, 0.0f, 1.0f, 1.0f};
 
 			std::array<CircleVertex, quadVertexCount> vertices;
 
 			// TODO think about scaling axis...
-			glm::mat4 trans = transform.GetTransform() * glm::scale(glm::mat4{1.0f}, (1.0f / transform.Scale)) * glm::scale(glm::mat4{1.0f}, glm::vec3(transform.Scale.z * collider.GetRadius() * 2)) * glm::translate(glm::mat4{1.0f}, glm::vec3(collider.GetOffset(), 0.0f));
+			glm::mat4 trans = transform * glm::scale(glm::mat4{1.0f}, (1.0f / scale)) * glm::scale(glm::mat4{1.0f}, glm::vec3(scale.z * collider.GetRadius() * 2)) * glm::translate(glm::mat4{1.0f}, glm::vec3(collider.GetOffset(), 0.0f));
 
 			for (size_t i = 0; i < quadVertexCount; i++)
 			{
@@ -337,9 +340,9 @@ namespace Acorn
 
 			constexpr float unit = 0.70710678118f; // == sqrt(2) / 2;
 
-			float r = collider.GetRadius() * transform.Scale.z;
-			glm::vec3 tl = transform.Translation + glm::vec3{-unit * r, unit * r, 0.0f} + glm::vec3(collider.GetOffset(), 0.0f);
-			glm::vec3 tr = transform.Translation + glm::vec3{unit * r, -unit * r, 0.0f} + glm::vec3(collider.GetOffset(), 0.0f);
+			float r = collider.GetRadius() * scale.z;
+			glm::vec3 tl = translation + glm::vec3{-unit * r, unit * r, 0.0f} + glm::vec3(collider.GetOffset(), 0.0f);
+			glm::vec3 tr = translation + glm::vec3{unit * r, -unit * r, 0.0f} + glm::vec3(collider.GetOffset(), 0.0f);
 
 			DrawLine(tl, tr, color);
 		}
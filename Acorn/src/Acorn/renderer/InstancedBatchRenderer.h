@@ -0,0 +1,263 @@
+#pragma once
+
+#include "RenderCommand.h"
+#include "core/Core.h"
+#include "renderer/BatchRenderer.h"
+#include "renderer/Shader.h"
+#include "renderer/Texture.h"
+#include "renderer/VertexArray.h"
+#include "utils/PlatformCapabilities.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace Acorn
+{
+	/**
+	 * @brief Batches one record per quad and lets the vertex shader expand the corners.
+	 *
+	 * Every instance is drawn on a shared unit quad, which provides
+	 * a_Corner (vec2, -0.5 to 0.5) and a_CornerTexCoord (vec2, 0 to 1) at locations 0 and 1.
+	 * The instance attributes follow from location 2 on.
+	 */
+	template <typename Instance>
+	class InstancedBatchRenderer
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t ObjectCount = 0;
+			// Milliseconds spent waiting for the GPU to release instance memory
+			float StallTime = 0.0f;
+			std::array<uint32_t, (size_t)BatchBreakReason::Count> Breaks = {};
+		};
+
+	public:
+		InstancedBatchRenderer(const Ref<Shader>& shader, const BufferLayout& instanceLayout, BufferStreamingMode streamingMode = BufferStreamingMode::SubData)
+			: m_Shader(shader)
+		{
+			AC_CORE_ASSERT(instanceLayout.IsPerInstance(), "Instance layout has to be per instance!");
+			AC_CORE_ASSERT(instanceLayout.GetStride() == sizeof(Instance), "Instance layout does not match the instance type!");
+
+			m_TextureSlots.resize(PlatformCapabilities::GetMaxTextureUnits());
+
+			m_VertexArray = VertexArray::Create();
+
+			float corners[] = {
+				-0.5f, -0.5f, 0.0f, 0.0f,
+				0.5f, -0.5f, 1.0f, 0.0f,
+				0.5f, 0.5f, 1.0f, 1.0f,
+				-0.5f, 0.5f, 0.0f, 1.0f};
+
+			Ref<VertexBuffer> cornerBuffer = VertexBuffer::Create(corners, sizeof(corners));
+			cornerBuffer->SetLayout({
+				{ShaderDataType::Float2, "a_Corner"},
+				{ShaderDataType::Float2, "a_CornerTexCoord"},
+			});
+			m_VertexArray->AddVertexBuffer(cornerBuffer);
+
+			m_InstanceBuffer = StreamingVertexBuffer::Create(MAX_BATCH_SIZE * sizeof(Instance), streamingMode);
+			m_InstanceBuffer->SetLayout(instanceLayout);
+			m_VertexArray->AddVertexBuffer(m_InstanceBuffer);
+
+			if (m_InstanceBuffer->GetMode() != BufferStreamingMode::PersistentMapped)
+			{
+				m_StagingBuffer = new Instance[MAX_BATCH_SIZE];
+			}
+			m_InstanceBufferBase = AcquireInstanceMemory();
+			m_InstanceBufferPtr = m_InstanceBufferBase;
+
+			uint32_t indices[] = {0, 1, 2, 2, 3, 0};
+			m_VertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+
+			uint32_t maxTextureSlots = PlatformCapabilities::GetMaxTextureUnits();
+			int32_t* samplers = new int32_t[maxTextureSlots];
+			for (uint32_t i = 0; i < maxTextureSlots; i++)
+			{
+				samplers[i] = i;
+			}
+
+			m_Shader->Bind();
+			m_Shader->SetIntArray("u_Textures[0]", samplers, maxTextureSlots);
+			m_Shader->Unbind();
+			delete[] samplers;
+		}
+
+		~InstancedBatchRenderer()
+		{
+			delete[] m_StagingBuffer;
+		}
+
+		void Begin()
+		{
+			m_TextureSlotIndex = m_MinTextureSlotIndex;
+			m_InstanceCount = 0;
+			m_InstanceBufferBase = AcquireInstanceMemory();
+			m_InstanceBufferPtr = m_InstanceBufferBase;
+
+			m_LastTexture = nullptr;
+		}
+
+		void End()
+		{
+			if (m_InstanceCount == 0)
+				return;
+
+			uint32_t offset = m_InstanceBuffer->Commit(m_InstanceBufferBase, m_InstanceCount * sizeof(Instance));
+
+			for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
+			{
+				m_TextureSlots[i]->Bind(i);
+			}
+
+			m_Shader->Bind();
+			m_VertexArray->Bind();
+			RenderCommand::DrawIndexedInstanced(m_VertexArray, 6, m_InstanceCount, offset / sizeof(Instance));
+			m_InstanceBuffer->Advance();
+			m_VertexArray->Unbind();
+
+			m_Statistics.DrawCalls++;
+			m_Statistics.StallTime += m_InstanceBuffer->GetStallTime();
+			m_InstanceBuffer->ResetStallTime();
+		}
+
+		/**
+		 * @brief Hand the batches of this frame over to the GPU, has to be called once per frame after End().
+		 */
+		void EndFrame()
+		{
+			m_InstanceBuffer->EndFrame();
+		}
+
+		void FlushAndReset(BatchBreakReason reason)
+		{
+			m_Statistics.Breaks[(size_t)reason]++;
+
+			End();
+			m_InstanceCount = 0;
+			m_InstanceBufferBase = AcquireInstanceMemory();
+			m_InstanceBufferPtr = m_InstanceBufferBase;
+
+			m_TextureSlotIndex = m_MinTextureSlotIndex;
+			m_LastTexture = nullptr;
+		}
+
+		void AddDefaultTexture(const Ref<Texture2d>& texture)
+		{
+			m_TextureSlots[m_TextureSlotIndex] = texture;
+			m_TextureSlotIndex++;
+			m_MinTextureSlotIndex++;
+		}
+
+		void Draw(const Instance& instance)
+		{
+			if (m_InstanceCount >= MAX_BATCH_SIZE)
+			{
+				FlushAndReset(BatchBreakReason::BatchFull);
+			}
+
+			*m_InstanceBufferPtr = instance;
+			m_InstanceBufferPtr++;
+
+			m_InstanceCount++;
+			m_Statistics.ObjectCount++;
+		}
+
+		void Draw(const Ref<Texture2d>& texture, const Instance& instance)
+		{
+			if (m_InstanceCount >= MAX_BATCH_SIZE)
+			{
+				FlushAndReset(BatchBreakReason::BatchFull);
+			}
+
+			float textureIndex = GetTextureIndex(texture);
+
+			*m_InstanceBufferPtr = instance;
+			m_InstanceBufferPtr->TexIndex = textureIndex;
+			m_InstanceBufferPtr++;
+
+			m_InstanceCount++;
+			m_Statistics.ObjectCount++;
+		}
+
+		Ref<Shader> GetShader()
+		{
+			return m_Shader;
+		}
+
+		Statistics GetStats()
+		{
+			return m_Statistics;
+		}
+
+		void ResetStats()
+		{
+			m_Statistics = Statistics();
+		}
+
+	private:
+		Instance* AcquireInstanceMemory()
+		{
+			void* mapped = m_InstanceBuffer->Acquire();
+			return mapped ? (Instance*)mapped : m_StagingBuffer;
+		}
+
+		float GetTextureIndex(const Ref<Texture2d>& texture)
+		{
+			if (m_LastTexture == texture.get())
+			{
+				return m_LastTextureIndex;
+			}
+
+			float textureIndex = -1.0f;
+			for (uint32_t i = 0; i < m_TextureSlotIndex; i++)
+			{
+				if (m_TextureSlots[i] == texture)
+				{
+					textureIndex = (float)i;
+					break;
+				}
+			}
+
+			if (textureIndex == -1.0f)
+			{
+				if (m_TextureSlotIndex >= m_TextureSlots.size())
+				{
+					FlushAndReset(BatchBreakReason::TextureSlotsFull);
+				}
+				m_TextureSlots[m_TextureSlotIndex] = texture;
+				textureIndex = (float)m_TextureSlotIndex;
+				m_TextureSlotIndex++;
+			}
+
+			m_LastTexture = texture.get();
+			m_LastTextureIndex = textureIndex;
+
+			return textureIndex;
+		}
+
+	private:
+		static constexpr uint32_t MAX_BATCH_SIZE = 10000;
+
+		uint32_t m_InstanceCount = 0;
+		uint32_t m_TextureSlotIndex = 0;
+
+		uint32_t m_MinTextureSlotIndex = 0;
+
+		Instance* m_StagingBuffer = nullptr;
+		Instance* m_InstanceBufferBase = nullptr;
+		Instance* m_InstanceBufferPtr = nullptr;
+		std::vector<Ref<Texture2d>> m_TextureSlots;
+
+		const Texture2d* m_LastTexture = nullptr;
+		float m_LastTextureIndex = 0.0f;
+
+		Ref<VertexArray> m_VertexArray;
+		Ref<StreamingVertexBuffer> m_InstanceBuffer;
+		Ref<Shader> m_Shader;
+
+		Statistics m_Statistics;
+	};
+}
@@ -36,14 +36,27 @@ namespace Acorn
 			s_RendererApi->ClearDepth();
 		}
 
-		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0)
+		/**
+		 * @param baseVertex
+		 *  Gets added to every index, used to draw from an offset inside a streamed vertex buffer.
+		 */
+		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0, uint32_t baseVertex = 0)
 		{
-			s_RendererApi->DrawIndexed(vertexArray, count);
+			s_RendererApi->DrawIndexed(vertexArray, count, baseVertex);
 		}
 
-		inline static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count = 0)
+		inline static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count = 0, uint32_t baseVertex = 0)
 		{
-			s_RendererApi->DrawLines(vertexArray, count);
+			s_RendererApi->DrawLines(vertexArray, count, baseVertex);
+		}
+
+		/**
+		 * @param baseInstance
+		 *  First instance read from per instance buffers, used to draw from an offset inside a streamed instance buffer.
+		 */
+		inline static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance = 0)
+		{
+			s_RendererApi->DrawIndexedInstanced(vertexArray, indexCount, instanceCount, baseInstance);
 		}
 
 		inline static const char* GetVendor() { return s_RendererApi->GetVendor(); }
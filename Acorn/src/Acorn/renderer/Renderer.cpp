@@ -25,6 +25,13 @@ namespace Acorn
 		debug::Renderer::ShutDown();
 	}
 
+	void Renderer::EndFrame()
+	{
+		AC_PROFILE_FUNCTION();
+
+		ext2d::Renderer::EndFrame();
+	}
+
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		AC_PROFILE_FUNCTION();
@@ -27,6 +27,7 @@ namespace Acorn
 
 	private:
 		static void Init();
+		static void EndFrame();
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 	private:
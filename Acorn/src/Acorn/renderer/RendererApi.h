@@ -24,8 +24,9 @@ namespace Acorn
 		virtual void Clear() = 0;
 		virtual void ClearDepth() = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) = 0;
-		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count) = 0;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex) = 0;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count, uint32_t baseVertex) = 0;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) = 0;
 
 		inline static Api GetAPI() { return s_API; }
 
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Acorn::Binary
+{
+	// Columns are copied with memcpy, so the host has to match the file
+	static_assert(std::endian::native == std::endian::little, "The binary scene format is little-endian");
+
+	constexpr char SceneMagic[4] = {'A', 'C', 'S', 'B'};
+	constexpr uint32_t SceneVersion = 2;
+
+	// Blocks start at multiples of this and columns at multiples of their element alignment,
+	// so a mapped file can be read in place
+	constexpr uint64_t BlockAlignment = 8;
+
+	/**
+	 * @brief Identifies the payload of a block, unknown types are skipped.
+	 *
+	 * Every component block starts with a column of entity indices into the Entities block,
+	 * followed by one column per field.
+	 */
+	enum class BlockType : uint32_t
+	{
+		Entities = 0,
+		Strings,
+		Tag,
+		Transform,
+		Camera,
+		SpriteRenderer,
+		CircleRenderer,
+		// Script path only. The YAML writer also emits the user parameters, but nothing reads them back yet
+		// (the YAML reader skips them and V8Script::SetParameters is a stub), so converting a scene drops them
+		JSScript,
+		RigidBody2d,
+		BoxCollider2d,
+		CircleCollider2d,
+		Children,
+		// Single uint64_t, the autosave generation of a SceneJournal snapshot
+		Generation,
+	};
+
+	struct FileHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t EntityCount;
+		uint32_t BlockCount;
+	};
+
+	struct BlockHeader
+	{
+		BlockType Type;
+		// Number of rows in the block
+		uint32_t Count;
+		// Payload size in bytes, not including the header and the alignment padding
+		uint64_t Size;
+	};
+
+	static_assert(sizeof(FileHeader) == 16 && sizeof(BlockHeader) == 16, "Headers are written as is");
+
+	// Index into the string table for absent strings, e.g. sprites without a texture
+	constexpr uint32_t NoString = 0xffffffff;
+
+	class Writer
+	{
+	public:
+		template <typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			size_t offset = m_Buffer.size();
+			m_Buffer.resize(offset + sizeof(T));
+			std::memcpy(m_Buffer.data() + offset, &value, sizeof(T));
+		}
+
+		template <typename T>
+		void WriteColumn(const std::vector<T>& column)
+		{
+			static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= BlockAlignment);
+			m_Buffer.resize((m_Buffer.size() + alignof(T) - 1) & ~(alignof(T) - 1), 0);
+			size_t offset = m_Buffer.size();
+			m_Buffer.resize(offset + column.size() * sizeof(T));
+			if (!column.empty())
+			{
+				std::memcpy(m_Buffer.data() + offset, column.data(), column.size() * sizeof(T));
+			}
+		}
+
+		void WriteBytes(const void* data, size_t size)
+		{
+			size_t offset = m_Buffer.size();
+			m_Buffer.resize(offset + size);
+			std::memcpy(m_Buffer.data() + offset, data, size);
+		}
+
+		void BeginBlock(BlockType type, uint32_t count)
+		{
+			AC_CORE_ASSERT(m_BlockStart == 0, "Blocks can not be nested");
+			m_BlockStart = m_Buffer.size();
+			Write(BlockHeader{type, count, 0});
+			m_BlockCount++;
+		}
+
+		void EndBlock()
+		{
+			uint64_t size = m_Buffer.size() - m_BlockStart - sizeof(BlockHeader);
+			std::memcpy(m_Buffer.data() + m_BlockStart + offsetof(BlockHeader, Size), &size, sizeof(size));
+			m_Buffer.resize((m_Buffer.size() + BlockAlignment - 1) & ~(BlockAlignment - 1), 0);
+			m_BlockStart = 0;
+		}
+
+		uint32_t GetBlockCount() const { return m_BlockCount; }
+		std::vector<char>& GetBuffer() { return m_Buffer; }
+
+	private:
+		std::vector<char> m_Buffer;
+		size_t m_BlockStart = 0;
+		uint32_t m_BlockCount = 0;
+	};
+
+	/**
+	 * @brief Bounds checked reads from a scene file in memory.
+	 *
+	 * Reading past the end does not throw, it marks the reader as failed and yields zeroed values or empty columns,
+	 * so a loader can check IsValid() once per block. Between BeginBlock() and EndBlock() the end of the block counts
+	 * as the end of the data. The data has to be aligned to BlockAlignment.
+	 */
+	class Reader
+	{
+	public:
+		Reader(const char* data, size_t size)
+			: m_Data(data), m_Size(size) {}
+
+		template <typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			T value{};
+			if (Require(sizeof(T)))
+			{
+				std::memcpy(&value, m_Data + m_Position, sizeof(T));
+				m_Position += sizeof(T);
+			}
+			return value;
+		}
+
+		/**
+		 * @brief Returns a column without copying it, the span points into the data of the reader.
+		 */
+		template <typename T>
+		std::span<const T> ViewColumn(uint64_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= BlockAlignment);
+			size_t padding = ((m_Position + alignof(T) - 1) & ~(alignof(T) - 1)) - m_Position;
+			// The first check keeps count * sizeof(T) from wrapping
+			if (count > m_End || !Require(padding + count * sizeof(T)))
+				return {};
+
+			m_Position += padding;
+			std::span<const T> column((const T*)(m_Data + m_Position), count);
+			m_Position += (size_t)count * sizeof(T);
+			return column;
+		}
+
+		std::string_view ReadBytes(size_t size)
+		{
+			if (!Require(size))
+				return {};
+
+			std::string_view bytes(m_Data + m_Position, size);
+			m_Position += size;
+			return bytes;
+		}
+
+		/**
+		 * @brief Limits the reads to the next size bytes, the payload of the block that starts here.
+		 */
+		void BeginBlock(uint64_t size)
+		{
+			if (size > m_Size - m_Position)
+			{
+				m_Failed = true;
+				return;
+			}
+			m_End = m_Position + size;
+		}
+
+		void EndBlock() { m_End = m_Size; }
+
+		void Seek(size_t position)
+		{
+			if (position > m_Size)
+			{
+				m_Failed = true;
+				return;
+			}
+			m_Position = position;
+		}
+
+		size_t GetPosition() const { return m_Position; }
+		size_t GetSize() const { return m_Size; }
+		bool IsValid() const { return !m_Failed; }
+
+	private:
+		bool Require(uint64_t size)
+		{
+			if (m_Failed || m_Position > m_End || size > m_End - m_Position)
+			{
+				m_Failed = true;
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		const char* m_Data;
+		size_t m_Size;
+		// End of the current block, or of the data outside of one
+		size_t m_End = m_Size;
+		size_t m_Position = 0;
+		bool m_Failed = false;
+	};
+}
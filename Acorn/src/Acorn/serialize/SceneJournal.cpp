@@ -0,0 +1,226 @@
+#include "acpch.h"
+
+#include "serialize/SceneJournal.h"
+
+#include "core/UUID.h"
+#include "serialize/Serializer.h"
+#include "utils/MappedFile.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace Acorn
+{
+	// Ends every record, a record without it was cut off by a crash and is skipped
+	static constexpr std::string_view RecordEnd = "\n...\n";
+	// First line of the journal, followed by the generation of the snapshot the records apply to
+	static constexpr std::string_view JournalHeader = "# Acorn autosave generation ";
+
+	/**
+	 * @brief Reads the generation from the header line and removes the line from journal.
+	 */
+	static bool ReadJournalHeader(std::string_view& journal, uint64_t& generation)
+	{
+		size_t end = journal.find('\n');
+		if (!journal.starts_with(JournalHeader) || end == std::string_view::npos)
+			return false;
+
+		const char* first = journal.data() + JournalHeader.size();
+		const char* last = journal.data() + end;
+		auto [ptr, error] = std::from_chars(first, last, generation);
+		if (error != std::errc() || ptr != last)
+			return false;
+
+		journal.remove_prefix(end + 1);
+		return true;
+	}
+
+	SceneJournal::SceneJournal(const Ref<Scene>& scene, const std::string& scenePath, uint32_t compactInterval)
+		: m_Scene(scene), m_ScenePath(scenePath), m_CompactInterval(std::max(compactInterval, 1u))
+	{
+		m_Scene->EnableChangeTracking();
+
+		// Only what happens from now on belongs into the journal
+		m_Scene->TakeChanges(m_Changed, m_Destroyed);
+	}
+
+	std::string SceneJournal::GetSnapshotPath(const std::string& scenePath)
+	{
+		return scenePath + ".autosave";
+	}
+
+	std::string SceneJournal::GetJournalPath(const std::string& scenePath)
+	{
+		return scenePath + ".autosave.journal";
+	}
+
+	void SceneJournal::Autosave()
+	{
+		AC_PROFILE_FUNCTION();
+		m_Scene->TakeChanges(m_Changed, m_Destroyed);
+		if (m_Changed.empty() && m_Destroyed.empty())
+			return;
+
+		if (m_RecordCount >= m_CompactInterval)
+		{
+			Compact();
+			return;
+		}
+
+		if (!m_JournalStarted && !StartJournal())
+			return;
+
+		std::string record = SceneSerializer(m_Scene).SerializeChanges(m_Changed, m_Destroyed);
+
+		std::ofstream journal(GetJournalPath(m_ScenePath), std::ios::binary | std::ios::app);
+		if (!journal)
+		{
+			AC_CORE_WARN("Can not open the autosave journal of {}", m_ScenePath);
+			return;
+		}
+
+		journal << record << RecordEnd;
+		journal.flush();
+		m_RecordCount++;
+
+		AC_CORE_TRACE("Autosaved {} changed and {} destroyed entities of {}", m_Changed.size(), m_Destroyed.size(), m_ScenePath);
+	}
+
+	void SceneJournal::Compact()
+	{
+		AC_PROFILE_FUNCTION();
+		// Replaced in one step, a crash while writing leaves the old snapshot and journal intact
+		std::string snapshotPath = GetSnapshotPath(m_ScenePath);
+		std::string temporaryPath = snapshotPath + ".tmp";
+		// Random, so a journal of an earlier snapshot or session never matches the new one
+		uint64_t generation = UUID().GetLow() | 1;
+		SceneSerializer(m_Scene).SerializeRuntime(temporaryPath, generation);
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, snapshotPath, error);
+		if (error)
+		{
+			AC_CORE_WARN("Failed to write the autosave of {}: {}", m_ScenePath, error.message());
+			return;
+		}
+
+		m_Generation = generation;
+		StartJournal();
+
+		// The snapshot holds everything up to now
+		m_Scene->TakeChanges(m_Changed, m_Destroyed);
+		AC_CORE_TRACE("Compacted the autosave of {}", m_ScenePath);
+	}
+
+	void SceneJournal::Discard()
+	{
+		AC_PROFILE_FUNCTION();
+		std::error_code error;
+		std::filesystem::remove(GetSnapshotPath(m_ScenePath), error);
+		std::filesystem::remove(GetJournalPath(m_ScenePath), error);
+		m_RecordCount = 0;
+		m_Generation = 0;
+		m_JournalStarted = false;
+
+		m_Scene->TakeChanges(m_Changed, m_Destroyed);
+	}
+
+	bool SceneJournal::StartJournal()
+	{
+		// Without a snapshot of this session the records apply to the scene file, so a stale snapshot has to go
+		std::error_code error;
+		if (m_Generation == 0)
+			std::filesystem::remove(GetSnapshotPath(m_ScenePath), error);
+
+		std::ofstream journal(GetJournalPath(m_ScenePath), std::ios::binary | std::ios::trunc);
+		journal << JournalHeader << m_Generation << '\n';
+		journal.flush();
+		m_RecordCount = 0;
+		m_JournalStarted = (bool)journal;
+		if (!m_JournalStarted)
+			AC_CORE_WARN("Can not open the autosave journal of {}", m_ScenePath);
+
+		return m_JournalStarted;
+	}
+
+	void SceneJournal::SetAside(const std::string& scenePath)
+	{
+		AC_PROFILE_FUNCTION();
+		std::error_code error;
+		for (const std::string& path : {GetSnapshotPath(scenePath), GetJournalPath(scenePath)})
+		{
+			if (!std::filesystem::exists(path, error))
+				continue;
+
+			std::filesystem::rename(path, path + ".failed", error);
+			if (error)
+				AC_CORE_WARN("Failed to move {} out of the way: {}", path, error.message());
+		}
+	}
+
+	bool SceneJournal::HasAutosave(const std::string& scenePath)
+	{
+		std::error_code error;
+		if (std::filesystem::exists(GetSnapshotPath(scenePath), error))
+			return true;
+
+		std::string journalPath = GetJournalPath(scenePath);
+		return std::filesystem::exists(journalPath, error) && std::filesystem::file_size(journalPath, error) > 0;
+	}
+
+	Ref<Scene> SceneJournal::Recover(const Ref<Scene>& savedScene, const std::string& scenePath)
+	{
+		AC_PROFILE_FUNCTION();
+		Ref<Scene> scene = savedScene;
+
+		uint64_t snapshotGeneration = 0;
+		std::string snapshotPath = GetSnapshotPath(scenePath);
+		if (std::filesystem::exists(snapshotPath))
+		{
+			scene = CreateRef<Scene>();
+			if (!SceneSerializer(scene).DeserializeRuntime(snapshotPath, snapshotGeneration))
+				return nullptr;
+		}
+
+		// An empty journal can not be mapped, but then there is nothing to replay either
+		Utils::MappedFile journal(GetJournalPath(scenePath));
+		if (!journal.IsOpen())
+			return scene;
+
+		std::string_view records(journal.GetData(), journal.GetSize());
+		uint64_t journalGeneration = 0;
+		if (!ReadJournalHeader(records, journalGeneration) || journalGeneration != snapshotGeneration)
+		{
+			AC_CORE_WARN("The autosave journal of {} does not belong to its snapshot, skipping it", scenePath);
+			return scene;
+		}
+
+		// The records are replayed into a copy, a record that fails halfway leaves the loaded scene as it was
+		if (scene == savedScene)
+			scene = Scene::Copy(savedScene);
+
+		SceneSerializer serializer(scene);
+		uint32_t replayed = 0;
+		for (size_t end = records.find(RecordEnd); end != std::string_view::npos; end = records.find(RecordEnd))
+		{
+			// The record was written completely, so failing to read it means the journal is corrupt
+			if (!serializer.DeserializeChanges(std::string(records.substr(0, end))))
+			{
+				AC_CORE_ERROR("Autosave record {} of {} can not be read", replayed + 1, scenePath);
+				return nullptr;
+			}
+
+			records.remove_prefix(end + RecordEnd.size());
+			replayed++;
+		}
+
+		// Only the last record can be cut off
+		if (!records.empty())
+			AC_CORE_WARN("Skipped an incomplete autosave record of {}", scenePath);
+
+		AC_CORE_INFO("Recovered {} from its autosave, replayed {} records", scenePath, replayed);
+		return scene;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/Core.h"
+#include "core/UUID.h"
+#include "ecs/Entity.h"
+#include "ecs/Scene.h"
+
+#include <string>
+#include <vector>
+
+namespace Acorn
+{
+	/**
+	 * @brief Autosaves a scene by appending only the entities that changed to a journal.
+	 *
+	 * Every record of the journal holds the full state of the entities that changed since the previous one. It
+	 * applies on top of the scene file, or on top of the compacted snapshot once one was written. Every few records
+	 * the journal is folded into a new binary snapshot, so recovery never replays a long history.
+	 *
+	 * Files next to the scene: <scene>.autosave (snapshot) and <scene>.autosave.journal (records). Both carry the
+	 * generation of the snapshot, a journal of another generation (e.g. left behind by a crash while compacting) is
+	 * not replayed.
+	 */
+	class SceneJournal
+	{
+	public:
+		/**
+		 * @param scene
+		 *  Scene as it was loaded from scenePath, change tracking is enabled on it.
+		 * @param compactInterval
+		 *  Number of records after which the journal is folded into a snapshot.
+		 */
+		SceneJournal(const Ref<Scene>& scene, const std::string& scenePath, uint32_t compactInterval = 32);
+
+		SceneJournal(const SceneJournal&) = delete;
+		SceneJournal& operator=(const SceneJournal&) = delete;
+
+		/**
+		 * @brief Appends the changes since the last autosave, or compacts once enough records were written.
+		 *
+		 * Does nothing if the scene did not change.
+		 */
+		void Autosave();
+
+		/**
+		 * @brief Writes the whole scene as the new snapshot and starts an empty journal.
+		 */
+		void Compact();
+
+		/**
+		 * @brief Removes the autosave files, call after the scene was saved to scenePath.
+		 */
+		void Discard();
+
+		inline const std::string& GetScenePath() const { return m_ScenePath; }
+
+		static bool HasAutosave(const std::string& scenePath);
+
+		/**
+		 * @brief Rebuilds the scene of an earlier session from its autosave files.
+		 *
+		 * @param savedScene
+		 *  Scene loaded from scenePath, the journal applies to a copy of it while no snapshot has been written.
+		 *  It is never modified.
+		 * @return
+		 *  The recovered scene, null if the autosave could not be read.
+		 */
+		static Ref<Scene> Recover(const Ref<Scene>& savedScene, const std::string& scenePath);
+
+		/**
+		 * @brief Renames the autosave files to <file>.failed, so a new journal does not overwrite what could not be recovered.
+		 */
+		static void SetAside(const std::string& scenePath);
+
+	private:
+		static std::string GetSnapshotPath(const std::string& scenePath);
+		static std::string GetJournalPath(const std::string& scenePath);
+
+		/**
+		 * @brief Starts a journal with no records for the current generation.
+		 */
+		bool StartJournal();
+
+	private:
+		Ref<Scene> m_Scene;
+		std::string m_ScenePath;
+		uint32_t m_CompactInterval;
+		uint32_t m_RecordCount = 0;
+		// Generation of the snapshot the journal applies to, 0 while it applies to the scene file
+		uint64_t m_Generation = 0;
+		bool m_JournalStarted = false;
+
+		// Reused between autosaves
+		std::vector<Entity> m_Changed;
+		std::vector<UUID> m_Destroyed;
+	};
+}
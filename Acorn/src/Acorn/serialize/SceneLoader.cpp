@@ -0,0 +1,230 @@
+#include "acpch.h"
+
+#include "serialize/SceneLoader.h"
+
+#include "ecs/Entity.h"
+#include "ecs/components/Components.h"
+#include "utils/MappedFile.h"
+
+#include <yaml-cpp/yaml.h>
+
+namespace Acorn
+{
+	SceneLoader::SceneLoader(const Ref<Scene>& scene, const std::string& filePath, uint32_t chunkSize)
+		: m_Scene(scene), m_FilePath(filePath), m_ChunkSize(std::max(chunkSize, 1u))
+	{
+		m_Worker = std::thread(&SceneLoader::Parse, this);
+	}
+
+	SceneLoader::~SceneLoader()
+	{
+		Cancel();
+		if (m_Worker.joinable())
+			m_Worker.join();
+	}
+
+	void SceneLoader::Cancel()
+	{
+		m_Cancelled = true;
+		if (m_State == State::Loading || m_State == State::StreamingTextures)
+			m_State = State::Cancelled;
+	}
+
+	void SceneLoader::Fail(const std::string& reason)
+	{
+		AC_CORE_WARN("Failed to load scene {}: {}", m_FilePath, reason);
+		std::lock_guard lock(m_Mutex);
+		m_Failed = true;
+	}
+
+	void SceneLoader::Parse()
+	{
+		AC_PROFILE_FUNCTION();
+		std::vector<std::string> texturePaths;
+		try
+		{
+			Utils::MappedFile file(m_FilePath);
+			if (!file.IsOpen())
+			{
+				Fail("can not open the file");
+				return;
+			}
+
+			YAML::Node root = YAML::Load(std::string(file.GetData(), file.GetSize()));
+			file.Close();
+			if (!root["Scene"])
+			{
+				Fail("not a scene");
+				return;
+			}
+
+			auto entities = root["Entities"];
+			{
+				std::lock_guard lock(m_Mutex);
+				m_EntityCount = entities ? (uint32_t)entities.size() : 0;
+				m_WorldSpaceChildren = !root["Transforms"];
+			}
+
+			std::unordered_set<std::string> seenTextures;
+			std::vector<EntityDescription> chunk;
+			chunk.reserve(m_ChunkSize);
+			for (auto entity : entities ? entities : YAML::Node(YAML::NodeType::Sequence))
+			{
+				if (m_Cancelled)
+					return;
+
+				chunk.push_back(SceneSerializer::ParseEntity(entity));
+				const std::string& texturePath = chunk.back().TexturePath;
+				if (!texturePath.empty() && seenTextures.insert(texturePath).second)
+				{
+					texturePaths.push_back(texturePath);
+				}
+
+				if (chunk.size() == m_ChunkSize)
+				{
+					std::lock_guard lock(m_Mutex);
+					m_Chunks.push_back(std::move(chunk));
+					chunk = {};
+					chunk.reserve(m_ChunkSize);
+				}
+			}
+
+			std::lock_guard lock(m_Mutex);
+			if (!chunk.empty())
+			{
+				m_Chunks.push_back(std::move(chunk));
+			}
+			m_ParsingDone = true;
+		}
+		catch (const YAML::Exception& e)
+		{
+			Fail(e.what());
+			return;
+		}
+
+		// Decoding is the slow part of a texture, only the upload has to wait for the main thread
+		for (const std::string& path : texturePaths)
+		{
+			if (m_Cancelled)
+				return;
+
+			Ref<AsyncTextureLoader> loader = AsyncTextureLoader::Create(path, -1, -1);
+			loader->Load();
+
+			std::lock_guard lock(m_Mutex);
+			m_DecodedTextures.emplace_back(path, loader);
+		}
+
+		std::lock_guard lock(m_Mutex);
+		m_TexturesDone = true;
+	}
+
+	void SceneLoader::RequestTexture(Entity entity, const std::string& path)
+	{
+		auto it = m_Textures.find(path);
+		if (it != m_Textures.end())
+		{
+			entity.GetComponent<Components::SpriteRenderer>().Texture = it->second;
+			return;
+		}
+
+		m_WaitingForTexture[path].push_back(entity.GetUUID());
+	}
+
+	SceneLoader::State SceneLoader::Update(uint32_t maxChunks)
+	{
+		AC_PROFILE_FUNCTION();
+		if (m_State != State::Loading && m_State != State::StreamingTextures)
+			return m_State;
+
+		std::vector<std::vector<EntityDescription>> chunks;
+		std::vector<std::pair<std::string, Ref<AsyncTextureLoader>>> textures;
+		bool parsingDone, texturesDone, worldSpaceChildren;
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_Failed)
+			{
+				m_State = State::Failed;
+				return m_State;
+			}
+
+			while (!m_Chunks.empty() && chunks.size() < maxChunks)
+			{
+				chunks.push_back(std::move(m_Chunks.front()));
+				m_Chunks.pop_front();
+			}
+			while (!m_DecodedTextures.empty())
+			{
+				textures.push_back(std::move(m_DecodedTextures.front()));
+				m_DecodedTextures.pop_front();
+			}
+
+			// Parsing only counts as done once the last chunk has been taken
+			parsingDone = m_ParsingDone && m_Chunks.empty();
+			texturesDone = m_TexturesDone && m_DecodedTextures.empty();
+			worldSpaceChildren = m_WorldSpaceChildren;
+		}
+
+		SceneSerializer serializer(m_Scene);
+		auto requestTexture = [this](Entity entity, const std::string& path)
+		{
+			RequestTexture(entity, path);
+		};
+
+		for (auto& chunk : chunks)
+		{
+			for (auto& description : chunk)
+			{
+				serializer.AddEntity(description, requestTexture);
+				if (!description.Children.empty())
+				{
+					m_Parents.emplace_back(description.Id, std::move(description.Children));
+				}
+			}
+			m_AddedCount += (uint32_t)chunk.size();
+		}
+
+		for (auto& [path, loader] : textures)
+		{
+			Ref<Texture2d> texture = loader->Upload();
+			m_Textures[path] = texture;
+
+			auto waiting = m_WaitingForTexture.find(path);
+			if (waiting == m_WaitingForTexture.end())
+				continue;
+
+			for (const UUID& id : waiting->second)
+			{
+				// The scene may already be edited, skip sprites that are gone
+				Entity entity = m_Scene->GetEntity(id);
+				if (entity && entity.HasComponent<Components::SpriteRenderer>())
+					entity.GetComponent<Components::SpriteRenderer>().Texture = texture;
+			}
+			m_WaitingForTexture.erase(waiting);
+		}
+
+		if (m_State == State::Loading && parsingDone)
+		{
+			// Children can point at any entity in the file, so they are linked once all of them exist
+			serializer.LinkChildren(m_Parents, worldSpaceChildren);
+			m_Parents.clear();
+			m_State = State::StreamingTextures;
+		}
+
+		if (m_State == State::StreamingTextures && texturesDone)
+		{
+			m_State = State::Done;
+		}
+
+		return m_State;
+	}
+
+	float SceneLoader::GetProgress() const
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_EntityCount == 0)
+			return m_ParsingDone ? 1.0f : 0.0f;
+
+		return (float)m_AddedCount / (float)m_EntityCount;
+	}
+}
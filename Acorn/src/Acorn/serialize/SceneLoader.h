@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/Core.h"
+#include "core/UUID.h"
+#include "ecs/Scene.h"
+#include "renderer/Texture.h"
+#include "serialize/Serializer.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Acorn
+{
+	/**
+	 * @brief Loads a YAML scene in the background, so the editor keeps running while big scenes load.
+	 *
+	 * A worker thread parses the file in chunks of entities, the main thread adds finished chunks to the scene
+	 * in Update(), so the registry is only ever touched by the main thread. Sprite textures are decoded by the
+	 * worker after all entities are parsed and uploaded by Update(), sprites show up untextured until then.
+	 */
+	class SceneLoader
+	{
+	public:
+		enum class State
+		{
+			Loading,
+			// All entities are in the scene, textures are still arriving
+			StreamingTextures,
+			Done,
+			Failed,
+			Cancelled,
+		};
+
+	public:
+		/**
+		 * @param scene
+		 *  Scene to load into, should not be used elsewhere until the state is past Loading.
+		 * @param chunkSize
+		 *  Number of entities handed over to the main thread at once.
+		 */
+		SceneLoader(const Ref<Scene>& scene, const std::string& filePath, uint32_t chunkSize = 256);
+		~SceneLoader();
+
+		SceneLoader(const SceneLoader&) = delete;
+		SceneLoader& operator=(const SceneLoader&) = delete;
+
+		/**
+		 * @brief Adds parsed entities to the scene and uploads decoded textures, call once per frame on the main thread.
+		 *
+		 * @param maxChunks
+		 *  Upper bound of chunks added per call, keeps single frames short for huge scenes.
+		 * @return
+		 *  The state after the update.
+		 */
+		State Update(uint32_t maxChunks = 8);
+
+		/**
+		 * @brief Stops the worker, entities that were already added stay in the scene.
+		 */
+		void Cancel();
+
+		/**
+		 * @return
+		 *  Fraction of the entities that are in the scene, between 0 and 1.
+		 */
+		float GetProgress() const;
+
+		inline State GetState() const { return m_State; }
+		inline const Ref<Scene>& GetScene() const { return m_Scene; }
+		inline const std::string& GetFilePath() const { return m_FilePath; }
+
+	private:
+		void Parse();
+		void Fail(const std::string& reason);
+		void RequestTexture(Entity entity, const std::string& path);
+
+	private:
+		Ref<Scene> m_Scene;
+		std::string m_FilePath;
+		uint32_t m_ChunkSize;
+
+		std::thread m_Worker;
+		std::atomic<bool> m_Cancelled = false;
+
+		// Shared with the worker, guarded by m_Mutex
+		mutable std::mutex m_Mutex;
+		std::deque<std::vector<EntityDescription>> m_Chunks;
+		std::deque<std::pair<std::string, Ref<AsyncTextureLoader>>> m_DecodedTextures;
+		uint32_t m_EntityCount = 0;
+		bool m_WorldSpaceChildren = false;
+		bool m_ParsingDone = false;
+		bool m_TexturesDone = false;
+		bool m_Failed = false;
+
+		// Main thread only
+		State m_State = State::Loading;
+		uint32_t m_AddedCount = 0;
+		std::vector<std::pair<UUID, std::vector<UUID>>> m_Parents;
+		std::unordered_map<std::string, Ref<Texture2d>> m_Textures;
+		std::unordered_map<std::string, std::vector<UUID>> m_WaitingForTexture;
+	};
+}
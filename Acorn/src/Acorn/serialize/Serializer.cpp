@@ -5,13 +5,18 @@
 #include "core/Core.h"
 #include "ecs/Entity.h"
 #include "ecs/Scene.h"
+#include "ecs/components/ComponentRegistry.h"
 #include "ecs/components/Components.h"
+#include "serialize/BinaryFormat.h"
+#include "utils/MappedFile.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <magic_enum.hpp>
-#include <sstream>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <yaml-cpp/emittermanip.h>
 #include <yaml-cpp/yaml.h>
 
@@ -103,8 +108,11 @@ namespace YAML
 
 		static bool decode(const Node& node, Acorn::UUID& uuid)
 		{
-			std::string u = node[0].as<std::string>();
-			uuid = Acorn::UUID(u);
+			std::optional<Acorn::UUID> parsed = Acorn::UUID::FromChars(node[0].Scalar());
+			if (!parsed)
+				return false;
+
+			uuid = *parsed;
 			return true;
 		}
 	};
@@ -192,6 +200,11 @@ namespace Acorn
 		out << YAML::Value << YAML::BeginMap; // SpriteRenderer
 
 		out << YAML::Key << "Color" << YAML::Value << spriteRenderer.Color;
+		out << YAML::Key << "TilingFactor" << YAML::Value << spriteRenderer.TilingFactor;
+		if (spriteRenderer.Texture && !spriteRenderer.Texture->GetPath().empty())
+		{
+			out << YAML::Key << "Texture" << YAML::Value << spriteRenderer.Texture->GetPath();
+		}
 
 		out << YAML::EndMap; // SpriteRenderer
 
@@ -281,6 +294,16 @@ namespace Acorn
 		return out;
 	}
 
+	YAML::Emitter& operator<<(YAML::Emitter& out, const UUID& uuid)
+	{
+		// Formatted on the stack, the emitter only needs a null terminated string
+		char buffer[UUID::StringLength + 1];
+		uuid.ToChars(buffer);
+		buffer[UUID::StringLength] = '\0';
+
+		return out << (const char*)buffer;
+	}
+
 	YAML::Emitter& operator<<(YAML::Emitter& out, const Components::ChildRelationship& childRelationship)
 	{
 		AC_PROFILE_FUNCTION();
@@ -301,6 +324,17 @@ namespace Acorn
 	{
 	}
 
+	static uint32_t GetDepth(Entity entity)
+	{
+		uint32_t depth = 0;
+		while (entity.HasComponent<Components::ParentRelationship>())
+		{
+			entity = entity.GetComponent<Components::ParentRelationship>().Parent;
+			depth++;
+		}
+		return depth;
+	}
+
 	static void SerializeEntity(YAML::Emitter& out, Entity entity)
 	{
 		AC_PROFILE_FUNCTION();
@@ -308,112 +342,654 @@ namespace Acorn
 
 		AC_CORE_ASSERT(entity.HasComponent<Components::ID>(), "Entity does not have an ID, cannot be serialized!");
 
-		out << YAML::Key << "Entity" << YAML::Value << (std::string)entity.GetUUID();
+		out << YAML::Key << "Entity" << YAML::Value << entity.GetUUID();
+
+		Components::SerializedComponents::ForEach([&](auto type)
+			{
+				using Component = typename decltype(type)::type;
+				if (entity.HasComponent<Component>())
+				{
+					out << YAML::Key << Components::Reflection<Component>::Name << YAML::Value << entity.GetComponent<Component>();
+				}
+			});
+
+		out << YAML::EndMap; // Entity
+	}
+
+	void SceneSerializer::Serialize(const std::string& filePath)
+	{
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Scene" << YAML::Value << "Untitled Scene";
+		// Older scenes stored children in world space
+		out << YAML::Key << "Transforms" << YAML::Value << "Local";
+		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+
+		m_Scene->m_Registry.each(
+			[&](auto entityId)
+			{
+				Entity entity = {entityId, m_Scene.get()};
+				if (!entity)
+					return;
+
+				SerializeEntity(out, entity);
+			});
+
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		AC_CORE_TRACE("Writing serialization to {}", filePath);
+
+		if (!std::filesystem::exists(std::filesystem::path(filePath).parent_path()))
+		{
+			bool success = std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
+			AC_CORE_ASSERT(success, "Failed to create directory for serialization file");
+		}
+
+		std::ofstream fout(filePath);
+		AC_CORE_ASSERT(!!fout, "Failed to open file for writing!");
+
+		fout << out.c_str();
+		fout.close();
+	}
+
+	std::string SceneSerializer::SerializeChanges(const std::vector<Entity>& changed, const std::vector<UUID>& destroyed)
+	{
+		AC_PROFILE_FUNCTION();
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+
+		out << YAML::Key << "Destroyed" << YAML::Value << YAML::BeginSeq;
+		for (const UUID& id : destroyed)
+		{
+			out << id;
+		}
+		out << YAML::EndSeq;
+
+		out << YAML::Key << "Changed" << YAML::Value << YAML::BeginSeq;
+		for (Entity entity : changed)
+		{
+			SerializeEntity(out, entity);
+		}
+		out << YAML::EndSeq;
+
+		out << YAML::EndMap;
+		return out.c_str();
+	}
+
+	/**
+	 * @brief Collects the strings of a binary scene, rows store indices into it.
+	 *
+	 * Strings are interned, equal strings such as the default tag or a shared texture path are stored once.
+	 */
+	class StringTableWriter
+	{
+	public:
+		uint32_t Add(const std::string& string)
+		{
+			auto [it, inserted] = m_Indices.try_emplace(string, (uint32_t)m_Strings.size());
+			if (inserted)
+			{
+				m_Strings.push_back(&string);
+			}
+			return it->second;
+		}
 
-		if (entity.HasComponent<Components::Tag>())
+		void Write(Binary::Writer& writer)
 		{
-			out << YAML::Key << "Tag" << YAML::Value << entity.GetComponent<Components::Tag>();
+			std::vector<uint32_t> offsets;
+			offsets.reserve(m_Strings.size() + 1);
+			offsets.push_back(0);
+			for (const std::string* string : m_Strings)
+			{
+				offsets.push_back(offsets.back() + (uint32_t)string->size());
+			}
+
+			writer.BeginBlock(Binary::BlockType::Strings, (uint32_t)m_Strings.size());
+			writer.WriteColumn(offsets);
+			for (const std::string* string : m_Strings)
+			{
+				writer.WriteBytes(string->data(), string->size());
+			}
+			writer.EndBlock();
 		}
 
-		if (entity.HasComponent<Components::Transform>())
+	private:
+		// The components outlive the writer, so their strings are not copied
+		std::vector<const std::string*> m_Strings;
+		std::unordered_map<std::string_view, uint32_t> m_Indices;
+	};
+
+	template <typename Component, typename ColumnFn>
+	static void WriteComponentColumn(Binary::Writer& writer, entt::registry& registry, const std::vector<entt::entity>& entities, ColumnFn&& column)
+	{
+		using Value = std::decay_t<std::invoke_result_t<ColumnFn, const Component&>>;
+
+		std::vector<Value> values;
+		values.reserve(entities.size());
+		for (entt::entity entity : entities)
 		{
-			out << YAML::Key << "Transform" << YAML::Value << entity.GetComponent<Components::Transform>();
+			values.push_back(column(registry.get<Component>(entity)));
 		}
+		writer.WriteColumn(values);
+	}
 
-		if (entity.HasComponent<Components::CameraComponent>())
+	/**
+	 * @brief Writes one block for all entities with the component, each column function produces one field.
+	 */
+	template <typename Component, typename... ColumnFns>
+	static void WriteComponentBlock(Binary::Writer& writer, Binary::BlockType type, entt::registry& registry, const std::unordered_map<entt::entity, uint32_t>& indices, ColumnFns&&... columns)
+	{
+		AC_PROFILE_FUNCTION();
+		auto view = registry.view<Component>();
+		std::vector<entt::entity> entities(view.begin(), view.end());
+		if (entities.empty())
+			return;
+
+		std::vector<uint32_t> rows;
+		rows.reserve(entities.size());
+		for (entt::entity entity : entities)
 		{
-			out << YAML::Key << "Camera" << YAML::Value << entity.GetComponent<Components::CameraComponent>();
+			rows.push_back(indices.at(entity));
 		}
 
-		if (entity.HasComponent<Components::SpriteRenderer>())
+		writer.BeginBlock(type, (uint32_t)entities.size());
+		writer.WriteColumn(rows);
+		(WriteComponentColumn<Component>(writer, registry, entities, columns), ...);
+		writer.EndBlock();
+	}
+
+	void SceneSerializer::SerializeRuntime(const std::string& filePath)
+	{
+		SerializeRuntime(filePath, 0);
+	}
+
+	void SceneSerializer::SerializeRuntime(const std::string& filePath, uint64_t generation)
+	{
+		AC_PROFILE_FUNCTION();
+		auto& registry = m_Scene->m_Registry;
+
+		// Rows refer to entities by their position in the Entities block
+		std::vector<UUID> uuids;
+		std::unordered_map<entt::entity, uint32_t> indices;
+		for (auto entity : registry.view<Components::ID>())
 		{
-			out << YAML::Key << "SpriteRenderer" << YAML::Value << entity.GetComponent<Components::SpriteRenderer>();
+			indices[entity] = (uint32_t)uuids.size();
+			uuids.push_back(registry.get<Components::ID>(entity).UUID);
 		}
 
-		if (entity.HasComponent<Components::CircleRenderer>())
+		Binary::Writer writer;
+		writer.Write(Binary::FileHeader{{'A', 'C', 'S', 'B'}, Binary::SceneVersion, (uint32_t)uuids.size(), 0});
+
 		{
-			out << YAML::Key << "CircleRenderer" << YAML::Value << entity.GetComponent<Components::CircleRenderer>();
+			std::vector<uint64_t> high, low;
+			high.reserve(uuids.size());
+			low.reserve(uuids.size());
+			for (const UUID& uuid : uuids)
+			{
+				high.push_back(uuid.GetHigh());
+				low.push_back(uuid.GetLow());
+			}
+
+			writer.BeginBlock(Binary::BlockType::Entities, (uint32_t)uuids.size());
+			writer.WriteColumn(high);
+			writer.WriteColumn(low);
+			writer.EndBlock();
 		}
 
+		StringTableWriter strings;
+		// Texture paths are built on the fly, so they need storage that outlives the writer
+		std::vector<std::string> texturePaths;
+		texturePaths.reserve(registry.view<Components::SpriteRenderer>().size());
+
+		WriteComponentBlock<Components::Tag>(writer, Binary::BlockType::Tag, registry, indices,
+			[&](const Components::Tag& tag) { return strings.Add(tag.TagName); });
+
+		WriteComponentBlock<Components::Transform>(writer, Binary::BlockType::Transform, registry, indices,
+			[](const Components::Transform& transform) { return transform.Translation; },
+			[](const Components::Transform& transform) { return transform.Rotation; },
+			[](const Components::Transform& transform) { return transform.Scale; });
+
+		WriteComponentBlock<Components::CameraComponent>(writer, Binary::BlockType::Camera, registry, indices,
+			[](const Components::CameraComponent& camera) { return (int32_t)camera.Camera.GetProjectionType(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetOrthographicSize(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetOrthographicNearClip(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetOrthographicFarClip(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetPerspectiveFov(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetPerspectiveNearClip(); },
+			[](const Components::CameraComponent& camera) { return camera.Camera.GetPerspectiveFarClip(); },
+			[](const Components::CameraComponent& camera) { return (uint8_t)camera.Primary; },
+			[](const Components::CameraComponent& camera) { return (uint8_t)camera.FixedAspectRatio; });
+
+		WriteComponentBlock<Components::SpriteRenderer>(writer, Binary::BlockType::SpriteRenderer, registry, indices,
+			[](const Components::SpriteRenderer& sprite) { return sprite.Color; },
+			[](const Components::SpriteRenderer& sprite) { return sprite.TilingFactor; },
+			[&](const Components::SpriteRenderer& sprite)
+			{
+				if (!sprite.Texture || sprite.Texture->GetPath().empty())
+					return Binary::NoString;
+
+				return strings.Add(texturePaths.emplace_back(sprite.Texture->GetPath()));
+			});
+
+		WriteComponentBlock<Components::CircleRenderer>(writer, Binary::BlockType::CircleRenderer, registry, indices,
+			[](const Components::CircleRenderer& circle) { return circle.Color; },
+			[](const Components::CircleRenderer& circle) { return circle.Thickness; },
+			[](const Components::CircleRenderer& circle) { return circle.Fade; });
+
 #ifndef NO_SCRIPTING
-		if (entity.HasComponent<Components::JSScript>())
+		std::vector<std::string> scriptPaths;
+		scriptPaths.reserve(registry.view<Components::JSScript>().size());
+		WriteComponentBlock<Components::JSScript>(writer, Binary::BlockType::JSScript, registry, indices,
+			[&](const Components::JSScript& script)
+			{
+				if (!script.Script)
+					return Binary::NoString;
+
+				return strings.Add(scriptPaths.emplace_back(script.Script->GetFilePath()));
+			});
+#endif // !NO_SCRIPTING
+
+		WriteComponentBlock<Components::RigidBody2d>(writer, Binary::BlockType::RigidBody2d, registry, indices,
+			[](const Components::RigidBody2d& rigidBody) { return (uint8_t)rigidBody.Type; },
+			[](const Components::RigidBody2d& rigidBody) { return (uint8_t)rigidBody.FixedRotation; },
+			[](const Components::RigidBody2d& rigidBody) { return rigidBody.Density; },
+			[](const Components::RigidBody2d& rigidBody) { return rigidBody.Friction; },
+			[](const Components::RigidBody2d& rigidBody) { return rigidBody.Restitution; },
+			[](const Components::RigidBody2d& rigidBody) { return rigidBody.RestitutionThreshold; });
+
+		WriteComponentBlock<Components::BoxCollider2d>(writer, Binary::BlockType::BoxCollider2d, registry, indices,
+			[](const Components::BoxCollider2d& collider) { return collider.GetSize(); },
+			[](const Components::BoxCollider2d& collider) { return collider.GetOffset(); });
+
+		WriteComponentBlock<Components::CircleCollider2d>(writer, Binary::BlockType::CircleCollider2d, registry, indices,
+			[](const Components::CircleCollider2d& collider) { return collider.GetRadius(); },
+			[](const Components::CircleCollider2d& collider) { return collider.GetOffset(); });
+
+		{
+			// Children are stored as one flat list, each parent owns the range up to the next offset
+			auto view = registry.view<Components::ChildRelationship>();
+			std::vector<uint32_t> parents, offsets = {0}, children;
+			for (auto entity : view)
+			{
+				parents.push_back(indices.at(entity));
+				for (Entity child : view.get<Components::ChildRelationship>(entity).Entities)
+				{
+					children.push_back(indices.at(child));
+				}
+				offsets.push_back((uint32_t)children.size());
+			}
+
+			if (!parents.empty())
+			{
+				writer.BeginBlock(Binary::BlockType::Children, (uint32_t)parents.size());
+				writer.WriteColumn(parents);
+				writer.WriteColumn(offsets);
+				writer.WriteColumn(children);
+				writer.EndBlock();
+			}
+		}
+
+		if (generation != 0)
 		{
-			out << YAML::Key << "JSScript" << YAML::Value << entity.GetComponent<Components::JSScript>();
+			writer.BeginBlock(Binary::BlockType::Generation, 1);
+			writer.Write(generation);
+			writer.EndBlock();
+		}
+
+		strings.Write(writer);
+
+		// Now that all blocks are known, patch the header
+		std::vector<char>& buffer = writer.GetBuffer();
+		uint32_t blockCount = writer.GetBlockCount();
+		std::memcpy(buffer.data() + offsetof(Binary::FileHeader, BlockCount), &blockCount, sizeof(blockCount));
+
+		AC_CORE_TRACE("Writing binary serialization to {}", filePath);
+
+		std::filesystem::path parentPath = std::filesystem::path(filePath).parent_path();
+		if (!parentPath.empty() && !std::filesystem::exists(parentPath))
+		{
+			bool success = std::filesystem::create_directories(parentPath);
+			AC_CORE_ASSERT(success, "Failed to create directory for serialization file");
+		}
+
+		std::ofstream fout(filePath, std::ios::binary);
+		AC_CORE_ASSERT(!!fout, "Failed to open file for writing!");
+
+		fout.write(buffer.data(), (std::streamsize)buffer.size());
+		fout.close();
+	}
+
+	EntityDescription SceneSerializer::ParseEntity(const YAML::Node& entity)
+	{
+		AC_PROFILE_FUNCTION();
+		EntityDescription description;
+
+		auto idNode = entity["Entity"];
+		std::optional<UUID> id = UUID::FromChars(idNode.Scalar());
+		if (!id)
+			throw YAML::Exception(idNode.Mark(), "invalid entity id '" + idNode.Scalar() + "'");
+		description.Id = *id;
+
+		auto tagComponent = entity["Tag"];
+		if (tagComponent)
+		{
+			description.Name = tagComponent["Tag"].as<std::string>();
 		}
-#endif // !NO_SCRIPT
 
-		if (entity.HasComponent<Components::RigidBody2d>())
+		auto transformComponent = entity["Transform"];
+		if (transformComponent)
 		{
-			out << YAML::Key << "RigidBody2d" << YAML::Value << entity.GetComponent<Components::RigidBody2d>();
+			description.Transform.Translation = transformComponent["Translation"].as<glm::vec3>();
+			description.Transform.Rotation = transformComponent["Rotation"].as<glm::vec3>();
+			description.Transform.Scale = transformComponent["Scale"].as<glm::vec3>();
 		}
 
-		if (entity.HasComponent<Components::BoxCollider2d>())
+		auto cameraComponent = entity["Camera"];
+		if (cameraComponent)
 		{
-			out << YAML::Key << "BoxCollider2d" << YAML::Value << entity.GetComponent<Components::BoxCollider2d>();
+			auto& cc = description.Camera.emplace();
+
+			auto cameraProps = cameraComponent["SceneCamera"];
+			// TODO serialize as string
+			cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["Type"].as<int>());
+
+			cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+			cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNearClip"].as<float>());
+			cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFarClip"].as<float>());
+
+			cc.Camera.SetPerspectiveFov(cameraProps["PerspectiveFov"].as<float>());
+			cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNearClip"].as<float>());
+			cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFarClip"].as<float>());
+
+			cc.Primary = cameraComponent["Primary"].as<bool>();
+			cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
 		}
 
-		if (entity.HasComponent<Components::CircleCollider2d>())
+		auto spriteRendererComponent = entity["SpriteRenderer"];
+		if (spriteRendererComponent)
 		{
-			out << YAML::Key << "CircleCollider2d" << YAML::Value << entity.GetComponent<Components::CircleCollider2d>();
+			auto& sr = description.Sprite.emplace();
+
+			sr.Color = spriteRendererComponent["Color"].as<glm::vec4>();
+			if (spriteRendererComponent["TilingFactor"])
+			{
+				sr.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+			}
+			if (spriteRendererComponent["Texture"])
+			{
+				description.TexturePath = spriteRendererComponent["Texture"].as<std::string>();
+			}
 		}
 
-		if (entity.HasComponent<Components::ChildRelationship>())
+		auto circleRendererComponent = entity["CircleRenderer"];
+		if (circleRendererComponent)
 		{
-			out << YAML::Key << "Children" << YAML::Value << entity.GetComponent<Components::ChildRelationship>();
+			auto& cr = description.Circle.emplace();
+
+			cr.Color = circleRendererComponent["Color"].as<glm::vec4>();
+			cr.Thickness = circleRendererComponent["Thickness"].as<float>();
+			cr.Fade = circleRendererComponent["Fade"].as<float>();
 		}
 
-		out << YAML::EndMap; // Entity
+		auto jsScriptComponent = entity["JSScript"];
+		if (jsScriptComponent)
+		{
+			description.ScriptPath = jsScriptComponent["Path"].as<std::string>();
+		}
+
+		auto rigidBodyComponent = entity["RigidBody2d"];
+		if (rigidBodyComponent)
+		{
+			auto& rb = description.RigidBody.emplace();
+
+			rb.FixedRotation = rigidBodyComponent["FixedRotation"].as<bool>();
+			rb.Type = magic_enum::enum_cast<Components::RigidBody2d::BodyType>(rigidBodyComponent["Type"].as<std::string>()).value_or(Components::RigidBody2d::BodyType::Static);
+
+			rb.Density = rigidBodyComponent["Density"].as<float>();
+			rb.Friction = rigidBodyComponent["Friction"].as<float>();
+			rb.Restitution = rigidBodyComponent["Restitution"].as<float>();
+			rb.RestitutionThreshold = rigidBodyComponent["RestitutionThreshold"].as<float>();
+		}
+
+		auto boxColliderComponent = entity["BoxCollider2d"];
+		if (boxColliderComponent)
+		{
+			auto& bc = description.BoxCollider.emplace();
+
+			bc.SetSize(boxColliderComponent["Size"].as<glm::vec2>());
+			bc.SetOffset(boxColliderComponent["Offset"].as<glm::vec2>());
+		}
+
+		auto circleColliderComponent = entity["CircleCollider2d"];
+		if (circleColliderComponent)
+		{
+			auto& cc = description.CircleCollider.emplace();
+
+			cc.SetRadius(circleColliderComponent["Radius"].as<float>());
+			cc.SetOffset(circleColliderComponent["Offset"].as<glm::vec2>());
+		}
+
+		auto childRelationship = entity["Children"];
+		if (childRelationship)
+		{
+			description.Children.reserve(childRelationship.size());
+			for (auto child : childRelationship)
+			{
+				description.Children.push_back(child.Scalar());
+			}
+		}
+
+		return description;
 	}
 
-	void SceneSerializer::Serialize(const std::string& filePath)
+	Entity SceneSerializer::AddEntity(EntityDescription& description, const TextureRequestFn& requestTexture)
 	{
-		YAML::Emitter out;
-		out << YAML::BeginMap;
-		out << YAML::Key << "Scene" << YAML::Value << "Untitled Scene";
-		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+		AC_PROFILE_FUNCTION();
+		AC_CORE_TRACE("Deserialized entity [id = {}, name = {}]", (std::string)description.Id, description.Name);
 
-		m_Scene->m_Registry.each(
-			[&](auto entityId)
+		Entity entity = m_Scene->CreateEntity(description.Name, description.Id);
+
+		// Entities always have a transform component
+		entity.GetComponent<Components::Transform>() = description.Transform;
+
+		AddComponents(entity, description, requestTexture);
+		return entity;
+	}
+
+	void SceneSerializer::AddComponents(Entity entity, EntityDescription& description, const TextureRequestFn& requestTexture)
+	{
+		AC_PROFILE_FUNCTION();
+		if (description.Camera)
+		{
+			entity.AddComponent<Components::CameraComponent>(*description.Camera);
+		}
+
+		if (description.Sprite)
+		{
+			entity.AddComponent<Components::SpriteRenderer>(*description.Sprite);
+			if (!description.TexturePath.empty())
 			{
-				Entity entity = {entityId, m_Scene.get()};
-				if (!entity)
-					return;
+				if (requestTexture)
+					requestTexture(entity, description.TexturePath);
+				else
+					entity.GetComponent<Components::SpriteRenderer>().Texture = Texture2d::Create(description.TexturePath);
+			}
+		}
 
-				SerializeEntity(out, entity);
-			});
+		if (description.Circle)
+		{
+			entity.AddComponent<Components::CircleRenderer>(*description.Circle);
+		}
 
-		out << YAML::EndSeq;
-		out << YAML::EndMap;
+#ifndef NO_SCRIPTING
+		if (description.ScriptPath)
+		{
+			auto& jsScript = entity.AddComponent<Components::JSScript>();
 
-		AC_CORE_TRACE("Writing serialization to {}", filePath);
+			jsScript.LoadScript(entity, *description.ScriptPath);
+		}
+#endif // !NO_SCRIPT
 
-		if (!std::filesystem::exists(std::filesystem::path(filePath).parent_path()))
+		if (description.RigidBody)
 		{
-			bool success = std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
-			AC_CORE_ASSERT(success, "Failed to create directory for serialization file");
+			entity.AddComponent<Components::RigidBody2d>(*description.RigidBody);
 		}
 
-		std::ofstream fout(filePath);
-		AC_CORE_ASSERT(!!fout, "Failed to open file for writing!");
+		if (description.BoxCollider)
+		{
+			entity.AddComponent<Components::BoxCollider2d>(*description.BoxCollider);
+		}
 
-		fout << out.c_str();
-		fout.close();
+		if (description.CircleCollider)
+		{
+			entity.AddComponent<Components::CircleCollider2d>(*description.CircleCollider);
+		}
 	}
 
-	void SceneSerializer::SerializeRuntime(const std::string& filePath)
+	void SceneSerializer::LinkChildren(const std::vector<std::pair<UUID, std::vector<UUID>>>& parents, bool worldSpaceChildren)
+	{
+		AC_PROFILE_FUNCTION();
+		// Children of older scenes are in world space, remember their world matrices before they get parented
+		std::vector<std::pair<Entity, glm::mat4>> worldMatrices;
+
+		for (auto& [parentId, children] : parents)
+		{
+			Entity parent = m_Scene->GetEntity(parentId);
+			auto& childRelationship = parent.AddComponent<Components::ChildRelationship>();
+
+			for (auto& childId : children)
+			{
+				Entity child = m_Scene->GetEntity(childId);
+				if (worldSpaceChildren)
+				{
+					worldMatrices.emplace_back(child, child.GetComponent<Components::Transform>().GetTransform());
+				}
+				childRelationship.AddEntity(parent, child, m_Scene);
+			}
+		}
+
+		// A parent has to be converted before its children, so apply the world matrices root first
+		std::sort(worldMatrices.begin(), worldMatrices.end(), [](auto& a, auto& b)
+			{
+				return GetDepth(a.first) < GetDepth(b.first);
+			});
+		for (auto& [child, worldMatrix] : worldMatrices)
+		{
+			child.SetWorldTransform(worldMatrix);
+		}
+	}
+
+	void SceneSerializer::SetChildren(Entity parent, const std::vector<UUID>& children)
 	{
-		AC_CORE_ASSERT(false, "Not implemented");
+		AC_PROFILE_FUNCTION();
+		if (parent.HasComponent<Components::ChildRelationship>())
+		{
+			std::unordered_set<UUID> kept(children.begin(), children.end());
+			auto& childRelationship = parent.GetComponent<Components::ChildRelationship>();
+
+			// RemoveEntity edits the list, so walk a copy
+			auto current = childRelationship.Entities;
+			for (Entity child : current)
+			{
+				if (kept.find(child.GetUUID()) == kept.end())
+					childRelationship.RemoveEntity(child);
+			}
+
+			if (children.empty())
+				parent.RemoveComponent<Components::ChildRelationship>();
+		}
+
+		if (children.empty())
+			return;
+
+		if (!parent.HasComponent<Components::ChildRelationship>())
+			parent.AddComponent<Components::ChildRelationship>();
+
+		auto& childRelationship = parent.GetComponent<Components::ChildRelationship>();
+		for (const UUID& childId : children)
+		{
+			Entity child = m_Scene->GetEntity(childId);
+			if (child && !childRelationship.Contains(childId))
+				childRelationship.AddEntity(parent, child, m_Scene);
+		}
+	}
+
+	bool SceneSerializer::DeserializeChanges(const std::string& record)
+	{
+		AC_PROFILE_FUNCTION();
+		try
+		{
+			YAML::Node root = YAML::Load(record);
+
+			for (auto id : root["Destroyed"])
+			{
+				Entity entity = m_Scene->GetEntity(id.as<UUID>());
+				if (entity)
+					m_Scene->DestroyEntity(entity);
+			}
+
+			// Children can be in the same record as their parent, so the hierarchy is applied once all of them exist
+			std::vector<std::pair<Entity, std::vector<UUID>>> parents;
+			for (auto node : root["Changed"])
+			{
+				EntityDescription description = ParseEntity(node);
+
+				Entity entity = m_Scene->GetEntity(description.Id);
+				if (!entity)
+				{
+					entity = AddEntity(description);
+				}
+				else
+				{
+					// Records only list the components an entity has, so the others have to go
+					Components::SerializedComponents::ForEach([&](auto type)
+						{
+							using Component = typename decltype(type)::type;
+							constexpr bool always = std::is_same_v<Component, Components::Tag> ||
+													std::is_same_v<Component, Components::Transform> ||
+													std::is_same_v<Component, Components::ChildRelationship>;
+							if constexpr (!always)
+							{
+								if (entity.HasComponent<Component>())
+									entity.RemoveComponent<Component>();
+							}
+						});
+
+					if (!description.Name.empty())
+						entity.GetComponent<Components::Tag>().TagName = description.Name;
+					entity.GetComponent<Components::Transform>() = description.Transform;
+					AddComponents(entity, description);
+				}
+
+				parents.emplace_back(entity, std::move(description.Children));
+			}
+
+			for (auto& [parent, children] : parents)
+			{
+				SetChildren(parent, children);
+			}
+		}
+		catch (const YAML::Exception& e)
+		{
+			AC_CORE_WARN("Failed to apply scene changes: {}", e.what());
+			return false;
+		}
+
+		return true;
 	}
 
 	bool SceneSerializer::Deserialize(const std::string& filePath)
 	{
 		AC_PROFILE_FUNCTION();
 		// TODO error handling
-		std::ifstream fin(filePath);
-		std::stringstream buffer;
-		buffer << fin.rdbuf();
+		Utils::MappedFile file(filePath);
+		if (!file.IsOpen())
+			return false;
 
-		YAML::Node root = YAML::Load(buffer.str());
+		// yaml-cpp needs a null terminated copy, but that is the only one
+		YAML::Node root = YAML::Load(std::string(file.GetData(), file.GetSize()));
+		file.Close();
 		if (!root["Scene"])
 			return false;
 
@@ -423,147 +999,505 @@ namespace Acorn
 		auto entities = root["Entities"];
 		if (entities)
 		{
-			std::unordered_map<Entity, std::vector<UUID>> parentMap;
+			m_Scene->m_EntityMap.reserve(m_Scene->m_EntityMap.size() + entities.size());
+
+			std::vector<std::pair<UUID, std::vector<UUID>>> parents;
 			for (auto entity : entities)
 			{
-				// uint64_t uuid = entity["Entity"].as<uint64_t>();
-				// uint64_t uuid = 0;
-				std::string uuid = entity["Entity"].as<std::string>();
+				EntityDescription description;
+				try
+				{
+					description = ParseEntity(entity);
+				}
+				catch (const YAML::Exception& e)
+				{
+					AC_CORE_WARN("Failed to deserialize scene {}: {}", filePath, e.what());
+					return false;
+				}
+				AddEntity(description);
 
-				std::string name;
-				auto tagComponent = entity["Tag"];
-				if (tagComponent)
+				if (!description.Children.empty())
 				{
-					name = tagComponent["Tag"].as<std::string>();
+					parents.emplace_back(description.Id, std::move(description.Children));
 				}
+			}
 
-				AC_CORE_TRACE("Deserialized entity [id = {}, name = {}]", uuid, name);
+			LinkChildren(parents, !root["Transforms"]);
+		}
 
-				Entity deserializedEntity = m_Scene->CreateEntity(name, uuid);
+		return true;
+	}
 
-				auto transformComponent = entity["Transform"];
+	/**
+	 * @brief Reads the entity column of a block and rejects entities that already had a row of the same block type.
+	 *
+	 * @param blockTypes
+	 *  One bit per block type for every entity, marks the blocks an entity had a row in so far.
+	 */
+	static bool ReadRows(Binary::Reader& reader, Binary::BlockType type, uint32_t count, const std::vector<entt::entity>& entities,
+		std::vector<uint64_t>& blockTypes, std::vector<entt::entity>& rowEntities)
+	{
+		static_assert((uint32_t)Binary::BlockType::Generation < 64, "Block types have to fit the bits of blockTypes");
+		auto rows = reader.ViewColumn<uint32_t>(count);
 
-				if (transformComponent)
-				{
-					// Entities always have a transform component
-					auto& tc = deserializedEntity.GetComponent<Components::Transform>();
-					tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-					tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-					tc.Scale = transformComponent["Scale"].as<glm::vec3>();
-				}
+		uint64_t typeBit = 1ull << (uint32_t)type;
+		rowEntities.resize(rows.size());
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			// A component can only be added once, so a duplicate row would assert in entt
+			if (rows[i] >= entities.size() || (blockTypes[rows[i]] & typeBit))
+				return false;
 
-				auto cameraComponent = entity["Camera"];
-				if (cameraComponent)
-				{
-					auto& cc = deserializedEntity.AddComponent<Components::CameraComponent>();
+			blockTypes[rows[i]] |= typeBit;
+			rowEntities[i] = entities[rows[i]];
+		}
+		return reader.IsValid();
+	}
 
-					auto cameraProps = cameraComponent["SceneCamera"];
-					// TODO serialize as string
-					cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["Type"].as<int>());
+	/**
+	 * @brief Walks up the parent of every entity, a hierarchy read from a file could loop back on itself.
+	 *
+	 * Each entity has at most one parent, so a chain either ends at a root or runs into a loop.
+	 */
+	static bool HasParentCycle(const entt::registry& registry, const std::vector<entt::entity>& entities)
+	{
+		enum class Visit : uint8_t
+		{
+			None,
+			OnChain,
+			Done
+		};
 
-					cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-					cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNearClip"].as<float>());
-					cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFarClip"].as<float>());
+		size_t indexCount = 0;
+		for (entt::entity entity : entities)
+		{
+			indexCount = std::max(indexCount, (size_t)entt::to_entity(entity) + 1);
+		}
 
-					cc.Camera.SetPerspectiveFov(cameraProps["PerspectiveFov"].as<float>());
-					cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNearClip"].as<float>());
-					cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFarClip"].as<float>());
+		std::vector<Visit> visits(indexCount, Visit::None);
+		std::vector<entt::entity> chain;
+		for (entt::entity entity : entities)
+		{
+			entt::entity current = entity;
+			while (visits[entt::to_entity(current)] == Visit::None)
+			{
+				visits[entt::to_entity(current)] = Visit::OnChain;
+				chain.push_back(current);
 
-					cc.Primary = cameraComponent["Primary"].as<bool>();
-					cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
-				}
+				const auto* parent = registry.try_get<Components::ParentRelationship>(current);
+				if (parent == nullptr)
+					break;
+				current = parent->Parent;
+			}
 
-				auto spriteRendererComponent = entity["SpriteRenderer"];
-				if (spriteRendererComponent)
-				{
-					auto& sr = deserializedEntity.AddComponent<Components::SpriteRenderer>();
+			if (visits[entt::to_entity(current)] == Visit::OnChain && registry.all_of<Components::ParentRelationship>(current))
+				return true;
 
-					sr.Color = spriteRendererComponent["Color"].as<glm::vec4>();
-				}
+			for (entt::entity visited : chain)
+			{
+				visits[entt::to_entity(visited)] = Visit::Done;
+			}
+			chain.clear();
+		}
+		return false;
+	}
 
-				auto circleRendererComponent = entity["CircleRenderer"];
-				if (circleRendererComponent)
-				{
-					auto& cr = deserializedEntity.AddComponent<Components::CircleRenderer>();
+	bool SceneSerializer::DeserializeRuntime(const std::string& filePath)
+	{
+		uint64_t generation;
+		return DeserializeRuntime(filePath, generation);
+	}
 
-					cr.Color = circleRendererComponent["Color"].as<glm::vec4>();
-					cr.Thickness = circleRendererComponent["Thickness"].as<float>();
-					cr.Fade = circleRendererComponent["Fade"].as<float>();
-				}
+	bool SceneSerializer::DeserializeRuntime(const std::string& filePath, uint64_t& generation)
+	{
+		AC_PROFILE_FUNCTION();
+		generation = 0;
+		// Columns are read straight from the mapped pages, nothing is copied up front
+		Utils::MappedFile file(filePath);
+		if (!file.IsOpen())
+			return false;
 
-#ifndef NO_SCRIPTING
-				auto jsScriptComponent = entity["JSScript"];
-				if (jsScriptComponent)
-				{
-					auto& jsScript = deserializedEntity.AddComponent<Components::JSScript>();
+		Binary::Reader reader(file.GetData(), file.GetSize());
+		auto header = reader.Read<Binary::FileHeader>();
+		if (!reader.IsValid() || std::memcmp(header.Magic, Binary::SceneMagic, sizeof(header.Magic)) != 0)
+		{
+			AC_CORE_WARN("{} is not a binary scene", filePath);
+			return false;
+		}
+		if (header.Version != Binary::SceneVersion)
+		{
+			AC_CORE_WARN("Binary scene {} has version {}, expected {}", filePath, header.Version, Binary::SceneVersion);
+			return false;
+		}
 
-					jsScript.LoadScript(deserializedEntity, jsScriptComponent["Path"].as<std::string>());
-				}
-#endif // !NO_SCRIPT
+		auto& registry = m_Scene->m_Registry;
+		std::vector<entt::entity> entities;
+		std::vector<entt::entity> rowEntities;
+		std::vector<uint64_t> blockTypes;
 
-				auto rigidBodyComponent = entity["RigidBody2d"];
-				if (rigidBodyComponent)
-				{
-					auto& rb = deserializedEntity.AddComponent<Components::RigidBody2d>();
+		// Strings are referenced by index and the table comes last, so resolve them after all blocks are read
+		std::vector<std::string_view> strings;
+		std::vector<std::pair<entt::entity, uint32_t>> tags;
+		std::vector<std::pair<entt::entity, uint32_t>> textures;
+		std::vector<std::pair<entt::entity, uint32_t>> scripts;
 
-					rb.FixedRotation = rigidBodyComponent["FixedRotation"].as<bool>();
-					rb.Type = magic_enum::enum_cast<Components::RigidBody2d::BodyType>(rigidBodyComponent["Type"].as<std::string>()).value_or(Components::RigidBody2d::BodyType::Static);
+		for (uint32_t block = 0; block < header.BlockCount; block++)
+		{
+			auto blockHeader = reader.Read<Binary::BlockHeader>();
+			size_t blockStart = reader.GetPosition();
+			uint32_t count = blockHeader.Count;
+			if (!reader.IsValid() || blockHeader.Size > reader.GetSize() - blockStart)
+				return false;
 
-					rb.Density = rigidBodyComponent["Density"].as<float>();
-					rb.Friction = rigidBodyComponent["Friction"].as<float>();
-					rb.Restitution = rigidBodyComponent["Restitution"].as<float>();
-					rb.RestitutionThreshold = rigidBodyComponent["RestitutionThreshold"].as<float>();
-				}
+			// Columns can not reach into the next block, whatever the count claims
+			reader.BeginBlock(blockHeader.Size);
 
-				auto boxColliderComponent = entity["BoxCollider2d"];
-				if (boxColliderComponent)
-				{
-					auto& bc = deserializedEntity.AddComponent<Components::BoxCollider2d>();
+			if (blockHeader.Type != Binary::BlockType::Entities && blockHeader.Type != Binary::BlockType::Strings &&
+				entities.size() != header.EntityCount)
+			{
+				AC_CORE_WARN("Binary scene {} does not start with its entities", filePath);
+				return false;
+			}
 
-					bc.SetSize(boxColliderComponent["Size"].as<glm::vec2>());
-					bc.SetOffset(boxColliderComponent["Offset"].as<glm::vec2>());
+			switch (blockHeader.Type)
+			{
+				case Binary::BlockType::Entities:
+				{
+					auto high = reader.ViewColumn<uint64_t>(count);
+					auto low = reader.ViewColumn<uint64_t>(count);
+					if (!reader.IsValid() || count != header.EntityCount || !entities.empty())
+						return false;
+
+					std::vector<UUID> uuids;
+					std::unordered_set<UUID> uniqueIds;
+					uuids.reserve(count);
+					uniqueIds.reserve(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						// Two entities with one id would leave the UUID index pointing at only one of them
+						const UUID& uuid = uuids.emplace_back(high[i], low[i]);
+						if (!uniqueIds.insert(uuid).second || m_Scene->m_EntityMap.contains(uuid))
+						{
+							AC_CORE_WARN("Binary scene {} has more than one entity with id {}", filePath, (std::string)uuid);
+							return false;
+						}
+					}
+					m_Scene->CreateEntities(uuids, entities);
+					blockTypes.resize(entities.size());
+					break;
 				}
+				case Binary::BlockType::Strings:
+				{
+					// Widened, a count of 0xffffffff must not wrap to an empty column
+					auto offsets = reader.ViewColumn<uint32_t>((uint64_t)count + 1);
+					if (!reader.IsValid() || offsets.back() > blockHeader.Size)
+						return false;
+
+					std::string_view bytes = reader.ReadBytes(offsets.back());
+					strings.reserve(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						if (offsets[i] > offsets[i + 1])
+							return false;
 
-				auto circleColliderComponent = entity["CircleCollider2d"];
-				if (circleColliderComponent)
+						strings.push_back(bytes.substr(offsets[i], offsets[i + 1] - offsets[i]));
+					}
+					break;
+				}
+				case Binary::BlockType::Tag:
 				{
-					auto& cc = deserializedEntity.AddComponent<Components::CircleCollider2d>();
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto names = reader.ViewColumn<uint32_t>(count);
 
-					cc.SetRadius(circleColliderComponent["Radius"].as<float>());
-					cc.SetOffset(circleColliderComponent["Offset"].as<glm::vec2>());
+					for (size_t i = 0; i < names.size(); i++)
+					{
+						tags.emplace_back(rowEntities[i], names[i]);
+					}
+					break;
+				}
+				case Binary::BlockType::Transform:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto translations = reader.ViewColumn<glm::vec3>(count);
+					auto rotations = reader.ViewColumn<glm::vec3>(count);
+					auto scales = reader.ViewColumn<glm::vec3>(count);
+					if (!reader.IsValid())
+						return false;
+
+					for (uint32_t i = 0; i < count; i++)
+					{
+						registry.get<Components::Transform>(rowEntities[i]) = Components::Transform(translations[i], rotations[i], scales[i]);
+					}
+					break;
+				}
+				case Binary::BlockType::Camera:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto types = reader.ViewColumn<int32_t>(count);
+					auto orthographicSizes = reader.ViewColumn<float>(count);
+					auto orthographicNearClips = reader.ViewColumn<float>(count);
+					auto orthographicFarClips = reader.ViewColumn<float>(count);
+					auto fovs = reader.ViewColumn<float>(count);
+					auto perspectiveNearClips = reader.ViewColumn<float>(count);
+					auto perspectiveFarClips = reader.ViewColumn<float>(count);
+					auto primaries = reader.ViewColumn<uint8_t>(count);
+					auto fixedAspectRatios = reader.ViewColumn<uint8_t>(count);
+					if (!reader.IsValid())
+						return false;
+
+					// Few cameras and they need the viewport size, so they go through AddComponent
+					for (uint32_t i = 0; i < count; i++)
+					{
+						Entity entity = {rowEntities[i], m_Scene.get()};
+						if (entity.HasComponent<Components::CameraComponent>())
+							return false;
+
+						auto& cc = entity.AddComponent<Components::CameraComponent>();
+						cc.Camera.SetProjectionType((SceneCamera::ProjectionType)types[i]);
+						cc.Camera.SetOrthographicSize(orthographicSizes[i]);
+						cc.Camera.SetOrthographicNearClip(orthographicNearClips[i]);
+						cc.Camera.SetOrthographicFarClip(orthographicFarClips[i]);
+						cc.Camera.SetPerspectiveFov(fovs[i]);
+						cc.Camera.SetPerspectiveNearClip(perspectiveNearClips[i]);
+						cc.Camera.SetPerspectiveFarClip(perspectiveFarClips[i]);
+						cc.Primary = primaries[i] != 0;
+						cc.FixedAspectRatio = fixedAspectRatios[i] != 0;
+					}
+					break;
 				}
+				case Binary::BlockType::SpriteRenderer:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto colors = reader.ViewColumn<glm::vec4>(count);
+					auto tilingFactors = reader.ViewColumn<float>(count);
+					auto texturePaths = reader.ViewColumn<uint32_t>(count);
+					if (!reader.IsValid())
+						return false;
+
+					std::vector<Components::SpriteRenderer> sprites(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						sprites[i].Color = colors[i];
+						sprites[i].TilingFactor = tilingFactors[i];
+						if (texturePaths[i] != Binary::NoString)
+						{
+							textures.emplace_back(rowEntities[i], texturePaths[i]);
+						}
+					}
+					registry.insert<Components::SpriteRenderer>(rowEntities.begin(), rowEntities.end(), sprites.begin());
+					break;
+				}
+				case Binary::BlockType::CircleRenderer:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto colors = reader.ViewColumn<glm::vec4>(count);
+					auto thicknesses = reader.ViewColumn<float>(count);
+					auto fades = reader.ViewColumn<float>(count);
+					if (!reader.IsValid())
+						return false;
+
+					std::vector<Components::CircleRenderer> circles(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						circles[i].Color = colors[i];
+						circles[i].Thickness = thicknesses[i];
+						circles[i].Fade = fades[i];
+					}
+					registry.insert<Components::CircleRenderer>(rowEntities.begin(), rowEntities.end(), circles.begin());
+					break;
+				}
+				case Binary::BlockType::JSScript:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto paths = reader.ViewColumn<uint32_t>(count);
 
-				auto childRelationship = entity["Children"];
-				if (childRelationship)
+					for (size_t i = 0; i < paths.size(); i++)
+					{
+						scripts.emplace_back(rowEntities[i], paths[i]);
+					}
+					break;
+				}
+				case Binary::BlockType::RigidBody2d:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto types = reader.ViewColumn<uint8_t>(count);
+					auto fixedRotations = reader.ViewColumn<uint8_t>(count);
+					auto densities = reader.ViewColumn<float>(count);
+					auto frictions = reader.ViewColumn<float>(count);
+					auto restitutions = reader.ViewColumn<float>(count);
+					auto restitutionThresholds = reader.ViewColumn<float>(count);
+					if (!reader.IsValid())
+						return false;
+
+					std::vector<Components::RigidBody2d> rigidBodies(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						rigidBodies[i].Type = (Components::RigidBody2d::BodyType)types[i];
+						rigidBodies[i].FixedRotation = fixedRotations[i] != 0;
+						rigidBodies[i].Density = densities[i];
+						rigidBodies[i].Friction = frictions[i];
+						rigidBodies[i].Restitution = restitutions[i];
+						rigidBodies[i].RestitutionThreshold = restitutionThresholds[i];
+					}
+					registry.insert<Components::RigidBody2d>(rowEntities.begin(), rowEntities.end(), rigidBodies.begin());
+					break;
+				}
+				case Binary::BlockType::BoxCollider2d:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto sizes = reader.ViewColumn<glm::vec2>(count);
+					auto offsets = reader.ViewColumn<glm::vec2>(count);
+					if (!reader.IsValid())
+						return false;
+
+					std::vector<Components::BoxCollider2d> colliders;
+					colliders.reserve(count);
+					for (uint32_t i = 0; i < count; i++)
+					{
+						colliders.emplace_back(offsets[i], sizes[i]);
+					}
+					registry.insert<Components::BoxCollider2d>(rowEntities.begin(), rowEntities.end(), colliders.begin());
+					break;
+				}
+				case Binary::BlockType::CircleCollider2d:
 				{
-					// parentMap[deserializedEntity] = childRelationship.as<std::vector<UUID>>();
-					parentMap[deserializedEntity] = std::vector<UUID>();
-					for (auto child : childRelationship)
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto radii = reader.ViewColumn<float>(count);
+					auto offsets = reader.ViewColumn<glm::vec2>(count);
+					if (!reader.IsValid())
+						return false;
+
+					std::vector<Components::CircleCollider2d> colliders;
+					colliders.reserve(count);
+					for (uint32_t i = 0; i < count; i++)
 					{
-						parentMap[deserializedEntity].push_back(child.as<std::string>());
+						colliders.emplace_back(offsets[i], radii[i]);
 					}
+					registry.insert<Components::CircleCollider2d>(rowEntities.begin(), rowEntities.end(), colliders.begin());
+					break;
 				}
+				case Binary::BlockType::Children:
+				{
+					if (!ReadRows(reader, blockHeader.Type, count, entities, blockTypes, rowEntities))
+						return false;
+					auto offsets = reader.ViewColumn<uint32_t>((uint64_t)count + 1);
+					if (!reader.IsValid())
+						return false;
+					auto children = reader.ViewColumn<uint32_t>(offsets.back());
+					if (!reader.IsValid())
+						return false;
+
+					// The file stores resolved indices, so there is no UUID lookup per child
+					for (uint32_t i = 0; i < count; i++)
+					{
+						if (offsets[i] > offsets[i + 1])
+							return false;
+
+						Entity parent = {rowEntities[i], m_Scene.get()};
+						if (registry.all_of<Components::ChildRelationship>(parent))
+							return false;
+
+						auto& relationship = registry.emplace<Components::ChildRelationship>(parent);
+						relationship.Entities.reserve(offsets[i + 1] - offsets[i]);
+						for (uint32_t c = offsets[i]; c < offsets[i + 1]; c++)
+						{
+							// A child listed twice, under two parents or under itself
+							if (children[c] >= entities.size() || entities[children[c]] == rowEntities[i] ||
+								registry.all_of<Components::ParentRelationship>(entities[children[c]]))
+								return false;
+
+							Entity child = {entities[children[c]], m_Scene.get()};
+							relationship.Entities.push_back(child);
+							relationship.EntityIds.insert(child.GetUUID());
+							registry.emplace<Components::ParentRelationship>(child, parent);
+						}
+					}
+
+					// Rows that are fine on their own can still link up in a loop, e.g. A -> B and B -> A
+					if (HasParentCycle(registry, entities))
+					{
+						AC_CORE_WARN("The hierarchy of binary scene {} loops back on itself", filePath);
+						return false;
+					}
+					break;
+				}
+				case Binary::BlockType::Generation:
+				{
+					generation = reader.Read<uint64_t>();
+					break;
+				}
+				default:
+					AC_CORE_TRACE("Skipping unknown block {} in {}", (uint32_t)blockHeader.Type, filePath);
+					break;
 			}
 
-			for (auto& [parent, children] : parentMap)
+			if (!reader.IsValid())
+				return false;
+
+			reader.EndBlock();
+			reader.Seek((blockStart + blockHeader.Size + Binary::BlockAlignment - 1) & ~(Binary::BlockAlignment - 1));
+
+			// Everything but the strings has been copied into components, so the pages of the block can go
+			if (blockHeader.Type != Binary::BlockType::Strings)
 			{
-				Entity p = parent;
-				auto& childRelationship = p.AddComponent<Components::ChildRelationship>();
+				file.Release(blockStart - sizeof(Binary::BlockHeader), reader.GetPosition() - blockStart + sizeof(Binary::BlockHeader));
+			}
+		}
 
-				for (auto child : children)
-				{
-					Entity c = m_Scene->GetEntity(child);
-					childRelationship.AddEntity(p, c, m_Scene);
-				}
+		auto getString = [&](uint32_t index) -> std::optional<std::string_view>
+		{
+			if (index >= strings.size())
+				return std::nullopt;
+			return strings[index];
+		};
+
+		for (auto& [entity, name] : tags)
+		{
+			auto string = getString(name);
+			if (!string)
+				return false;
+			registry.get<Components::Tag>(entity).TagName = *string;
+		}
+
+		// Paths are interned, so sprites sharing a texture share the index and the texture is only loaded once
+		std::unordered_map<uint32_t, Ref<Texture2d>> loadedTextures;
+		for (auto& [entity, path] : textures)
+		{
+			auto string = getString(path);
+			if (!string)
+				return false;
+
+			auto& texture = loadedTextures[path];
+			if (!texture)
+			{
+				texture = Texture2d::Create(std::string(*string));
 			}
+			registry.get<Components::SpriteRenderer>(entity).Texture = texture;
 		}
 
-		return true;
-	}
+#ifndef NO_SCRIPTING
+		for (auto& [entity, path] : scripts)
+		{
+			Entity scriptEntity = {entity, m_Scene.get()};
+			auto& jsScript = scriptEntity.AddComponent<Components::JSScript>();
 
-	bool SceneSerializer::DeserializeRuntime(const std::string& filePath)
-	{
-		AC_CORE_ASSERT(false, "Not implemented");
-		return false;
+			auto string = getString(path);
+			if (string)
+			{
+				jsScript.LoadScript(scriptEntity, std::string(*string));
+			}
+		}
+#endif // !NO_SCRIPTING
+
+		return reader.IsValid();
 	}
 }
\ No newline at end of file
@@ -1,22 +1,119 @@
 #pragma once
 
 #include "core/Core.h"
+#include "core/UUID.h"
 #include "ecs/Scene.h"
+#include "ecs/components/Components.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace YAML
+{
+	class Node;
+}
 
 namespace Acorn
 {
+	/**
+	 * @brief Components of one entity as read from a scene file, before they are added to a scene.
+	 *
+	 * Holds no engine resources, so it can be filled on any thread.
+	 */
+	struct EntityDescription
+	{
+		UUID Id;
+		std::string Name;
+		Components::Transform Transform;
+		std::optional<Components::CameraComponent> Camera;
+		std::optional<Components::SpriteRenderer> Sprite;
+		// Empty for sprites without a texture
+		std::string TexturePath;
+		std::optional<Components::CircleRenderer> Circle;
+		std::optional<std::string> ScriptPath;
+		std::optional<Components::RigidBody2d> RigidBody;
+		std::optional<Components::BoxCollider2d> BoxCollider;
+		std::optional<Components::CircleCollider2d> CircleCollider;
+		std::vector<UUID> Children;
+	};
+
 	class SceneSerializer
 	{
+	public:
+		using TextureRequestFn = std::function<void(Entity entity, const std::string& path)>;
+
 	public:
 		SceneSerializer(const Ref<Scene>& scene);
 
 		void Serialize(const std::string& filePath);
 		void SerializeRuntime(const std::string& filePath);
+		/**
+		 * @param generation
+		 *  Stored along with the scene if not 0, the autosave journal uses it to match its records to the snapshot.
+		 */
+		void SerializeRuntime(const std::string& filePath, uint64_t generation);
 
 		bool Deserialize(const std::string& filePath);
 		bool DeserializeRuntime(const std::string& filePath);
+		/**
+		 * @param generation
+		 *  Receives the generation the file was written with, 0 if it has none.
+		 */
+		bool DeserializeRuntime(const std::string& filePath, uint64_t& generation);
+
+		/**
+		 * @brief Writes the current state of the changed entities and the ids of the destroyed ones as one YAML
+		 * document, used as a record of the autosave journal.
+		 */
+		std::string SerializeChanges(const std::vector<Entity>& changed, const std::vector<UUID>& destroyed);
+
+		/**
+		 * @brief Applies a record written by SerializeChanges to the scene.
+		 *
+		 * Records hold whole entities, so applying one twice has no further effect.
+		 */
+		bool DeserializeChanges(const std::string& record);
+
+	private:
+		friend class SceneLoader;
+
+		/**
+		 * @brief Reads one entity of a YAML scene, does not touch the scene so it is safe on any thread.
+		 *
+		 * Throws a YAML::Exception if the entity id is not a valid UUID, the same way a malformed component does.
+		 */
+		static EntityDescription ParseEntity(const YAML::Node& entity);
+
+		/**
+		 * @brief Creates the entity with its components, children are added by LinkChildren.
+		 *
+		 * @param requestTexture
+		 *  Called for sprites with a texture instead of loading it right away.
+		 */
+		Entity AddEntity(EntityDescription& description, const TextureRequestFn& requestTexture = {});
+
+		/**
+		 * @brief Adds the optional components of a description, which the entity must not have yet.
+		 */
+		void AddComponents(Entity entity, EntityDescription& description, const TextureRequestFn& requestTexture = {});
+
+		/**
+		 * @brief Makes the children of a parent exactly the given ones, without touching their local transforms.
+		 */
+		void SetChildren(Entity parent, const std::vector<UUID>& children);
+
+		/**
+		 * @param parents
+		 *  Every parent with its children, all of them have to be in the scene already.
+		 * @param worldSpaceChildren
+		 *  Children are stored in world space, like in scenes written before transforms were local.
+		 */
+		void LinkChildren(const std::vector<std::pair<UUID, std::vector<UUID>>>& parents, bool worldSpaceChildren);
 
 	private:
 		Ref<Scene> m_Scene;
 	};
-}
\ No newline at end of file
+}
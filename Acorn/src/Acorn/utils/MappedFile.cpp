@@ -0,0 +1,124 @@
+#include "acpch.h"
+
+#include "utils/MappedFile.h"
+
+#ifndef AC_PLATFORM_WINDOWS
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif // !AC_PLATFORM_WINDOWS
+
+namespace Acorn::Utils
+{
+#ifdef AC_PLATFORM_WINDOWS
+	MappedFile::MappedFile(const std::string& filePath)
+	{
+		AC_PROFILE_FUNCTION();
+		HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			// The mapping keeps the file open, the handle is not needed afterwards
+			m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_Mapping)
+			{
+				m_Data = (const char*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+				m_Size = m_Data ? (size_t)size.QuadPart : 0;
+			}
+		}
+		CloseHandle(file);
+	}
+
+	void MappedFile::Release(size_t offset, size_t size)
+	{
+		// Windows trims the pages of a read only view on its own when memory gets tight
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_Mapping)
+			CloseHandle(m_Mapping);
+
+		m_Data = nullptr;
+		m_Mapping = nullptr;
+		m_Size = 0;
+	}
+#else
+	MappedFile::MappedFile(const std::string& filePath)
+	{
+		AC_PROFILE_FUNCTION();
+		int file = open(filePath.c_str(), O_RDONLY);
+		if (file < 0)
+			return;
+
+		struct stat status;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (data != MAP_FAILED)
+			{
+				// Scenes are read front to back, so aggressive read ahead pays off
+				madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+				m_Data = (const char*)data;
+				m_Size = (size_t)status.st_size;
+			}
+		}
+		// The mapping keeps the file alive, the descriptor is not needed afterwards
+		close(file);
+	}
+
+	void MappedFile::Release(size_t offset, size_t size)
+	{
+		if (!m_Data || offset >= m_Size)
+			return;
+
+		// Only whole pages inside the range can be dropped
+		size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+		size_t begin = (offset + pageSize - 1) & ~(pageSize - 1);
+		size_t end = std::min(offset + size, m_Size) & ~(pageSize - 1);
+		if (begin < end)
+		{
+			madvise((void*)(m_Data + begin), end - begin, MADV_DONTNEED);
+		}
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap((void*)m_Data, m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+#endif // AC_PLATFORM_WINDOWS
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			std::swap(m_Data, other.m_Data);
+			std::swap(m_Size, other.m_Size);
+#ifdef AC_PLATFORM_WINDOWS
+			std::swap(m_Mapping, other.m_Mapping);
+#endif
+		}
+		return *this;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <cstddef>
+#include <string>
+
+namespace Acorn::Utils
+{
+	/**
+	 * @brief Read only view of a whole file, mapped into memory instead of copied.
+	 *
+	 * Pages are only read from disk when they are first touched, so large files cost nothing up front.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		/**
+		 * @param filePath
+		 *  File to map, check IsOpen() to see if that worked. Empty files can not be mapped.
+		 */
+		MappedFile(const std::string& filePath);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		inline bool IsOpen() const { return m_Data != nullptr; }
+		inline const char* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+
+		/**
+		 * @brief Tells the OS that a range is not needed anymore, so its pages can be dropped from memory.
+		 *
+		 * The data stays valid, touching it again reads it back from disk.
+		 */
+		void Release(size_t offset, size_t size);
+
+		void Close();
+
+	private:
+		const char* m_Data = nullptr;
+		size_t m_Size = 0;
+#ifdef AC_PLATFORM_WINDOWS
+		void* m_Mapping = nullptr;
+#endif
+	};
+}
@@ -13,10 +13,19 @@ namespace Acorn
 			return s_Instance->GetMaxTextureUnits_();
 		}
 
+		/**
+		 * @brief Whether buffers can stay mapped while the GPU reads from them (persistent, coherent mapping).
+		 */
+		static bool SupportsPersistentMapping()
+		{
+			return s_Instance->SupportsPersistentMapping_();
+		}
+
 		static void Init();
 
 	protected:
 		virtual uint32_t GetMaxTextureUnits_() = 0;
+		virtual bool SupportsPersistentMapping_() = 0;
 
 	private:
 		static PlatformCapabilities* s_Instance;
@@ -0,0 +1,133 @@
+#include "acpch.h"
+
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Acorn::Utils
+{
+	ThreadPool::ThreadPool(uint32_t workerCount)
+	{
+		AC_PROFILE_FUNCTION();
+
+		m_Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Condition.notify_all();
+
+		for (std::thread& worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	uint32_t ThreadPool::DefaultWorkerCount()
+	{
+		uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	ThreadPool& ThreadPool::Get()
+	{
+		static ThreadPool s_Pool;
+		return s_Pool;
+	}
+
+	void ThreadPool::ParallelFor(uint32_t count, uint32_t minRangeSize, const RangeFn& fn)
+	{
+		AC_PROFILE_FUNCTION();
+
+		if (count == 0)
+			return;
+
+		minRangeSize = std::max(minRangeSize, 1u);
+		if (m_Workers.empty() || count <= minRangeSize)
+		{
+			fn(0, count);
+			return;
+		}
+
+		std::lock_guard<std::mutex> submitLock(m_SubmitMutex);
+
+		// A few ranges per thread, so uneven ranges still balance out
+		uint32_t threadCount = GetWorkerCount() + 1;
+		uint32_t rangeSize = std::max(minRangeSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+
+		auto job = std::make_shared<Job>();
+		job->Fn = &fn;
+		job->Count = count;
+		job->RangeSize = rangeSize;
+		job->RangeCount = (count + rangeSize - 1) / rangeSize;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Job = job;
+		}
+		m_Condition.notify_all();
+
+		RunRanges(*job);
+
+		// Only ranges already running on workers are left, block instead of spinning until they finish
+		{
+			std::unique_lock<std::mutex> lock(job->DoneMutex);
+			job->Done.wait(lock, [&]()
+				{ return job->RangesDone.load(std::memory_order_acquire) == job->RangeCount; });
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job.reset();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		std::shared_ptr<Job> lastJob;
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [&]()
+					{ return m_Stopping || (m_Job && m_Job != lastJob); });
+
+				if (m_Stopping)
+					return;
+
+				job = m_Job;
+			}
+
+			RunRanges(*job);
+			lastJob = std::move(job);
+		}
+	}
+
+	void ThreadPool::RunRanges(Job& job)
+	{
+		while (true)
+		{
+			uint32_t range = job.NextRange.fetch_add(1, std::memory_order_relaxed);
+			if (range >= job.RangeCount)
+				return;
+
+			uint32_t begin = range * job.RangeSize;
+			uint32_t end = std::min(begin + job.RangeSize, job.Count);
+			(*job.Fn)(begin, end);
+
+			if (job.RangesDone.fetch_add(1, std::memory_order_acq_rel) + 1 == job.RangeCount)
+			{
+				// Taking the lock keeps the wake up from slipping in between the caller's check and its wait
+				std::lock_guard<std::mutex> lock(job.DoneMutex);
+				job.Done.notify_all();
+			}
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "core/Core.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Acorn::Utils
+{
+	/**
+	 * @brief Fixed set of worker threads for splitting data parallel loops.
+	 */
+	class ThreadPool
+	{
+	public:
+		using RangeFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+	public:
+		/**
+		 * @param workerCount
+		 *  Number of threads besides the caller, defaults to one less than the hardware threads.
+		 */
+		ThreadPool(uint32_t workerCount = DefaultWorkerCount());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief Run fn over [0, count) split into disjoint ranges, the calling thread works as well.
+		 *
+		 * Blocks until every range is done. Ranges are handed out in order, but may run in any order on any thread.
+		 *
+		 * @param minRangeSize
+		 *  Smallest range worth the hand off, loops below this size run on the calling thread only.
+		 */
+		void ParallelFor(uint32_t count, uint32_t minRangeSize, const RangeFn& fn);
+
+		inline uint32_t GetWorkerCount() const { return (uint32_t)m_Workers.size(); }
+
+		static uint32_t DefaultWorkerCount();
+
+		/**
+		 * @brief Shared pool of the engine, created on first use.
+		 */
+		static ThreadPool& Get();
+
+	private:
+		struct Job
+		{
+			const RangeFn* Fn = nullptr;
+			uint32_t Count = 0;
+			uint32_t RangeSize = 0;
+			uint32_t RangeCount = 0;
+
+			std::atomic<uint32_t> NextRange = 0;
+			std::atomic<uint32_t> RangesDone = 0;
+
+			// The caller sleeps on this once no ranges are left to take, the thread finishing the last range wakes it
+			std::mutex DoneMutex;
+			std::condition_variable Done;
+		};
+
+		void WorkerLoop();
+		static void RunRanges(Job& job);
+
+	private:
+		std::vector<std::thread> m_Workers;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		// Workers keep their own reference, so a late worker never touches a finished job's successor
+		std::shared_ptr<Job> m_Job;
+		bool m_Stopping = false;
+
+		// Only one ParallelFor at a time
+		std::mutex m_SubmitMutex;
+	};
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2022 Michael Finger
+ *
+ * SPDX-License-Identifier: Apache-2.0 with Commons Clause
+ *
+ * For more Information on the license, see the LICENSE.md file
+ */
+
+#include "acpch.h"
+
+#include "utils/v8/V8CodeCache.h"
+
+#include "serialize/BinaryFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace Acorn
+{
+	static constexpr char IndexMagic[4] = {'A', 'C', 'C', 'C'};
+	static constexpr uint32_t IndexVersion = 1;
+	static constexpr const char* IndexFilename = "index.bin";
+	static constexpr const char* EntryExtension = ".cache";
+
+	// Hex MD5 of the source
+	static constexpr size_t HashLength = 32;
+
+	struct IndexHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t Tag;
+		uint32_t EntryCount;
+		uint64_t Clock;
+	};
+
+	struct IndexEntry
+	{
+		char Hash[HashLength];
+		uint64_t Size;
+		uint64_t LastUsed;
+	};
+
+	static_assert(sizeof(IndexHeader) == 24 && sizeof(IndexEntry) == 48, "The index is written as is");
+
+	void V8CodeCache::Open(const std::filesystem::path& directory, uint64_t maxBytes)
+	{
+		AC_PROFILE_FUNCTION();
+		m_Directory = directory;
+		m_MaxBytes = maxBytes;
+		m_Tag = v8::ScriptCompiler::CachedDataVersionTag();
+		m_Entries.clear();
+		m_Size = 0;
+		m_Clock = 0;
+		m_Stats = {};
+		m_Open = true;
+
+		std::error_code err;
+		std::filesystem::create_directories(m_Directory, err);
+
+		std::ifstream indexFile(m_Directory / IndexFilename, std::ios::binary);
+		std::string data(std::istreambuf_iterator<char>(indexFile), {});
+		Binary::Reader reader(data.data(), data.size());
+
+		IndexHeader header = reader.Read<IndexHeader>();
+		if (!reader.IsValid() || std::memcmp(header.Magic, IndexMagic, sizeof(IndexMagic)) != 0 || header.Version != IndexVersion || header.Tag != m_Tag)
+		{
+			// Clears out the entries of the old index in the project config as well, they are named the same way
+			AC_CORE_INFO("Script code cache in {} is missing or was made by another V8, starting a new one", m_Directory.string());
+			Clear();
+			return;
+		}
+
+		std::span<const IndexEntry> entries = reader.ViewColumn<IndexEntry>(header.EntryCount);
+		if (!reader.IsValid())
+		{
+			AC_CORE_WARN("Script code cache index in {} is truncated, starting a new one", m_Directory.string());
+			Clear();
+			return;
+		}
+
+		m_Clock = header.Clock;
+		for (const IndexEntry& entry : entries)
+		{
+			std::string hash(entry.Hash, HashLength);
+			// Entries can be deleted by hand, the index only knows what it wrote
+			if (!std::filesystem::exists(EntryPath(hash), err))
+				continue;
+
+			m_Entries[hash] = {entry.Size, entry.LastUsed};
+			m_Size += entry.Size;
+		}
+		RemoveUnlisted();
+		AC_CORE_TRACE("Opened script code cache with {} entries, {} KiB", m_Entries.size(), m_Size / 1024);
+	}
+
+	void V8CodeCache::Close()
+	{
+		AC_PROFILE_FUNCTION();
+		if (!m_Open)
+			return;
+
+		Evict();
+
+		std::vector<IndexEntry> entries;
+		entries.reserve(m_Entries.size());
+		for (const auto& [hash, entry] : m_Entries)
+		{
+			IndexEntry& indexEntry = entries.emplace_back();
+			std::memcpy(indexEntry.Hash, hash.data(), HashLength);
+			indexEntry.Size = entry.Size;
+			indexEntry.LastUsed = entry.LastUsed;
+		}
+
+		Binary::Writer writer;
+		IndexHeader header = {};
+		std::memcpy(header.Magic, IndexMagic, sizeof(IndexMagic));
+		header.Version = IndexVersion;
+		header.Tag = m_Tag;
+		header.EntryCount = (uint32_t)entries.size();
+		header.Clock = m_Clock;
+		writer.Write(header);
+		writer.WriteColumn(entries);
+
+		std::ofstream indexFile(m_Directory / IndexFilename, std::ios::binary | std::ios::trunc);
+		indexFile.write(writer.GetBuffer().data(), writer.GetBuffer().size());
+		if (!indexFile.good())
+			AC_CORE_ERROR("Failed to write the script code cache index to {}", m_Directory.string());
+
+		uint32_t lookups = m_Stats.Hits + m_Stats.Misses;
+		if (lookups > 0)
+		{
+			AC_CORE_INFO("[V8]: Code cache {} hits, {} misses, {} rejected, {:.0f}% hit rate, {} KiB on disk", m_Stats.Hits, m_Stats.Misses, m_Stats.Rejected,
+				m_Stats.HitRate() * 100.0f, m_Size / 1024);
+		}
+		m_Open = false;
+	}
+
+	v8::ScriptCompiler::CachedData* V8CodeCache::Find(const std::string& hash)
+	{
+		AC_PROFILE_FUNCTION();
+		auto it = m_Entries.find(hash);
+		if (it == m_Entries.end())
+		{
+			m_Stats.Misses++;
+			return nullptr;
+		}
+
+		std::ifstream entryFile(EntryPath(hash), std::ios::binary);
+		std::vector<char> data(std::istreambuf_iterator<char>(entryFile), {});
+		if (data.empty() || data.size() != it->second.Size)
+		{
+			Remove(hash);
+			m_Stats.Misses++;
+			return nullptr;
+		}
+
+		it->second.LastUsed = ++m_Clock;
+		m_Stats.Hits++;
+
+		uint8_t* buffer = new uint8_t[data.size()];
+		std::memcpy(buffer, data.data(), data.size());
+		return new v8::ScriptCompiler::CachedData(buffer, (int)data.size(), v8::ScriptCompiler::CachedData::BufferOwned);
+	}
+
+	void V8CodeCache::Reject(const std::string& hash)
+	{
+		AC_CORE_WARN("V8 rejected the cached code for {}", hash);
+		m_Stats.Rejected++;
+		Remove(hash);
+	}
+
+	void V8CodeCache::Store(const std::string& hash, const v8::ScriptCompiler::CachedData& data)
+	{
+		AC_PROFILE_FUNCTION();
+		AC_CORE_ASSERT(hash.size() == HashLength, "Code cache entries are keyed by a hex MD5");
+		if (!m_Open || hash.size() != HashLength || (uint64_t)data.length > m_MaxBytes)
+			return;
+
+		std::ofstream entryFile(EntryPath(hash), std::ios::binary | std::ios::trunc);
+		entryFile.write((const char*)data.data, data.length);
+		if (!entryFile.good())
+		{
+			AC_CORE_WARN("Failed to write {}", EntryPath(hash).string());
+			return;
+		}
+
+		// Sources with the same content share one entry
+		Entry& entry = m_Entries[hash];
+		m_Size = m_Size - entry.Size + data.length;
+		entry.Size = data.length;
+		entry.LastUsed = ++m_Clock;
+
+		Evict();
+	}
+
+	std::filesystem::path V8CodeCache::EntryPath(const std::string& hash) const
+	{
+		return m_Directory / (hash + EntryExtension);
+	}
+
+	void V8CodeCache::Remove(const std::string& hash)
+	{
+		auto it = m_Entries.find(hash);
+		if (it == m_Entries.end())
+			return;
+
+		m_Size -= it->second.Size;
+		m_Entries.erase(it);
+
+		std::error_code err;
+		std::filesystem::remove(EntryPath(hash), err);
+	}
+
+	void V8CodeCache::Evict()
+	{
+		if (m_Size <= m_MaxBytes)
+			return;
+
+		AC_PROFILE_FUNCTION();
+		std::vector<std::pair<uint64_t, std::string>> byAge;
+		byAge.reserve(m_Entries.size());
+		for (const auto& [hash, entry] : m_Entries)
+			byAge.emplace_back(entry.LastUsed, hash);
+		std::sort(byAge.begin(), byAge.end());
+
+		for (const auto& [lastUsed, hash] : byAge)
+		{
+			if (m_Size <= m_MaxBytes)
+				break;
+			AC_CORE_TRACE("Evicting {} from the script code cache", hash);
+			Remove(hash);
+		}
+	}
+
+	void V8CodeCache::Clear()
+	{
+		m_Entries.clear();
+		m_Size = 0;
+
+		// Collected first, removing files while iterating the directory is unspecified
+		std::error_code err;
+		std::vector<std::filesystem::path> files;
+		for (const auto& file : std::filesystem::directory_iterator(m_Directory, err))
+		{
+			if (file.is_regular_file() && file.path().extension() == EntryExtension)
+				files.push_back(file.path());
+		}
+		for (const std::filesystem::path& file : files)
+			std::filesystem::remove(file, err);
+	}
+
+	void V8CodeCache::RemoveUnlisted()
+	{
+		AC_PROFILE_FUNCTION();
+		std::error_code err;
+		std::vector<std::filesystem::path> files;
+		for (const auto& file : std::filesystem::directory_iterator(m_Directory, err))
+		{
+			if (file.is_regular_file() && file.path().extension() == EntryExtension && !m_Entries.contains(file.path().stem().string()))
+				files.push_back(file.path());
+		}
+
+		if (!files.empty())
+			AC_CORE_INFO("Removing {} script code cache entries that are missing from the index", files.size());
+		for (const std::filesystem::path& file : files)
+			std::filesystem::remove(file, err);
+	}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Michael Finger
+ *
+ * SPDX-License-Identifier: Apache-2.0 with Commons Clause
+ *
+ * For more Information on the license, see the LICENSE.md file
+ */
+
+#pragma once
+
+#include "core/Core.h"
+
+#include <v8.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+// Least recently used entries are evicted beyond this
+constexpr uint64_t SCRIPT_CODE_CACHE_LIMIT = 64ull * 1024 * 1024;
+
+namespace Acorn
+{
+	struct V8CodeCacheStats
+	{
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+		// Hits V8 refused to consume, e.g. because the entry was corrupt
+		uint32_t Rejected = 0;
+
+		inline float HitRate() const
+		{
+			uint32_t lookups = Hits + Misses;
+			return lookups > 0 ? (float)(Hits - Rejected) / (float)lookups : 0.0f;
+		}
+	};
+
+	/**
+	 * @brief On-disk store of V8 code caches, keyed by the hash of the source they were compiled from.
+	 *
+	 * Every entry is a file named after its hash, next to a binary index that records the size and last use of
+	 * each one. The index is tagged with ScriptCompiler::CachedDataVersionTag(), which covers the V8 version and
+	 * flags, so the whole store is dropped when either changes instead of V8 rejecting one entry at a time.
+	 */
+	class V8CodeCache
+	{
+	public:
+		/**
+		 * @brief Reads the index of the store in directory, V8 has to be initialized already.
+		 *
+		 * @param maxBytes
+		 *  Total size of the entries, the least recently used ones are evicted beyond it.
+		 */
+		void Open(const std::filesystem::path& directory, uint64_t maxBytes = SCRIPT_CODE_CACHE_LIMIT);
+
+		/**
+		 * @brief Writes the index back, entries stored since Open() are already on disk.
+		 */
+		void Close();
+
+		/**
+		 * @return
+		 *  The cached code for a source hash, for v8::ScriptCompiler::Source which takes ownership. Null on a miss.
+		 */
+		v8::ScriptCompiler::CachedData* Find(const std::string& hash);
+
+		/**
+		 * @brief Drops an entry that Find() returned but V8 did not accept.
+		 */
+		void Reject(const std::string& hash);
+
+		void Store(const std::string& hash, const v8::ScriptCompiler::CachedData& data);
+
+		inline const V8CodeCacheStats& GetStats() const { return m_Stats; }
+		inline uint64_t GetSize() const { return m_Size; }
+
+	private:
+		struct Entry
+		{
+			uint64_t Size = 0;
+			uint64_t LastUsed = 0;
+		};
+
+		std::filesystem::path EntryPath(const std::string& hash) const;
+		void Remove(const std::string& hash);
+		void Evict();
+
+		/**
+		 * @brief Deletes every entry file in the directory, for an index that is missing or was made by another V8.
+		 */
+		void Clear();
+		/**
+		 * @brief Deletes the entry files the index does not list.
+		 *
+		 * The index is only written by Close(), so entries stored before a crash are on disk but were never counted
+		 * against the size limit.
+		 */
+		void RemoveUnlisted();
+
+	private:
+		std::filesystem::path m_Directory;
+		uint64_t m_MaxBytes = SCRIPT_CODE_CACHE_LIMIT;
+		uint32_t m_Tag = 0;
+		bool m_Open = false;
+
+		std::unordered_map<std::string, Entry> m_Entries;
+		uint64_t m_Size = 0;
+		// Logical time of the last use, persisted so the order carries over between sessions
+		uint64_t m_Clock = 0;
+
+		V8CodeCacheStats m_Stats;
+	};
+}
@@ -15,255 +15,82 @@
 #include "v8pp/convert.hpp"
 
 #include <magic_enum.hpp>
+#include <map>
 #include <unordered_map>
 #include <v8.h>
-#include <yaml-cpp/node/node.h>
-#include <yaml-cpp/yaml.h>
 #include <nlohmann/json.hpp>
 
-namespace YAML
-{
-	template <>
-	struct convert<std::unordered_map<std::string, Acorn::ModuleData>>
-	{
-		static Node encode(const std::unordered_map<std::string, Acorn::ModuleData>& rhs)
-		{
-			Node node;
-			for (const auto& [key, value] : rhs)
-			{
-				node[key] = value;
-			}
-			return node;
-		}
-
-		static bool decode(const Node& node, std::unordered_map<std::string, Acorn::ModuleData>& rhs)
-		{
-			if (!node.IsMap())
-			{
-				return false;
-			}
-
-			for (auto n : node)
-			{
-				rhs[n.first.as<std::string>()] = n.second.as<Acorn::ModuleData>();
-			}
-
-			return true;
-		}
-	};
-
-	template <>
-	struct convert<Acorn::ModuleData>
-	{
-		static Node encode(const Acorn::ModuleData& rhs)
-		{
-			Node node;
-			node["CachePath"] = rhs.CachePath.string();
-			node["Type"] = magic_enum::enum_name(rhs.Type).data();
-
-			return node;
-		}
-
-		static bool decode(const Node& node, Acorn::ModuleData& rhs)
-		{
-			if (!node.IsMap())
-			{
-				return false;
-			}
-
-			rhs.CachePath = node["CachePath"].as<std::string>();
-			auto typeEnum = magic_enum::enum_cast<Acorn::ModuleType>(node["Type"].as<std::string>());
-			if (!typeEnum.has_value())
-				return false;
-			rhs.Type = typeEnum.value();
-
-			return true;
-		}
-	};
-}
-
 namespace Acorn
 {
 
-	V8Import::CompilerData V8Import::s_Data;
-	std::unordered_map<int, std::filesystem::path> s_ModulePaths;
+	// Script ids are only unique within an isolate, the snapshot creator has one of its own
+	// Script ids are only unique within an isolate and the isolates are pooled
+	std::map<std::pair<v8::Isolate*, int>, std::filesystem::path> s_ModulePaths;
 
 	void V8Import::Init()
 	{
 		AC_PROFILE_FUNCTION();
-		std::ifstream configFile(Utils::File::CONFIG_FILENAME);
-
-		if (!configFile.is_open())
-			return;
-
-		YAML::Node config = YAML::Load(configFile);
-
-		if (config["v8"]["moduleCache"].IsDefined())
-		{
-			s_Data.CompileCache = config["v8"]["moduleCache"].as<std::unordered_map<std::string, Acorn::ModuleData>>();
-		}
-		else
-		{
-			AC_CORE_WARN("Could not load module cache");
-		}
+		s_Data.CodeCache.Open(MODULE_CACHE_PATH);
 	}
 
 	void V8Import::Save()
 	{
 		AC_PROFILE_FUNCTION();
-		std::ifstream configFile(Utils::File::CONFIG_FILENAME);
-
-		YAML::Node config;
-		if (configFile.is_open())
-			config = YAML::Load(configFile);
-		else
-			config = YAML::Load("");
-
-		if (!s_Data.CompileCache.empty())
-			config["v8"]["moduleCache"] = s_Data.CompileCache;
-
-		std::ofstream outFile(Utils::File::CONFIG_FILENAME);
-		outFile << config;
-
-		outFile.close();
+		s_Data.CodeCache.Close();
 	}
 
-	// V8Import::CompilerData s_Data;
-
 	v8::MaybeLocal<v8::Module> V8Import::LoadModule(const std::string& code, const char* name, v8::Local<v8::Context> cx)
 	{
 		AC_PROFILE_FUNCTION();
-		// AC_CORE_TRACE("Loading {}", name);
-
-		ModuleType type = ModuleType::ES6;
-
-		std::string md5Hash = Utils::File::MD5HashString(code);
-		// AC_CORE_TRACE("MD5HashString {} {}", name, md5Hash);
+		v8::Isolate* isolate = cx->GetIsolate();
+		std::string md5Hash	 = Utils::File::MD5HashString(code);
 
 		v8::Local<v8::String> vcode;
 		{
 			AC_PROFILE_SCOPE("Converting code to v8");
-			// vcode = v8pp::to_v8(cx->GetIsolate(), code);
-			vcode = v8::String::NewFromUtf8(cx->GetIsolate(), code.c_str(), v8::NewStringType::kInternalized).ToLocalChecked();
+			vcode = v8::String::NewFromUtf8(isolate, code.c_str(), v8::NewStringType::kInternalized).ToLocalChecked();
 		}
-		v8::ScriptOrigin origin(cx->GetIsolate(), v8::String::NewFromUtf8(cx->GetIsolate(), name).ToLocalChecked(), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
+		v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8(isolate, name).ToLocalChecked(), 0, 0, false, -1, v8::Local<v8::Value>(), false, false, true);
 
 		v8::Context::Scope context_scope(cx);
 
-		// Check cache
-		if (s_Data.CompileCache.find(md5Hash) != s_Data.CompileCache.end() && std::filesystem::exists(s_Data.CompileCache[md5Hash].CachePath))
-		{
-			AC_PROFILE_SCOPE("Cache Hit");
-
-			AC_CORE_ASSERT(s_Data.CompileCache[md5Hash].Type == type, "Cache type mismatch");
-
-			// Load from cache
-			std::filesystem::path cachePath = s_Data.CompileCache[md5Hash].CachePath;
-			// std::basic_ifstream<uint8_t> cacheFile(cachePath.string(), std::ios::binary);
-			uint8_t* cacheData;
-			size_t cacheSize;
-			// std::vector<uint8_t> cacheData;
-			FILE* cacheFile;
-			{
-				AC_PROFILE_SCOPE("Loading cached file");
+		// The source takes ownership of the cached data
+		v8::ScriptCompiler::CachedData* cachedData = s_Data.CodeCache.Find(md5Hash);
+		v8::ScriptCompiler::Source source(vcode, origin, cachedData);
 
-				errno_t err;
-
-				// NOTE this is a lot faster at -O0, but maybe ifstream is just as fast at -O3?
-				err = fopen_s(&cacheFile, cachePath.string().c_str(), "rb");
-
-				AC_CORE_ASSERT(!!cacheFile, "Could not open cache file!");
-				AC_CORE_ASSERT(err == 0, "Could not open cache file!");
-
-				fseek(cacheFile, 0, SEEK_END);
-				cacheSize = ftell(cacheFile);
-				fseek(cacheFile, 0, SEEK_SET);
-
-				cacheData = new uint8_t[cacheSize];
-
-				fread(cacheData, 1, cacheSize, cacheFile);
-
-				fclose(cacheFile);
-			}
-
-			v8::ScriptCompiler::CachedData* v8cachedData = new v8::ScriptCompiler::CachedData(cacheData, cacheSize);
-
-			v8::ScriptCompiler::Source source(vcode, origin, v8cachedData);
-
-			v8::MaybeLocal<v8::Module> mod;
-			if (type == ModuleType::ES6)
-			{
-				AC_PROFILE_SCOPE("Compiling ES6 Cached Module");
-				mod = v8::ScriptCompiler::CompileModule(cx->GetIsolate(), &source, v8::ScriptCompiler::CompileOptions::kConsumeCodeCache);
-			}
-			else
-			{
-				AC_PROFILE_SCOPE("Compiling CommonJS Cached Module");
-				AC_CORE_ASSERT(false, "CommonJS modules not supported!");
-			}
-
-			return mod;
+		v8::MaybeLocal<v8::Module> mod;
+		if (cachedData)
+		{
+			AC_PROFILE_SCOPE("Compiling ES6 Cached Module");
+			mod = v8::ScriptCompiler::CompileModule(isolate, &source, v8::ScriptCompiler::kConsumeCodeCache);
 		}
 		else
 		{
-			AC_PROFILE_SCOPE("Cache Miss");
-			v8::ScriptCompiler::Source source(vcode, origin);
-			// Compile
-
-			v8::MaybeLocal<v8::Module> mod;
-			if (type == ModuleType::ES6)
-			{
-				AC_PROFILE_SCOPE("Compiling ES6 Module");
-				mod = v8::ScriptCompiler::CompileModule(cx->GetIsolate(), &source);
-			}
-			else
-			{
-				AC_PROFILE_SCOPE("Compiling CommonJS Module");
-				AC_CORE_ASSERT(false, "CommonJS modules not supported!");
-			}
-
-			v8::ScriptCompiler::CachedData* data;
-			if (type == ModuleType::ES6)
-			{
-				{
-					AC_PROFILE_SCOPE("Getting Cache from v8");
-					v8::Local<v8::UnboundModuleScript> script = mod.ToLocalChecked()->GetUnboundModuleScript();
-					data = v8::ScriptCompiler::CreateCodeCache(script);
-				}
-				AC_CORE_ASSERT(data != nullptr, "Failed to create code cache");
-
-				{
-					AC_PROFILE_SCOPE("Writing cache");
-					std::filesystem::path cachePath = MODULE_CACHE_PATH;
-					if (!std::filesystem::exists(cachePath))
-						std::filesystem::create_directories(cachePath);
-
-					cachePath /= md5Hash;
-					cachePath += ".js.cache";
-
-					FILE* cacheFile;
-					errno_t err;
-					err = fopen_s(&cacheFile, cachePath.string().c_str(), "wb");
-
-					AC_CORE_ASSERT(cacheFile, "Could not open cache file!");
-					AC_CORE_ASSERT(err == 0, "Could not open cache file!");
-
-					fwrite(data->data, 1, data->length, cacheFile);
-
-					fclose(cacheFile);
+			AC_PROFILE_SCOPE("Compiling ES6 Module");
+			mod = v8::ScriptCompiler::CompileModule(isolate, &source);
+		}
 
-					// std::basic_ofstream<uint8_t> cacheFile(cachePath.string(), std::ios::binary);
-					// cacheFile.write(data->data, data->length);
-					// cacheFile.close();
+		if (mod.IsEmpty())
+			return mod;
 
-					s_Data.CompileCache[md5Hash] = {
-						cachePath,
-						type};
-				}
-			}
+		if (cachedData)
+		{
+			if (!source.GetCachedData()->rejected)
+				return mod;
+			s_Data.CodeCache.Reject(md5Hash);
+		}
 
-			return mod;
+		{
+			AC_PROFILE_SCOPE("Writing cache");
+			v8::Local<v8::UnboundModuleScript> script = mod.ToLocalChecked()->GetUnboundModuleScript();
+			std::unique_ptr<v8::ScriptCompiler::CachedData> data(v8::ScriptCompiler::CreateCodeCache(script));
+			if (data)
+				s_Data.CodeCache.Store(md5Hash, *data);
+			else
+				AC_CORE_WARN("V8 did not create a code cache for {}", name);
 		}
+
+		return mod;
 	}
 
 	static v8::MaybeLocal<v8::Module> LoadModuleFromPath(const std::filesystem::path& path, v8::Local<v8::Context> context)
@@ -276,7 +103,7 @@ namespace Acorn
 		if(!module.IsEmpty())
 		{
 			v8::Local<v8::Module> mod = module.ToLocalChecked();
-			s_ModulePaths[mod->ScriptId()] = fsPath;
+			s_ModulePaths[{context->GetIsolate(), mod->ScriptId()}] = fsPath;
 			return module;
 		}
 		AC_CORE_ERROR("Failed to load module {}", fsPath.string());
@@ -322,7 +149,7 @@ namespace Acorn
 		if(specifierStr.starts_with("./") || specifierStr.starts_with("../"))
 		{
 			// Relative resolution
-			std::filesystem::path referrerPath = s_ModulePaths[referrer->ScriptId()];
+			std::filesystem::path referrerPath = s_ModulePaths[{context->GetIsolate(), referrer->ScriptId()}];
 			AC_CORE_ASSERT(!referrerPath.empty(), "Could not find referrer path!");
 			std::filesystem::path resolvedPath = referrerPath.parent_path() / path;
 
@@ -332,7 +159,7 @@ namespace Acorn
 			return LoadModuleFromPath(resolvedPath, context);
 		}
 		// Include from the node_modules folder in builtins
-		std::filesystem::path nodeModulesPath = s_ModulePaths[referrer->ScriptId()].parent_path();
+		std::filesystem::path nodeModulesPath = s_ModulePaths[{context->GetIsolate(), referrer->ScriptId()}].parent_path();
 		std::error_code err;
 		nodeModulesPath = std::filesystem::canonical(nodeModulesPath, err);
 		AC_CORE_ASSERT(!err, "Could not canonicalize node modules path {}!\n{}", nodeModulesPath.string(), err.message());
@@ -540,6 +367,19 @@ namespace Acorn
 		else
 		{
 			isolate->ThrowException(v8::Exception::TypeError(v8::String::NewFromUtf8(isolate, "Require takes a string argument").ToLocalChecked()));
+			return;
+		}
+
+		// Packages of the startup snapshot are already evaluated
+		v8::Local<v8::Value> builtins;
+		if (ctx->Global()->Get(ctx, v8pp::to_v8(isolate, BUILTINS_NAME)).ToLocal(&builtins) && builtins->IsObject())
+		{
+			v8::Local<v8::Value> exports;
+			if (builtins.As<v8::Object>()->Get(ctx, modulePath).ToLocal(&exports) && !exports->IsUndefined())
+			{
+				args.GetReturnValue().Set(exports);
+				return;
+			}
 		}
 
 		std::filesystem::path path = ResolvePath(v8pp::from_v8<std::string>(ctx->GetIsolate(), modulePath));
@@ -603,13 +443,12 @@ namespace Acorn
 		// Binding metadata loader callback
 		isolate->SetHostInitializeImportMetaObjectCallback(CallMeta);
 
-		// Bind CommonJS require
-		BindCommonJSRequire(isolate->GetCurrentContext(), isolate->GetCurrentContext()->Global());
+		// CommonJS require is bound per context with BindCommonJSRequire, or comes with the startup snapshot
 	}
 
-	void V8Import::AddModulePath(int moduleId, const std::filesystem::path& path)
+	void V8Import::AddModulePath(v8::Isolate* isolate, int moduleId, const std::filesystem::path& path)
 	{
-		s_ModulePaths[moduleId] = path;
+		s_ModulePaths[{isolate, moduleId}] = path;
 	}
 
 	v8::Local<v8::Module> V8Import::ResolveBuiltin(v8::Local<v8::Context> context, std::string_view specifier, std::string_view nodeModulesPath)
@@ -13,6 +13,7 @@
 #include "core/Log.h"
 #include "debug/Instrumentor.h"
 #include "utils/FileUtils.h"
+#include "utils/v8/V8CodeCache.h"
 
 #include <corecrt.h>
 #include <corecrt_wstdio.h>
@@ -35,30 +36,29 @@ namespace Acorn
 		CommonJS,
 		ES6
 	};
-	struct ModuleData
-	{
-		std::filesystem::path CachePath;
-		ModuleType Type;
-	};
 
 	class V8Import
 	{
 	public:
 		// TODO cache compiled module results...
-		// TODO cache isolate for reuse with multiple scripts?
 		// TODO get the original path of the compiled module to be able to resolve top-level relative imports
 		struct CompilerData
 		{
-			// NOTE maybe just save unsigned char*
-			// Map hash to cache file path
-			std::unordered_map<std::string, ModuleData> CompileCache;
+			// Code caches of every module compiled through LoadModule, keyed by the hash of the source
+			V8CodeCache CodeCache;
 		};
 
 		static CompilerData s_Data;
 
+		/**
+		 * @brief Opens the code cache, V8 has to be initialized already.
+		 */
 		static void Init();
 		static void Save();
 
+		/**
+		 * @brief Compiles an ES module, from the code cache if it holds the same source.
+		 */
 		static v8::MaybeLocal<v8::Module> LoadModule(const std::string& code, const char* name, v8::Local<v8::Context> cx);
 		static v8::Local<v8::Module> CheckModule(v8::MaybeLocal<v8::Module> maybeModule, v8::Local<v8::Context> cx);
 		static v8::Local<v8::Value> ExecModule(v8::Local<v8::Module> mod, v8::Local<v8::Context> cx, bool nsObject = false);
@@ -75,13 +75,21 @@ namespace Acorn
 
 		static void BindImport(v8::Isolate* isolate);
 
-		static void AddModulePath(int moduleId, const std::filesystem::path& path);
+		static void AddModulePath(v8::Isolate* isolate, int moduleId, const std::filesystem::path& path);
+
+		// Global object holding the exports of the packages evaluated into the startup snapshot, by package name
+		static constexpr const char* BUILTINS_NAME = "__acornBuiltins";
 
-		static std::vector<intptr_t> ExternalRefs()
+		/**
+		 * @brief Native functions that objects in the startup snapshot can refer to, terminated by 0.
+		 */
+		static const intptr_t* ExternalRefs()
 		{
-			return {
+			static const intptr_t refs[] = {
 				reinterpret_cast<intptr_t>(&V8Import::CommonJSRequire),
+				0,
 			};
+			return refs;
 		}
 	};
 }
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2022 Michael Finger
+ *
+ * SPDX-License-Identifier: Apache-2.0 with Commons Clause
+ *
+ * For more Information on the license, see the LICENSE.md file
+ */
+
+#include "acpch.h"
+
+#include "utils/v8/V8Snapshot.h"
+
+#include "utils/FileUtils.h"
+#include "utils/v8/V8Import.h"
+
+#include <nlohmann/json.hpp>
+#include <v8pp/convert.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+namespace Acorn
+{
+	// Bump when the layout of the snapshot context changes
+	static constexpr const char* SnapshotVersion = "1";
+
+	struct BuiltinPackage
+	{
+		std::string Name;
+		std::filesystem::path Directory;
+		std::filesystem::path Main;
+	};
+
+	static std::vector<BuiltinPackage> ListBuiltins(const std::filesystem::path& nodeModulesPath)
+	{
+		std::vector<BuiltinPackage> builtins;
+		std::error_code err;
+		if (!std::filesystem::is_directory(nodeModulesPath, err))
+			return builtins;
+
+		for (const auto& entry : std::filesystem::directory_iterator(nodeModulesPath, err))
+		{
+			std::filesystem::path packagePath = entry.path() / "package.json";
+			if (!entry.is_directory() || !std::filesystem::exists(packagePath))
+				continue;
+
+			std::ifstream packageFile(packagePath);
+			nlohmann::json packageJson = nlohmann::json::parse(packageFile, nullptr, false);
+			if (packageJson.is_discarded())
+			{
+				AC_CORE_WARN("Could not parse {}", packagePath.string());
+				continue;
+			}
+
+			// CommonJS entry point, see https://docs.npmjs.com/cli/configuring-npm/package-json#main
+			std::filesystem::path main = entry.path() / packageJson.value("main", "index.js");
+			if (!main.has_extension())
+				main.replace_extension(".js");
+			if (std::filesystem::exists(main))
+				builtins.push_back({entry.path().filename().string(), entry.path(), main});
+		}
+
+		// Directory order is unspecified, the fingerprint must not depend on it
+		std::sort(builtins.begin(), builtins.end(), [](const BuiltinPackage& a, const BuiltinPackage& b) { return a.Name < b.Name; });
+		return builtins;
+	}
+
+	static bool EvaluateCommonJS(v8::Local<v8::Context> context, const std::filesystem::path& path, v8::Local<v8::Value>& exports)
+	{
+		AC_PROFILE_FUNCTION();
+		v8::Isolate* isolate = context->GetIsolate();
+
+		std::string source = "(function (exports, require, module, __filename, __dirname) {" + Utils::File::ReadFile(path.string()) + "\n})";
+		v8::ScriptOrigin origin(isolate, v8pp::to_v8(isolate, path.string()));
+		v8::ScriptCompiler::Source scriptSource(v8pp::to_v8(isolate, source), origin);
+
+		v8::Local<v8::Script> script;
+		v8::Local<v8::Value> wrapper;
+		if (!v8::ScriptCompiler::Compile(context, &scriptSource).ToLocal(&script) || !script->Run(context).ToLocal(&wrapper) || !wrapper->IsFunction())
+			return false;
+
+		v8::Local<v8::Object> module = v8::Object::New(isolate);
+		v8::Local<v8::Object> moduleExports = v8::Object::New(isolate);
+		module->Set(context, v8pp::to_v8(isolate, "exports"), moduleExports).Check();
+
+		v8::Local<v8::Value> require;
+		if (!context->Global()->Get(context, v8pp::to_v8(isolate, "require")).ToLocal(&require))
+			return false;
+
+		v8::Local<v8::Value> args[] = {
+			moduleExports,
+			require,
+			module,
+			v8pp::to_v8(isolate, path.string()),
+			v8pp::to_v8(isolate, path.parent_path().string()),
+		};
+		if (wrapper.As<v8::Function>()->Call(context, v8::Undefined(isolate), 5, args).IsEmpty())
+			return false;
+
+		return module->Get(context, v8pp::to_v8(isolate, "exports")).ToLocal(&exports);
+	}
+
+	std::string V8Snapshot::Fingerprint(const std::filesystem::path& nodeModulesPath)
+	{
+		AC_PROFILE_FUNCTION();
+		std::stringstream sources;
+		for (const BuiltinPackage& builtin : ListBuiltins(nodeModulesPath))
+		{
+			// The main file can require any other file of the package, including its own node_modules
+			std::error_code err;
+			std::vector<std::filesystem::path> files;
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(builtin.Directory, err))
+			{
+				if (entry.is_regular_file())
+					files.push_back(entry.path());
+			}
+			std::sort(files.begin(), files.end());
+
+			sources << builtin.Name << '\0';
+			for (const std::filesystem::path& file : files)
+			{
+				// Read as bytes, packages ship binary files that ReadFile() would cut off at the first null
+				std::ifstream input(file, std::ios::binary);
+				std::string contents(std::istreambuf_iterator<char>(input), {});
+				sources << file.lexically_relative(builtin.Directory).generic_string() << '\0' << contents << '\0';
+			}
+		}
+
+		return fmt::format("acorn-snapshot {} v8 {} flags {} builtins {}", SnapshotVersion, v8::V8::GetVersion(), SCRIPT_RUNTIME_FLAGS,
+			Utils::File::MD5HashString(sources.str()));
+	}
+
+	bool V8Snapshot::Create(const std::filesystem::path& blobPath, const std::filesystem::path& nodeModulesPath)
+	{
+		AC_PROFILE_FUNCTION();
+		v8::StartupData blob;
+		{
+			v8::SnapshotCreator creator(V8Import::ExternalRefs());
+			v8::Isolate* isolate = creator.GetIsolate();
+			{
+				v8::HandleScope handleScope(isolate);
+				v8::Local<v8::Context> context = v8::Context::New(isolate);
+				v8::Context::Scope contextScope(context);
+
+				V8Import::BindCommonJSRequire(context, context->Global());
+
+				v8::Local<v8::Object> builtins = v8::Object::New(isolate);
+				for (const BuiltinPackage& builtin : ListBuiltins(nodeModulesPath))
+				{
+					v8::TryCatch tryCatch(isolate);
+					v8::Local<v8::Value> exports;
+					if (!EvaluateCommonJS(context, builtin.Main, exports))
+					{
+						// E.g. packages that only ship ES modules, import() still loads them from disk
+						AC_CORE_WARN("Leaving {} out of the script snapshot, it does not evaluate as a CommonJS module", builtin.Name);
+						continue;
+					}
+					builtins->Set(context, v8pp::to_v8(isolate, builtin.Name), exports).Check();
+					AC_CORE_TRACE("Added {} to the script snapshot", builtin.Name);
+				}
+				context->Global()->Set(context, v8pp::to_v8(isolate, V8Import::BUILTINS_NAME), builtins).Check();
+
+				creator.SetDefaultContext(context);
+			}
+			blob = creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+		}
+
+		if (blob.data == nullptr)
+		{
+			AC_CORE_ERROR("Failed to create the script snapshot");
+			return false;
+		}
+
+		std::error_code err;
+		std::filesystem::create_directories(blobPath.parent_path(), err);
+		std::ofstream blobFile(blobPath, std::ios::binary);
+		blobFile << Fingerprint(nodeModulesPath) << '\n';
+		blobFile.write(blob.data, blob.raw_size);
+		bool written = blobFile.good();
+		delete[] blob.data;
+
+		if (!written)
+		{
+			AC_CORE_ERROR("Failed to write the script snapshot to {}", blobPath.string());
+			return false;
+		}
+		AC_CORE_INFO("Wrote script snapshot to {}", blobPath.string());
+		return true;
+	}
+
+	bool V8Snapshot::Load(const std::filesystem::path& blobPath, const std::filesystem::path& nodeModulesPath)
+	{
+		AC_PROFILE_FUNCTION();
+		m_Data.clear();
+		m_Blob = {nullptr, 0};
+
+		std::ifstream blobFile(blobPath, std::ios::binary);
+		if (!blobFile.is_open())
+			return false;
+
+		std::string fingerprint;
+		std::getline(blobFile, fingerprint);
+		if (fingerprint != Fingerprint(nodeModulesPath))
+		{
+			AC_CORE_INFO("Script snapshot {} is out of date", blobPath.string());
+			return false;
+		}
+
+		m_Data.assign(std::istreambuf_iterator<char>(blobFile), std::istreambuf_iterator<char>());
+		if (m_Data.empty())
+			return false;
+
+		m_Blob = {m_Data.data(), (int)m_Data.size()};
+		return true;
+	}
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2022 Michael Finger
+ *
+ * SPDX-License-Identifier: Apache-2.0 with Commons Clause
+ *
+ * For more Information on the license, see the LICENSE.md file
+ */
+
+#pragma once
+
+#include "core/Core.h"
+
+#include <v8.h>
+
+#include <filesystem>
+#include <string>
+
+constexpr const char* SCRIPT_SNAPSHOT_PATH = "res/cache/scripts/snapshot.bin";
+
+// A snapshot only loads into an isolate running with the flags it was made with
+constexpr const char* SCRIPT_RUNTIME_FLAGS = "--stack_trace_on_illegal --abort_on_uncaught_exception";
+
+namespace Acorn
+{
+	/**
+	 * @brief Startup snapshot of the script runtime.
+	 *
+	 * The snapshot holds a context with the CommonJS bindings installed and the packages of the builtin node_modules
+	 * folder already evaluated, isolates created from it start with that context instead of building it by hand.
+	 * Template bindings, e.g. print or the IDL generated wrappers, keep state outside of the V8 heap and are still
+	 * installed on every context.
+	 */
+	class V8Snapshot
+	{
+	public:
+		/**
+		 * @brief Builds the snapshot and writes it to blobPath, V8 has to be initialized already.
+		 *
+		 * @param nodeModulesPath
+		 *  Every package in it with a package.json is evaluated into the snapshot, a missing folder gives an empty one.
+		 */
+		static bool Create(const std::filesystem::path& blobPath, const std::filesystem::path& nodeModulesPath);
+
+		/**
+		 * @brief Reads a snapshot written by Create().
+		 *
+		 * @return
+		 *  False if there is none, or it was made by another V8 version, with other flags or from other builtins.
+		 */
+		bool Load(const std::filesystem::path& blobPath, const std::filesystem::path& nodeModulesPath);
+
+		inline bool IsLoaded() const { return m_Blob.data != nullptr; }
+
+		/**
+		 * @brief For v8::Isolate::CreateParams::snapshot_blob, valid as long as the snapshot is.
+		 */
+		inline const v8::StartupData* GetBlob() const { return &m_Blob; }
+
+	private:
+		/**
+		 * @brief Identifies what a snapshot was made with, V8 aborts on a blob from another version or other flags.
+		 *
+		 * Covers every file of the builtin packages, not just their main file, since any of them can be required.
+		 */
+		static std::string Fingerprint(const std::filesystem::path& nodeModulesPath);
+
+	private:
+		std::string m_Data;
+		v8::StartupData m_Blob = {nullptr, 0};
+	};
+}
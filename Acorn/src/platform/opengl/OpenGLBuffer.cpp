@@ -1,10 +1,14 @@
 #include "acpch.h"
 
 #include "debug/Instrumentor.h"
+#include "debug/Timer.h"
 #include "platform/opengl/OpenGLBuffer.h"
+#include "utils/PlatformCapabilities.h"
 
 #include <glad/glad.h>
 
+#include <cstring>
+
 // NOTE Since our profiling is linked to the tracy macro, we don't actually need a profiling check...
 // Maybe it's worth it to add some custom wrapper macros
 #include <TracyOpenGL.hpp>
@@ -85,6 +89,197 @@ namespace Acorn
 		glDeleteBuffers(1, &m_RendererId);
 	}
 
+	// Streaming Vertex Buffer
+
+	OpenGLStreamingVertexBuffer::OpenGLStreamingVertexBuffer(uint32_t batchSize, BufferStreamingMode mode)
+		: m_Mode(mode), m_BatchSize(batchSize), m_RegionSize(batchSize)
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLStreamingVertexBuffer::OpenGLStreamingVertexBuffer");
+
+		if (m_Mode == BufferStreamingMode::PersistentMapped && !PlatformCapabilities::SupportsPersistentMapping())
+		{
+			AC_CORE_WARN("Persistent buffer mapping is not supported, falling back to buffer orphaning");
+			m_Mode = BufferStreamingMode::Orphaning;
+		}
+
+		glCreateBuffers(1, &m_RendererId);
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+
+		if (m_Mode == BufferStreamingMode::PersistentMapped)
+		{
+			m_RegionSize = m_BatchSize * BatchesPerRegion;
+
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)m_RegionSize * RegionCount, nullptr, flags);
+			m_MappedBase = (uint8_t*)glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)m_RegionSize * RegionCount, flags);
+			AC_CORE_ASSERT(m_MappedBase, "Failed to map streaming vertex buffer!");
+		}
+		else
+		{
+			glBufferData(GL_ARRAY_BUFFER, m_BatchSize, nullptr, m_Mode == BufferStreamingMode::Orphaning ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW);
+		}
+	}
+
+	OpenGLStreamingVertexBuffer::~OpenGLStreamingVertexBuffer()
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLStreamingVertexBuffer::~OpenGLStreamingVertexBuffer");
+
+		for (void* fence : m_Fences)
+		{
+			if (fence)
+				glDeleteSync((GLsync)fence);
+		}
+
+		if (m_MappedBase)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+
+		glDeleteBuffers(1, &m_RendererId);
+	}
+
+	void OpenGLStreamingVertexBuffer::Bind() const
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLStreamingVertexBuffer::Bind");
+		glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+	}
+
+	void OpenGLStreamingVertexBuffer::Unbind() const
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLStreamingVertexBuffer::Unbind");
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLStreamingVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		AC_PROFILE_FUNCTION();
+		AC_CORE_ASSERT(size <= m_BatchSize, "Data does not fit into a streaming batch!");
+
+		// NOTE The data ends up at the offset returned by Commit, which SetData has no way to report. Use Acquire/Commit when drawing with a base vertex.
+		if (void* batch = Acquire())
+		{
+			std::memcpy(batch, data, size);
+			Commit(batch, size);
+		}
+		else
+		{
+			Commit(data, size);
+		}
+	}
+
+	const void* OpenGLStreamingVertexBuffer::GetData() const
+	{
+		// The other modes would have to map the buffer, which stalls and can't be unmapped by the caller
+		return m_MappedBase ? m_MappedBase + m_CurrentRegion * m_RegionSize + m_RegionOffset : nullptr;
+	}
+
+	void* OpenGLStreamingVertexBuffer::GetDataPtr() const
+	{
+		return m_MappedBase ? m_MappedBase + m_CurrentRegion * m_RegionSize + m_RegionOffset : nullptr;
+	}
+
+	void* OpenGLStreamingVertexBuffer::Acquire()
+	{
+		AC_PROFILE_FUNCTION();
+
+		if (!m_MappedBase)
+			return nullptr;
+
+		// A frame that filled its region spills into the next one, the GPU may still read from it
+		if (m_RegionOffset + m_BatchSize > m_RegionSize)
+		{
+			AC_CORE_TRACE("Streaming vertex buffer region is full, spilling into the next one");
+			EndFrame();
+		}
+
+		void*& fence = m_Fences[m_CurrentRegion];
+		if (fence)
+		{
+			TracyGpuZone("OpenGLStreamingVertexBuffer::Acquire");
+			Timer timer;
+
+			// Poll once without flushing, only flush the command queue if we actually have to wait
+			GLenum result = glClientWaitSync((GLsync)fence, 0, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+			{
+				result = glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+			}
+			AC_CORE_ASSERT(result != GL_WAIT_FAILED, "Waiting on streaming buffer fence failed!");
+
+			m_StallTime += timer.ElapsedMillis();
+
+			glDeleteSync((GLsync)fence);
+			fence = nullptr;
+		}
+
+		return m_MappedBase + m_CurrentRegion * m_RegionSize + m_RegionOffset;
+	}
+
+	uint32_t OpenGLStreamingVertexBuffer::Commit(const void* data, uint32_t size)
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLStreamingVertexBuffer::Commit");
+		AC_CORE_ASSERT(size <= m_BatchSize, "Data does not fit into a streaming batch!");
+
+		switch (m_Mode)
+		{
+			case BufferStreamingMode::PersistentMapped:
+			{
+				// Coherent mapping, the writes are visible to the next draw call without any explicit flush
+				uint32_t offset = m_CurrentRegion * m_RegionSize + m_RegionOffset;
+				AC_CORE_ASSERT(data == m_MappedBase + offset, "Persistent mapped data has to be written to the acquired memory!");
+				m_CommittedSize = size;
+				return offset;
+			}
+			case BufferStreamingMode::Orphaning:
+			{
+				Timer timer;
+				glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+				glBufferData(GL_ARRAY_BUFFER, m_BatchSize, nullptr, GL_STREAM_DRAW);
+				glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+				m_StallTime += timer.ElapsedMillis();
+				return 0;
+			}
+			case BufferStreamingMode::SubData:
+			{
+				Timer timer;
+				glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+				glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+				m_StallTime += timer.ElapsedMillis();
+				return 0;
+			}
+			default:
+				AC_CORE_ASSERT(false, "Unknown BufferStreamingMode!");
+				return 0;
+		}
+	}
+
+	void OpenGLStreamingVertexBuffer::Advance()
+	{
+		// The next batch goes right behind this one, the whole region gets fenced in EndFrame
+		m_RegionOffset += m_CommittedSize;
+		m_CommittedSize = 0;
+	}
+
+	void OpenGLStreamingVertexBuffer::EndFrame()
+	{
+		AC_PROFILE_FUNCTION();
+
+		// Nothing was written to the region, it can be reused as is
+		if (!m_MappedBase || m_RegionOffset == 0)
+			return;
+
+		TracyGpuZone("OpenGLStreamingVertexBuffer::EndFrame");
+		m_Fences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_CurrentRegion = (m_CurrentRegion + 1) % RegionCount;
+		m_RegionOffset = 0;
+	}
+
 	// Index Buffer
 
 	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* vertices, uint32_t count)
@@ -2,6 +2,8 @@
 
 #include "Acorn/renderer/Buffer.h"
 
+#include <array>
+
 namespace Acorn
 {
 
@@ -27,6 +29,51 @@ namespace Acorn
 		BufferLayout m_Layout;
 	};
 
+	class OpenGLStreamingVertexBuffer : public StreamingVertexBuffer
+	{
+	public:
+		OpenGLStreamingVertexBuffer(uint32_t batchSize, BufferStreamingMode mode);
+		~OpenGLStreamingVertexBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void SetData(const void* data, uint32_t size) override;
+		virtual const void* GetData() const override;
+		virtual void* GetDataPtr() const override;
+
+		inline virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		inline virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+
+		virtual void* Acquire() override;
+		virtual uint32_t Commit(const void* data, uint32_t size) override;
+		virtual void Advance() override;
+		virtual void EndFrame() override;
+
+		inline virtual BufferStreamingMode GetMode() const override { return m_Mode; }
+
+		inline virtual float GetStallTime() const override { return m_StallTime; }
+		inline virtual void ResetStallTime() override { m_StallTime = 0.0f; }
+
+	private:
+		uint32_t m_RendererId;
+		BufferLayout m_Layout;
+
+		BufferStreamingMode m_Mode;
+		uint32_t m_BatchSize;
+		uint32_t m_RegionSize;
+		uint32_t m_CurrentRegion = 0;
+		// Bytes of the current region used by the retired batches of this frame
+		uint32_t m_RegionOffset = 0;
+		uint32_t m_CommittedSize = 0;
+
+		uint8_t* m_MappedBase = nullptr;
+		// GLsync, kept opaque to not leak glad into the header
+		std::array<void*, RegionCount> m_Fences = {};
+
+		float m_StallTime = 0.0f;
+	};
+
 	class OpenGLIndexBuffer : public IndexBuffer
 	{
 	public:
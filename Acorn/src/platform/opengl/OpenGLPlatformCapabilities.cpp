@@ -13,4 +13,10 @@ namespace Acorn
 		AC_CORE_ASSERT(textureUnits != 0, "Something went wrong, driver reports no texture support!");
 		return textureUnits;
 	}
+
+	bool OpenGLPlatformCapabilities::SupportsPersistentMapping_()
+	{
+		// glBufferStorage (and with it GL_MAP_PERSISTENT_BIT) is core since 4.4
+		return GLAD_GL_VERSION_4_4;
+	}
 }
\ No newline at end of file
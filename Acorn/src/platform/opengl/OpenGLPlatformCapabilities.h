@@ -13,5 +13,6 @@ namespace Acorn
 
 	protected:
 		virtual uint32_t GetMaxTextureUnits_() override;
+		virtual bool SupportsPersistentMapping_() override;
 	};
 }
\ No newline at end of file
@@ -45,20 +45,34 @@ namespace Acorn
 		glClear(GL_DEPTH_BUFFER_BIT);
 	}
 
-	void OpenGLRendererApi::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count)
+	void OpenGLRendererApi::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count, uint32_t baseVertex)
 	{
 		AC_PROFILE_FUNCTION();
 		TracyGpuZone("OpenGLRendererApi::DrawIndexed");
 		uint32_t indexCount = count ? count : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+		if (baseVertex)
+			glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
+		else
+			glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
 	}
 
-	void OpenGLRendererApi::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count)
+	void OpenGLRendererApi::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count, uint32_t baseVertex)
 	{
 		AC_PROFILE_FUNCTION();
 		TracyGpuZone("OpenGLRendererApi::DrawLines");
 		uint32_t indexCount = count ? count : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_LINES, indexCount, GL_UNSIGNED_INT, nullptr);
+		if (baseVertex)
+			glDrawElementsBaseVertex(GL_LINES, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
+		else
+			glDrawElements(GL_LINES, indexCount, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLRendererApi::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		AC_PROFILE_FUNCTION();
+		TracyGpuZone("OpenGLRendererApi::DrawIndexedInstanced");
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount, baseInstance);
 	}
 
 	const char* OpenGLRendererApi::GetRenderer() const
@@ -14,8 +14,9 @@ namespace Acorn
 		virtual void Clear() override;
 		virtual void ClearDepth() override;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count) override;
-		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count, uint32_t baseVertex) override;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t count, uint32_t baseVertex) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) override;
 
 		virtual const char* GetRenderer() const override;
 		virtual const char* GetVersion() const override;
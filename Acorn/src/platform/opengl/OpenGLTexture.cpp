@@ -18,6 +18,23 @@ namespace Acorn
 	{
 	}
 
+	OpenGLAsyncTextureLoader::~OpenGLAsyncTextureLoader()
+	{
+		FreeData();
+	}
+
+	void OpenGLAsyncTextureLoader::FreeData()
+	{
+		if (!m_Data)
+			return;
+
+		if (m_Resized)
+			free(m_Data);
+		else
+			stbi_image_free(m_Data);
+		m_Data = nullptr;
+	}
+
 	void OpenGLAsyncTextureLoader::Load()
 	{
 		AC_PROFILE_FUNCTION();
@@ -29,20 +46,35 @@ namespace Acorn
 		else
 		{
 			int width, height;
-			stbi_uc* data = nullptr;
-
-			m_Data = new stbi_uc[m_Width * m_Height * m_Channels];
+			stbi_uc* data = stbi_load(m_Path.c_str(), &width, &height, &m_Channels, 0);
+			if (!data)
+				return;
 
-			data = stbi_load(m_Path.c_str(), &width, &height, &m_Channels, 0);
+			// The channel count is only known after loading
+			m_Data = (stbi_uc*)malloc((size_t)m_Width * m_Height * m_Channels);
+			m_Resized = true;
 			stbir_resize_uint8(data, width, height, 0, m_Data, m_Width, m_Height, 0, m_Channels);
+			stbi_image_free(data);
+		}
+
+		if (!m_Data)
+		{
+			AC_CORE_WARN("Failed to load texture {}", m_Path);
 		}
 	}
 
 	Ref<Texture2d> OpenGLAsyncTextureLoader::Upload()
 	{
 		AC_PROFILE_FUNCTION();
-		Ref<Texture2d> texture = Texture2d::Create(m_Width, m_Height, m_Channels);
+		if (!m_Data)
+			return nullptr;
+
+		Ref<OpenGLTexture2d> texture = CreateRef<OpenGLTexture2d>(m_Width, m_Height, m_Channels);
 		texture->SetData(m_Data, m_Width * m_Height * m_Channels);
+		// Keep the path, so the texture survives saving the scene
+		texture->m_Path = m_Path;
+
+		FreeData();
 		return texture;
 	}
 
@@ -157,7 +189,7 @@ namespace Acorn
 		glTextureSubImage2D(m_RendererId, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, resizedData);
 
 		stbi_image_free(data);
-		stbi_image_free(resizedData);
+		delete[] resizedData;
 	}
 
 	OpenGLTexture2d::OpenGLTexture2d(const std::string& path)
@@ -38,6 +38,8 @@ namespace Acorn
 		static OpenGLTexture2d FromRenderId(uint32_t id);
 
 	private:
+		friend class OpenGLAsyncTextureLoader;
+
 		std::string m_Path;
 		uint32_t m_RendererId;
 		uint32_t m_Width, m_Height;
@@ -48,15 +50,21 @@ namespace Acorn
 	{
 	public:
 		OpenGLAsyncTextureLoader(const std::string& path, int width, int height);
+		~OpenGLAsyncTextureLoader();
 
 		void Load();
 
 		Ref<Texture2d> Upload();
 
 	private:
-		unsigned char* m_Data;
+		void FreeData();
+
+	private:
+		unsigned char* m_Data = nullptr;
+		// Resized pixels come from malloc, the others from stb_image
+		bool m_Resized = false;
 		std::string m_Path;
-		int m_Width, m_Height, m_Channels;
+		int m_Width, m_Height, m_Channels = 0;
 		Ref<OpenGLTexture2d> m_Texture;
 	};
 }
\ No newline at end of file
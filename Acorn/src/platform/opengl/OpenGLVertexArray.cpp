@@ -101,6 +101,8 @@ namespace Acorn
 										  element.Normalized ? GL_TRUE : GL_FALSE,
 										  layout.GetStride(),
 										  (const void*)(intptr_t)element.Offset);
+					if (layout.IsPerInstance())
+						glVertexAttribDivisor(m_VertexBufferIndex, 1);
 					m_VertexBufferIndex++;
 					break;
 				}
@@ -116,6 +118,8 @@ namespace Acorn
 										   ShaderDataTypeToOpenGLBaseType(element.Type),
 										   layout.GetStride(),
 										   (const void*)(intptr_t)element.Offset);
+					if (layout.IsPerInstance())
+						glVertexAttribDivisor(m_VertexBufferIndex, 1);
 					m_VertexBufferIndex++;
 					break;
 				}
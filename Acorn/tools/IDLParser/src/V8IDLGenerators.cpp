@@ -121,6 +121,7 @@ namespace Acorn::IDL
 
 		inja::json data;
 		AddEnums(data, interface);
+		data["view"] = interface.ExtendedAttributes.contains("View");
 
 		generator.Add(data);
 
@@ -187,10 +188,19 @@ namespace Acorn::IDL
 			data["inherit"] = false;
 		}
 
+		// [View] hands out the raw component memory as a Float32Array, which only works for plain fields
+		bool view = interface.ExtendedAttributes.contains("View");
+		data["view"] = view;
 		data["properties"] = inja::json::array();
 
 		for (const auto& prop : interface.Attributes)
 		{
+			if (view && prop.ReadOnly)
+			{
+				std::cerr << fmt::format("{}: [View] interfaces can not have readonly attribute {}\n", interface.Name, prop.Name);
+				std::exit(1);
+			}
+
 			inja::json propData;
 			propData["name"]	 = prop.Name;
 			propData["readonly"] = prop.ReadOnly ? "true" : "false";
@@ -27,6 +27,19 @@ public:
 		static {{ name }}& Unwrap(v8::Local<v8::Object> obj);
 		static {{ name }}& Unwrap(v8::Isolate* isolate, v8::Local<v8::Object> obj);
 		static v8::Local<v8::Object> Wrap(v8::Isolate* isolate, {{ name }}* obj);
+## if view
+
+		// Floats per component in a view
+		static constexpr uint32_t ViewStride = sizeof({{ name }}) / sizeof(float);
+
+		/**
+		 * @brief Float32Array over count components that lie next to each other, starting at first.
+		 *
+		 * Reads and writes go straight to the components, no copy is made. The caller has to detach the buffer before
+		 * the components move or are freed.
+		 */
+		static v8::Local<v8::Float32Array> View(v8::Isolate* isolate, {{ name }}* first, size_t count = 1);
+## endif
 	};
 
 {% include "EnumHeader.tpl" %}
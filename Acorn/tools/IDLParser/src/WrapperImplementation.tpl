@@ -11,9 +11,11 @@
 
 #include "{{ wrapper_name }}.h"
 
+#include <cstddef>
 #include <string_view>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 #include <v8pp/class.hpp>
 #include <v8pp/convert.hpp>
@@ -135,6 +137,16 @@ namespace Acorn::Scripting::V8
 		{% endif %}
 
 		global->Set(v8pp::to_v8(isolate, "{{ interface_name }}"), tpl);
+## if view
+
+		// Index of each attribute inside the stride of a view
+		v8::Local<v8::ObjectTemplate> layout = v8::ObjectTemplate::New(isolate);
+		layout->Set(isolate, "stride", v8pp::to_v8(isolate, ViewStride));
+## for property in properties
+		layout->Set(isolate, "{{ property.name }}", v8pp::to_v8(isolate, (uint32_t)(offsetof({{ name }}, {{ property.name }}) / sizeof(float))));
+## endfor
+		global->Set(isolate, "{{ interface_name }}Layout", layout);
+## endif
 	}
 
 	{{ name }}& {{ wrapper_name }}::Unwrap(v8::Local<v8::Object> obj)
@@ -152,6 +164,18 @@ namespace Acorn::Scripting::V8
 	{
 		return v8pp::class_<{{ name }}>::reference_external(isolate, obj);
 	}
+## if view
+
+	static_assert(std::is_standard_layout_v<{{ name }}> && sizeof({{ name }}) % sizeof(float) == 0, "[View] needs a component made of floats only");
+
+	v8::Local<v8::Float32Array> {{ wrapper_name }}::View(v8::Isolate* isolate, {{ name }}* first, size_t count)
+	{
+		// The memory belongs to the registry, the buffer must never free it
+		std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(first, count * sizeof({{ name }}), [](void*, size_t, void*) {}, nullptr);
+		v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, std::move(store));
+		return v8::Float32Array::New(buffer, 0, count * ViewStride);
+	}
+## endif
 
 {% include "EnumImplementation.tpl" %}
 }
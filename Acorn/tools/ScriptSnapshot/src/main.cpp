@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022 Michael Finger
+ *
+ * SPDX-License-Identifier: Apache-2.0 with Commons Clause
+ *
+ * For more Information on the license, see the LICENSE.md file
+ */
+
+#include "core/Log.h"
+#include "utils/v8/V8Snapshot.h"
+
+#include <args.hxx>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+#include <filesystem>
+#include <iostream>
+
+int main(int argc, const char* argv[])
+{
+	args::ArgumentParser parser("Script Snapshot", "Builds the startup snapshot of the Acorn script runtime.");
+	args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+	args::Positional<std::filesystem::path> nodeModulesPath(parser, "node_modules", "Folder of the builtin packages to evaluate into the snapshot.", args::Options::Required);
+	args::Positional<std::filesystem::path> outputPath(parser, "output", "Where to write the snapshot.", args::Options::Required);
+
+	try
+	{
+		parser.ParseCLI(argc, argv);
+	}
+	catch (const args::Help&)
+	{
+		std::cout << parser;
+		return 0;
+	}
+	catch (const args::Error& e)
+	{
+		std::cerr << e.what() << std::endl << parser;
+		return 1;
+	}
+
+	Acorn::Log::Init();
+
+	// Has to match the runtime, V8 refuses a snapshot made with other flags
+	v8::V8::SetFlagsFromString(SCRIPT_RUNTIME_FLAGS);
+	v8::V8::InitializeICUDefaultLocation(argv[0]);
+	v8::V8::InitializeExternalStartupData(argv[0]);
+	std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+	v8::V8::InitializePlatform(platform.get());
+	v8::V8::Initialize();
+
+	bool created = Acorn::V8Snapshot::Create(args::get(outputPath), args::get(nodeModulesPath));
+
+	v8::V8::Dispose();
+	v8::V8::ShutdownPlatform();
+	return created ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #include "ecs/Entity.h"
 #include "ecs/Scene.h"
 #include "ecs/components/Components.h"
+#include "math/Bounds.h"
 #include "renderer/Texture.h"
 #include "utils/fonts/IconsFontAwesome4.h"
 
@@ -55,6 +56,9 @@ namespace Acorn
 		// 	m_CurrentFilePath = defaultProject;
 		// }
 
+		// Scenes load in the background, the editor shows an empty one until then
+		SetEditorScene(CreateRef<Scene>(), "");
+
 		auto commandLineArgs = Application::Get().GetCommandLineArgs();
 		if (commandLineArgs.Count > 1)
 		{
@@ -83,6 +87,17 @@ namespace Acorn
 	void OakLayer::OnUpdate(Timestep ts)
 	{
 		AC_PROFILE_FUNCTION();
+		UpdateSceneLoading();
+
+		if (m_Journal && m_SceneState == SceneState::Edit)
+		{
+			m_TimeSinceAutosave += ts;
+			if (m_TimeSinceAutosave >= AutosaveInterval)
+			{
+				m_Journal->Autosave();
+				m_TimeSinceAutosave = 0.0f;
+			}
+		}
 
 		// Resize
 		if (FrameBufferSpecs specs = m_Framebuffer->GetSpecs();
@@ -129,8 +144,9 @@ namespace Acorn
 
 			if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
 			{
-				int entityId = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
-				m_HoveredEntity = Entity{entityId, m_ActiveScene.get()};
+				// Against the bounds of the scene, reading the entity id attachment back would wait for the GPU
+				glm::vec2 ndc = {mx / viewportSize.x * 2.0f - 1.0f, my / viewportSize.y * 2.0f - 1.0f};
+				m_HoveredEntity = m_ActiveScene->Pick(Math::Ray::FromScreen(ndc, m_EditorCamera.GetViewProjection()));
 			}
 		}
 
@@ -292,6 +308,16 @@ namespace Acorn
 		m_LogPanel->OnImGuiRender();
 		m_ContentBrowserPanel->OnImGuiRender();
 
+		if (m_SceneLoader && m_SceneLoader->GetState() == SceneLoader::State::Loading)
+		{
+			ImGui::Begin("Loading Scene", nullptr, ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_AlwaysAutoResize);
+			ImGui::Text("%s", m_SceneLoader->GetFilePath().c_str());
+			ImGui::ProgressBar(m_SceneLoader->GetProgress());
+			if (ImGui::Button("Cancel"))
+				m_SceneLoader->Cancel();
+			ImGui::End();
+		}
+
 		if (m_WindowsOpen.Stats)
 		{
 			ImGui::Begin("Stats", &m_WindowsOpen.Stats);
@@ -307,6 +333,32 @@ namespace Acorn
 			ImGui::Text("Draw Calls %d", ext2d::Renderer::GetDrawCalls());
 			ImGui::Text("Vertices %d", ext2d::Renderer::GetVertexCount());
 			ImGui::Text("Indices %d", ext2d::Renderer::GetIndexCount());
+			ImGui::Text("GPU Stall %.3f ms", ext2d::Renderer::GetStallTime());
+
+			ext2d::CullingStats culling = ext2d::Renderer::GetCullingStats();
+			ImGui::Text("Culling: Visible %d, Culled %d", culling.Visible, culling.Culled);
+
+			ext2d::BatchBreaks breaks = ext2d::Renderer::GetBatchBreaks();
+			ImGui::Text("Batch Breaks: Full %d, Texture Slots %d, Reserve %d", breaks.BatchFull, breaks.TextureSlotsFull, breaks.Reserve);
+
+#ifndef NO_SCRIPTING
+			for (const V8ScriptTiming& timing : V8Engine::instance().GetUpdateTimings())
+				ImGui::Text("Script %s: %u instances, %.3f ms", timing.Name.c_str(), timing.ScriptCount, timing.Milliseconds);
+
+			if (V8Engine::instance().isRunning())
+			{
+				const V8CodeCacheStats& codeCache = V8Engine::instance().GetCodeCacheStats();
+				ImGui::Text("Code Cache: Hits %u, Misses %u, Rejected %u (%.0f%%)", codeCache.Hits, codeCache.Misses, codeCache.Rejected, codeCache.HitRate() * 100.0f);
+			}
+#endif
+
+			bool sorted = ext2d::Renderer::GetSubmissionMode() == ext2d::SubmissionMode::Sorted;
+			if (ImGui::Checkbox("Sort Draws", &sorted))
+				ext2d::Renderer::SetSubmissionMode(sorted ? ext2d::SubmissionMode::Sorted : ext2d::SubmissionMode::Immediate);
+
+			bool instanced = ext2d::Renderer::GetGeometryMode() == ext2d::GeometryMode::Instanced;
+			if (ImGui::Checkbox("Instanced Quads", &instanced))
+				ext2d::Renderer::SetGeometryMode(instanced ? ext2d::GeometryMode::Instanced : ext2d::GeometryMode::Vertices);
 			ImGui::End();
 		}
 
@@ -354,6 +406,7 @@ namespace Acorn
 					std::filesystem::path fsPath(textureAssetPath);
 
 					spriteRenderer.Texture = Texture2d::Create(fsPath.string());
+					m_HoveredEntity.MarkChanged();
 				}
 
 				ImGui::EndDragDropTarget();
@@ -380,9 +433,8 @@ namespace Acorn
 				glm::mat4 cameraView = m_EditorCamera.GetViewMatrix();
 
 				// Entity transform
-				auto& tc = selectedEntity.GetComponent<Components::Transform>();
-				glm::mat4 transform = tc;
-				glm::vec3 originalRotation = tc.Rotation;
+				// The gizmo works in world space, children are relative to their parent
+				glm::mat4 transform = selectedEntity.GetWorldTransform();
 
 				// Snapping
 				bool snap = Input::IsKeyPressed(KeyCode::LeftControl);
@@ -565,11 +617,27 @@ namespace Acorn
 	void OakLayer::NewScene()
 	{
 		AC_PROFILE_FUNCTION();
+		m_SceneLoader.reset();
 		m_EditorScene = CreateRef<Scene>();
 		m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
 		m_CurrentFilePath = "";
 		m_ActiveScene = m_EditorScene;
+		m_Journal.reset();
+	}
+
+	// Scenes saved with this extension use the binary format, which loads much faster but is not human readable
+	static bool IsBinaryScene(const std::filesystem::path& path)
+	{
+		return path.extension() == ".acornb";
+	}
+
+	static void WriteScene(const Ref<Scene>& scene, const std::string& path)
+	{
+		if (IsBinaryScene(path))
+			SceneSerializer(scene).SerializeRuntime(path);
+		else
+			SceneSerializer(scene).Serialize(path);
 	}
 
 	void OakLayer::SaveScene()
@@ -578,7 +646,9 @@ namespace Acorn
 		if (!m_CurrentFilePath.empty())
 		{
 			AC_CORE_INFO("Saving Scene to {}", m_CurrentFilePath);
-			SceneSerializer(m_ActiveScene).Serialize(m_CurrentFilePath);
+			WriteScene(m_ActiveScene, m_CurrentFilePath);
+			if (m_Journal)
+				m_Journal->Discard();
 		}
 		else
 		{
@@ -589,12 +659,17 @@ namespace Acorn
 	void OakLayer::SaveSceneAs()
 	{
 		AC_PROFILE_FUNCTION();
-		std::string filename = PlatformUtils::SaveFile({"Acorn Scene", "*.acorn"});
+		std::string filename = PlatformUtils::SaveFile({"Acorn Scene", "*.acorn", "Binary Acorn Scene", "*.acornb"});
 		if (!filename.empty())
 		{
 			AC_CORE_INFO("Saving Scene to {}", filename);
 			m_CurrentFilePath = filename;
-			SceneSerializer(m_ActiveScene).Serialize(filename);
+			WriteScene(m_ActiveScene, filename);
+
+			// The journal follows the scene to its new file
+			if (m_Journal)
+				m_Journal->Discard();
+			m_Journal = CreateScope<SceneJournal>(m_EditorScene, filename);
 		}
 	}
 
@@ -604,7 +679,7 @@ namespace Acorn
 		if (m_SceneState != SceneState::Edit)
 			OnSceneStop();
 
-		std::string filename = PlatformUtils::OpenFile({"Acorn Scene", "*.acorn"});
+		std::string filename = PlatformUtils::OpenFile({"Acorn Scene", "*.acorn", "Binary Acorn Scene", "*.acornb"});
 		if (!filename.empty())
 		{
 			OpenScene(filename);
@@ -619,14 +694,80 @@ namespace Acorn
 
 		AC_CORE_INFO("Opening Scene from {}", path.string());
 
-		m_EditorScene = CreateRef<Scene>();
-		if (SceneSerializer(m_EditorScene).Deserialize(path.string()))
+		// Cancels a load that is still running, it would replace this scene once it finishes
+		m_SceneLoader.reset();
+
+		if (IsBinaryScene(path))
+		{
+			// Binary scenes load quickly enough to not need the background loader
+			auto scene = CreateRef<Scene>();
+			if (SceneSerializer(scene).DeserializeRuntime(path.string()))
+				SetEditorScene(scene, path.string());
+			return;
+		}
+
+		m_SceneLoader = CreateScope<SceneLoader>(CreateRef<Scene>(), path.string());
+	}
+
+	void OakLayer::SetEditorScene(const Ref<Scene>& scene, const std::string& filePath)
+	{
+		AC_PROFILE_FUNCTION();
+		if (m_SceneState != SceneState::Edit)
+			OnSceneStop();
+
+		m_EditorScene = scene;
+		m_Journal.reset();
+		m_TimeSinceAutosave = 0.0f;
+		if (!filePath.empty())
+		{
+			// Unsaved changes of an earlier session, e.g. one that crashed
+			bool hasAutosave = SceneJournal::HasAutosave(filePath);
+			Ref<Scene> recovered = hasAutosave ? SceneJournal::Recover(scene, filePath) : nullptr;
+			if (recovered)
+			{
+				AC_CORE_WARN("Recovered unsaved changes of {}, save the scene to keep them", filePath);
+				m_EditorScene = recovered;
+			}
+			else if (hasAutosave)
+			{
+				// Kept for inspection, the new journal would otherwise replace it with the first autosave
+				AC_CORE_ERROR("Could not recover the unsaved changes of {}, kept its autosave files with a .failed suffix", filePath);
+				SceneJournal::SetAside(filePath);
+			}
+
+			m_Journal = CreateScope<SceneJournal>(m_EditorScene, filePath);
+			if (recovered)
+				m_Journal->Compact();
+		}
+
+		m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		m_SceneHierarchyPanel.SetContext(m_EditorScene);
+		m_CurrentFilePath = filePath;
+
+		m_ActiveScene = m_EditorScene;
+	}
+
+	void OakLayer::UpdateSceneLoading()
+	{
+		AC_PROFILE_FUNCTION();
+		if (!m_SceneLoader)
+			return;
+
+		SceneLoader::State state = m_SceneLoader->Update();
+
+		// The scene is shown as soon as all entities are in, textures keep arriving afterwards
+		bool entitiesLoaded = state == SceneLoader::State::StreamingTextures || state == SceneLoader::State::Done;
+		if (entitiesLoaded && m_EditorScene != m_SceneLoader->GetScene())
+		{
+			SetEditorScene(m_SceneLoader->GetScene(), m_SceneLoader->GetFilePath());
+		}
+
+		if (state != SceneLoader::State::Loading && state != SceneLoader::State::StreamingTextures)
 		{
-			m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
-			m_SceneHierarchyPanel.SetContext(m_EditorScene);
-			m_CurrentFilePath = path.string();
+			if (state == SceneLoader::State::Cancelled)
+				AC_CORE_INFO("Cancelled loading {}", m_SceneLoader->GetFilePath());
 
-			m_ActiveScene = m_EditorScene;
+			m_SceneLoader.reset();
 		}
 	}
 
@@ -693,6 +834,19 @@ namespace Acorn
 			ImGui::Checkbox("Show Colliders", &options.ShowColliders);
 			ImGui::Checkbox("Show Camera Frustums", &options.ShowCameraFrustums);
 			ImGui::Checkbox("Show Icons", &options.ShowIcons);
+			ImGui::Checkbox("Parallel Sprites", &options.ParallelSprites);
+			ImGui::Checkbox("Frustum Culling", &options.FrustumCulling);
+			ImGui::Checkbox("Batch Script Updates", &options.BatchScriptUpdates);
+
+			// Applied the next time the scene is played
+			ImGui::Separator();
+			ImGui::TextUnformatted("Physics");
+			ImGui::Checkbox("Fixed Step", &options.Physics.FixedStep);
+			ImGui::DragFloat("Step Rate", &options.Physics.StepRate, 1.0f, 1.0f, 1000.0f, "%.0f Hz");
+			ImGui::DragInt("Velocity Iterations", &options.Physics.VelocityIterations, 1.0f, 1, 100);
+			ImGui::DragInt("Position Iterations", &options.Physics.PositionIterations, 1.0f, 1, 100);
+			ImGui::Checkbox("Interpolate", &options.Physics.Interpolate);
+			ImGui::Checkbox("Physics Thread", &options.Physics.Threaded);
 
 			ImGui::EndPopup();
 		}
@@ -43,6 +43,8 @@ namespace Acorn
 		void SaveScene();
 		void SaveSceneAs();
 		void OpenScene();
+		void SetEditorScene(const Ref<Scene>& scene, const std::string& filePath);
+		void UpdateSceneLoading();
 
 		void OnScenePlay();
 		void OnSceneStop();
@@ -98,5 +100,13 @@ namespace Acorn
 		GizmoType m_GizmoType = GizmoType::Translate;
 
 		std::string m_CurrentFilePath = "";
+
+		// Set while a scene loads in the background
+		Scope<SceneLoader> m_SceneLoader;
+
+		// Autosaves the editor scene once it has a file
+		Scope<SceneJournal> m_Journal;
+		float m_TimeSinceAutosave = 0.0f;
+		static constexpr float AutosaveInterval = 30.0f;
 	};
 }
\ No newline at end of file
@@ -75,11 +75,15 @@ namespace Acorn
 					Entity parent	 = parentComp.Parent;
 					AC_CORE_ASSERT(parent.HasComponent<Components::ChildRelationship>(), "Parent does not have any children.");
 					auto& childComp = parent.GetComponent<Components::ChildRelationship>();
+
+					// Keep the entity where it is in the world
+					glm::mat4 worldMatrix = child.GetWorldTransform();
 					childComp.RemoveEntity(child);
+					child.SetWorldTransform(worldMatrix);
 
 					if (childComp.Empty())
 					{
-						parent.RemoveComponent<Components::ParentRelationship>();
+						parent.RemoveComponent<Components::ChildRelationship>();
 					}
 				}
 			}
@@ -95,6 +99,10 @@ namespace Acorn
 		if (m_SelectionContext)
 		{
 			DrawComponents(m_SelectionContext);
+
+			// The widgets write straight into the components, which entt does not notice
+			if (ImGui::IsAnyItemActive() && ImGui::IsWindowFocused())
+				m_SelectionContext.MarkChanged();
 		}
 		else
 			ImGui::Text("No Selection");
@@ -145,14 +153,30 @@ namespace Acorn
 			{
 				AC_CORE_INFO("DragDropTarget called");
 				Entity* target = (Entity*) payload->Data;
-				if (target->GetUUID() != entity.GetUUID())
+
+				// An entity can not become a child of its own descendant
+				bool isAncestor = false;
+				for (Entity ancestor = entity; ancestor.HasComponent<Components::ParentRelationship>();)
+				{
+					ancestor = ancestor.GetComponent<Components::ParentRelationship>().Parent;
+					isAncestor |= ancestor == *target;
+				}
+
+				if (target->GetUUID() != entity.GetUUID() && !isAncestor)
 				{
 					if (!entity.HasComponent<Components::ChildRelationship>())
 					{
 						entity.AddComponent<Components::ChildRelationship>();
 					}
 					auto& rel = entity.GetComponent<Components::ChildRelationship>();
-					rel.AddEntity(entity, *target, m_Context);
+
+					if (!rel.Contains(*target))
+					{
+						// Keep the entity where it is in the world
+						glm::mat4 worldMatrix = target->GetWorldTransform();
+						rel.AddEntity(entity, *target, m_Context);
+						target->SetWorldTransform(worldMatrix);
+					}
 				}
 			}
 
@@ -22,6 +22,23 @@ declare class ScriptSuperClass {
     GetComponent(type: ComponentTypes.CircleCollider2d): Components.CircleCollider2d;
 }
 
+/**
+ * Float32Array over the transform of the calling entity, writes go straight to the component.
+ * Index it with TransformLayout. Its length drops to 0 once the transforms move, then ask for a new one.
+ */
+declare function GetComponentView(type: ComponentTypes.Transform): Float32Array;
+/**
+ * Every transform of the scene, split into arrays of TransformLayout.stride floats per entity.
+ */
+declare function GetComponentViews(type: ComponentTypes.Transform): Float32Array[];
+
+declare const TransformLayout: {
+    readonly stride: number;
+    readonly Translation: number;
+    readonly Rotation: number;
+    readonly Scale: number;
+};
+
 declare class Input {
     static IsKeyPressed(key: number | string): boolean;
     static IsMouseButtonPressed(button: number): boolean;
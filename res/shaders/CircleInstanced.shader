@@ -0,0 +1,77 @@
+#shader vertex
+#version 450 core
+
+// Shared unit quad
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_CornerTexCoord;
+
+// Per instance, columns 0, 1 and 3 of the transform
+layout(location = 2) in vec3 a_Right;
+layout(location = 3) in vec3 a_Up;
+layout(location = 4) in vec3 a_Translation;
+layout(location = 5) in vec4 a_Color;
+layout(location = 6) in float a_Thickness;
+layout(location = 7) in float a_Fade;
+layout(location = 8) in int a_EntityId;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+
+struct VertexOutput
+{
+    vec3 LocalPosition;
+    vec4 Color;
+    float Thickness;
+    float Fade;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 4) out flat int v_EntityId;
+
+void main()
+{
+    Output.LocalPosition = vec3(a_Corner * 2.0, 0.0);
+    Output.Color = a_Color;
+    Output.Thickness = a_Thickness;
+    Output.Fade = a_Fade;
+
+    v_EntityId = a_EntityId;
+
+    vec3 position = a_Translation + a_Right * a_Corner.x + a_Up * a_Corner.y;
+    gl_Position = u_ViewProjection * vec4(position, 1.0);
+}
+
+#shader fragment
+#version 450 core
+
+struct VertexOutput
+{
+    vec3 LocalPosition;
+    vec4 Color;
+    float Thickness;
+    float Fade;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 4) in flat int v_EntityId;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out int entityId;
+
+void main()
+{
+    float distance = 1.0 - length(Input.LocalPosition);
+    float circleAlpha = smoothstep(0.0, Input.Fade, distance);
+    circleAlpha *= smoothstep(Input.Thickness + Input.Fade, Input.Thickness, distance);
+
+    if (circleAlpha == 0.0)
+        discard;
+
+    fragColor = Input.Color;
+    fragColor.a *= circleAlpha;
+
+    entityId = v_EntityId;
+}
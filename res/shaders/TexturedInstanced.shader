@@ -0,0 +1,69 @@
+#shader vertex
+#version 450 core
+
+// Shared unit quad
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_CornerTexCoord;
+
+// Per instance, columns 0, 1 and 3 of the transform
+layout(location = 2) in vec3 a_Right;
+layout(location = 3) in vec3 a_Up;
+layout(location = 4) in vec3 a_Translation;
+layout(location = 5) in vec4 a_Color;
+layout(location = 6) in vec4 a_TexRect;
+layout(location = 7) in float a_TexIndex;
+layout(location = 8) in float a_TilingFactor;
+layout(location = 9) in int a_EntityId;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+struct VertexOutput
+{
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 3) flat out float v_TexIndex;
+layout(location = 4) flat out int v_EntityId;
+
+void main()
+{
+	vec3 position = a_Translation + a_Right * a_Corner.x + a_Up * a_Corner.y;
+	gl_Position = u_ViewProjection * vec4(position, 1.0);
+
+	Output.Color = a_Color;
+	Output.TexCoord = mix(a_TexRect.xy, a_TexRect.zw, a_CornerTexCoord);
+	Output.TilingFactor = a_TilingFactor;
+	v_TexIndex = a_TexIndex;
+	v_EntityId = a_EntityId;
+}
+
+#shader fragment
+#version 450 core
+
+struct VertexOutput
+{
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 3) flat in float v_TexIndex;
+layout(location = 4) in flat int v_EntityId;
+
+layout(location = 0) out vec4 color;
+layout(location = 1) out int entityId;
+
+layout (binding = 0) uniform sampler2D u_Textures[32];
+
+void main()
+{
+	color = texture(u_Textures[int(v_TexIndex)], Input.TexCoord * Input.TilingFactor) * Input.Color;
+	entityId = v_EntityId;
+}
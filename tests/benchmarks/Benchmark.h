@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Acorn/core/Core.h>
+#include <Acorn/core/Window.h>
+#include <Acorn/debug/Timer.h>
+#include <Acorn/utils/PlatformCapabilities.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+namespace Benchmarks
+{
+	/**
+	 * @brief Run fn iterations times and return the elapsed time in seconds.
+	 */
+	template <typename Fn>
+	double Measure(uint32_t iterations, Fn&& fn)
+	{
+		// Warm up caches and lazily created resources
+		fn();
+
+		Acorn::Timer timer;
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			fn();
+		}
+		return timer.Elapsed();
+	}
+
+	/**
+	 * @brief Print a throughput line and record it as a gtest property, so it ends up in the xml report as well.
+	 */
+	inline void Report(const std::string& name, uint64_t items, double seconds, const char* unit = "items")
+	{
+		double perSecond = seconds > 0.0 ? (double)items / seconds : 0.0;
+		fmt::print("[ BENCH    ] {:<48} {:>14.0f} {}/s ({:.3f} ms)\n", name, perSecond, unit, seconds * 1000.0);
+		::testing::Test::RecordProperty(name, std::to_string((uint64_t)perSecond));
+	}
+
+	/**
+	 * @brief Fixture for benchmarks that need a graphics context.
+	 *
+	 * Creates a small window (and with it the context) once per suite.
+	 */
+	class RendererBenchmark : public ::testing::Test
+	{
+	protected:
+		static void SetUpTestSuite()
+		{
+			Acorn::PlatformCapabilities::Init();
+			s_Window = Acorn::Scope<Acorn::Window>(Acorn::Window::Create(Acorn::WindowProps("Acorn Benchmarks", 64, 64)));
+		}
+
+		static void TearDownTestSuite()
+		{
+			s_Window.reset();
+		}
+
+	private:
+		static inline Acorn::Scope<Acorn::Window> s_Window;
+	};
+}
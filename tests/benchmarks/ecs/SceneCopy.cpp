@@ -0,0 +1,28 @@
+#include "Benchmark.h"
+
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+
+TEST(SceneCopyBenchmark, PlayModeEntry)
+{
+	// Entering play mode copies the editor scene
+	const uint32_t entityCount = 100'000;
+	auto scene = Acorn::CreateRef<Acorn::Scene>();
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		Acorn::Entity entity = scene->CreateEntity("Entity");
+		entity.AddComponent<Acorn::Components::SpriteRenderer>();
+		if (i % 4 == 0)
+			entity.AddComponent<Acorn::Components::RigidBody2d>();
+	}
+
+	Acorn::Ref<Acorn::Scene> copy;
+	double seconds = Benchmarks::Measure(5, [&]()
+		{
+			copy = Acorn::Scene::Copy(scene);
+		});
+	Benchmarks::Report(fmt::format("Scene::Copy ({} entities)", entityCount), (uint64_t)entityCount * 5, seconds, "entities");
+
+	EXPECT_EQ(copy->GetEntitiesWithComponent<Acorn::Components::ID>().size(), entityCount);
+}
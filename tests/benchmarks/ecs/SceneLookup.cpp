@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+
+#include <Acorn/core/UUID.h>
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+#include <Acorn/serialize/Serializer.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+	// Every root gets this many children, so loading resolves a UUID for most entities
+	constexpr uint32_t ChildrenPerRoot = 9;
+
+	class SceneLookupBenchmark : public ::testing::TestWithParam<uint32_t>
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Scene = Acorn::CreateRef<Acorn::Scene>();
+
+			uint32_t count = GetParam();
+			m_Ids.reserve(count);
+
+			Acorn::Entity root;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				Acorn::Entity entity = m_Scene->CreateEntity("Entity");
+				m_Ids.push_back(entity.GetUUID());
+
+				if (i % (ChildrenPerRoot + 1) == 0)
+				{
+					root = entity;
+					root.AddComponent<Acorn::Components::ChildRelationship>();
+					continue;
+				}
+
+				root.GetComponent<Acorn::Components::ChildRelationship>().AddEntity(root, entity, m_Scene);
+			}
+		}
+
+		Acorn::Ref<Acorn::Scene> m_Scene;
+		std::vector<Acorn::UUID> m_Ids;
+	};
+}
+
+TEST_P(SceneLookupBenchmark, GetEntity)
+{
+	uint32_t found = 0;
+	double seconds = Benchmarks::Measure(10, [&]()
+		{
+			for (const auto& id : m_Ids)
+			{
+				found += m_Scene->GetEntity(id) ? 1 : 0;
+			}
+		});
+
+	Benchmarks::Report(fmt::format("Scene::GetEntity ({} entities)", GetParam()), (uint64_t)m_Ids.size() * 10, seconds, "lookups");
+	EXPECT_EQ(found, (uint32_t)m_Ids.size() * 11) << "Every entity should have been found";
+}
+
+TEST_P(SceneLookupBenchmark, Deserialize)
+{
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_benchmark_scene.acorn").string();
+	Acorn::SceneSerializer(m_Scene).Serialize(path);
+
+	Acorn::Ref<Acorn::Scene> loaded;
+	double seconds = Benchmarks::Measure(3, [&]()
+		{
+			loaded = Acorn::CreateRef<Acorn::Scene>();
+			Acorn::SceneSerializer(loaded).Deserialize(path);
+		});
+
+	Benchmarks::Report(fmt::format("SceneSerializer::Deserialize ({} entities)", GetParam()), (uint64_t)m_Ids.size() * 3, seconds, "entities");
+
+	Acorn::Entity child = loaded->GetEntity(m_Ids.back());
+	ASSERT_TRUE(child);
+	EXPECT_TRUE(child.HasComponent<Acorn::Components::ParentRelationship>());
+
+	std::filesystem::remove(path);
+}
+
+TEST_P(SceneLookupBenchmark, CreateAndCopy)
+{
+	double createSeconds = Benchmarks::Measure(3, [&]()
+		{
+			auto scene = Acorn::CreateRef<Acorn::Scene>();
+			for (uint32_t i = 0; i < GetParam(); i++)
+			{
+				scene->CreateEntity("Entity");
+			}
+		});
+	Benchmarks::Report(fmt::format("Scene::CreateEntity ({} entities)", GetParam()), (uint64_t)GetParam() * 3, createSeconds, "entities");
+
+	double copySeconds = Benchmarks::Measure(3, [&]()
+		{
+			Acorn::Scene::Copy(m_Scene);
+		});
+	Benchmarks::Report(fmt::format("Scene::Copy ({} entities)", GetParam()), (uint64_t)GetParam() * 3, copySeconds, "entities");
+}
+
+INSTANTIATE_TEST_SUITE_P(EntityCounts, SceneLookupBenchmark, ::testing::Values(1'000u, 10'000u, 50'000u));
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+
+namespace
+{
+	class SceneSnapshotBenchmark : public ::testing::TestWithParam<uint32_t>
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Scene = Acorn::CreateRef<Acorn::Scene>();
+
+			Acorn::Entity root;
+			for (uint32_t i = 0; i < GetParam(); i++)
+			{
+				Acorn::Entity entity = m_Scene->CreateEntity("Entity");
+				entity.AddComponent<Acorn::Components::SpriteRenderer>();
+				if (i % 3 == 0)
+				{
+					entity.AddComponent<Acorn::Components::RigidBody2d>();
+					entity.AddComponent<Acorn::Components::BoxCollider2d>();
+				}
+
+				if (i % 10 == 0)
+				{
+					root = entity;
+					root.AddComponent<Acorn::Components::ChildRelationship>();
+					continue;
+				}
+
+				root.GetComponent<Acorn::Components::ChildRelationship>().AddEntity(root, entity, m_Scene);
+			}
+		}
+
+		Acorn::Ref<Acorn::Scene> m_Scene;
+	};
+}
+
+TEST_P(SceneSnapshotBenchmark, SnapshotVsCopy)
+{
+	double copySeconds = Benchmarks::Measure(5, [&]()
+		{
+			Acorn::Scene::Copy(m_Scene);
+		});
+	Benchmarks::Report(fmt::format("Scene::Copy ({} entities)", GetParam()), (uint64_t)GetParam() * 5, copySeconds, "entities");
+
+	double snapshotSeconds = Benchmarks::Measure(5, [&]()
+		{
+			m_Scene->Snapshot();
+		});
+	Benchmarks::Report(fmt::format("Scene::Snapshot ({} entities)", GetParam()), (uint64_t)GetParam() * 5, snapshotSeconds, "entities");
+
+	// An edit only invalidates the transform pool, the others are shared with the previous snapshot
+	Acorn::Entity edited = m_Scene->GetEntitiesWithComponent<Acorn::Components::Transform>().front();
+	uint32_t edit = 0;
+	double editSeconds = Benchmarks::Measure(5, [&]()
+		{
+			edited.GetComponent<Acorn::Components::Transform>().Translation.x = (float)++edit;
+			m_Scene->Snapshot();
+		});
+	Benchmarks::Report(fmt::format("Scene::Snapshot after edit ({} entities)", GetParam()), (uint64_t)GetParam() * 5, editSeconds, "entities");
+
+	double restoreSeconds = Benchmarks::Measure(5, [&]()
+		{
+			m_Scene->LoadLastSnapshot();
+		});
+	Benchmarks::Report(fmt::format("Scene::LoadLastSnapshot ({} entities)", GetParam()), (uint64_t)GetParam() * 5, restoreSeconds, "entities");
+
+	EXPECT_EQ(m_Scene->GetEntitiesWithComponent<Acorn::Components::ID>().size(), GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(EntityCounts, SceneSnapshotBenchmark, ::testing::Values(10'000u, 50'000u));
@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+#include <Acorn/renderer/2d/Renderer2D.h>
+#include <Acorn/utils/ThreadPool.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+namespace
+{
+	class SpriteRenderingBenchmark : public Benchmarks::RendererBenchmark, public ::testing::WithParamInterface<uint32_t>
+	{
+	protected:
+		void SetUp() override
+		{
+			Acorn::ext2d::Renderer::Init();
+
+			m_Scene = Acorn::CreateRef<Acorn::Scene>();
+			m_Camera = m_Scene->CreateEntity("Camera");
+			m_Camera.AddComponent<Acorn::Components::CameraComponent>();
+
+			uint32_t count = GetParam();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				Acorn::Entity entity = m_Scene->CreateEntity("Sprite");
+				auto& transform = entity.GetComponent<Acorn::Components::Transform>();
+				transform.Translation = {(float)(i % 1000), (float)(i / 1000), 0.0f};
+				transform.Rotation.z = (float)i;
+				entity.AddComponent<Acorn::Components::SpriteRenderer>(glm::vec4(1.0f));
+			}
+		}
+
+		void TearDown() override
+		{
+			m_Scene.reset();
+			Acorn::ext2d::Renderer::ShutDown();
+		}
+
+		// Keep the total work per measurement roughly constant
+		uint32_t GetFrames() const { return std::max(2u, 2'000'000 / GetParam()); }
+
+		Acorn::Ref<Acorn::Scene> m_Scene;
+		Acorn::Entity m_Camera;
+	};
+}
+
+TEST_P(SpriteRenderingBenchmark, Serial)
+{
+	m_Scene->GetOptions().ParallelSprites = false;
+
+	double seconds = Benchmarks::Measure(GetFrames(), [&]()
+		{ m_Scene->RenderFromCamera(m_Camera); });
+
+	Benchmarks::Report(fmt::format("Scene sprites serial ({})", GetParam()), (uint64_t)GetParam() * GetFrames(), seconds, "sprites");
+}
+
+TEST_P(SpriteRenderingBenchmark, Parallel)
+{
+	m_Scene->GetOptions().ParallelSprites = true;
+
+	double seconds = Benchmarks::Measure(GetFrames(), [&]()
+		{ m_Scene->RenderFromCamera(m_Camera); });
+
+	uint32_t threads = Acorn::Utils::ThreadPool::Get().GetWorkerCount() + 1;
+	Benchmarks::Report(fmt::format("Scene sprites parallel ({}, {} threads)", GetParam(), threads), (uint64_t)GetParam() * GetFrames(), seconds, "sprites");
+}
+
+INSTANTIATE_TEST_SUITE_P(SpriteCounts, SpriteRenderingBenchmark, ::testing::Values(10'000u, 100'000u, 1'000'000u));
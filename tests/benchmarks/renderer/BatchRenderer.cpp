@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+#include <Acorn/renderer/BatchRenderer.h>
+#include <Acorn/renderer/Shader.h>
+#include <Acorn/renderer/Texture.h>
+#include <Acorn/utils/FileUtils.h>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// Mirrors the quad vertex of the 2d renderer
+	struct BenchmarkVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TexCoord;
+		float TexIndex;
+		float TilingFactor;
+		int EntityId = -1;
+	};
+
+	using QuadBatchRenderer = Acorn::BatchRenderer<BenchmarkVertex, 6, 4>;
+
+	constexpr uint32_t QuadCount = 100000;
+	constexpr uint32_t Frames = 20;
+
+	class BatchRendererBenchmark : public Benchmarks::RendererBenchmark
+	{
+	protected:
+		void SetUp() override
+		{
+			m_Layout = {
+				{Acorn::ShaderDataType::Float3, "a_Position"},
+				{Acorn::ShaderDataType::Float4, "a_Color"},
+				{Acorn::ShaderDataType::Float2, "a_TexCoord"},
+				{Acorn::ShaderDataType::Float, "a_TexIndex"},
+				{Acorn::ShaderDataType::Float, "a_TilingFactor"},
+				{Acorn::ShaderDataType::Int, "a_EntityId"},
+			};
+
+			std::array<uint32_t, 6> indices = {0, 1, 2, 2, 3, 0};
+			auto shader = Acorn::Shader::Create(Acorn::Utils::File::ResolveResPath("res/shaders/Textured.shader"));
+			m_Renderer = Acorn::CreateScope<QuadBatchRenderer>(shader, indices, m_Layout);
+
+			m_Texture = Acorn::Texture2d::Create(1, 1);
+			uint32_t white = 0xffffffff;
+			m_Texture->SetData(&white, sizeof(white));
+
+			m_Quads.resize(QuadCount);
+			for (uint32_t i = 0; i < QuadCount; i++)
+			{
+				float x = (float)(i % 1000);
+				float y = (float)(i / 1000);
+				for (uint32_t j = 0; j < 4; j++)
+				{
+					BenchmarkVertex& vertex = m_Quads[i][j];
+					vertex.Position = {x + (j == 1 || j == 2 ? 1.0f : 0.0f), y + (j >= 2 ? 1.0f : 0.0f), 0.0f};
+					vertex.Color = glm::vec4(1.0f);
+					vertex.TexCoord = {j == 1 || j == 2 ? 1.0f : 0.0f, j >= 2 ? 1.0f : 0.0f};
+					vertex.TexIndex = 0.0f;
+					vertex.TilingFactor = 1.0f;
+					vertex.EntityId = (int)i;
+				}
+			}
+		}
+
+		Acorn::BufferLayout m_Layout;
+		Acorn::Scope<QuadBatchRenderer> m_Renderer;
+		Acorn::Ref<Acorn::Texture2d> m_Texture;
+		std::vector<std::array<BenchmarkVertex, 4>> m_Quads;
+	};
+}
+
+TEST_F(BatchRendererBenchmark, PerQuadDraw)
+{
+	double seconds = Benchmarks::Measure(Frames, [&]()
+		{
+			m_Renderer->Begin();
+			for (const auto& quad : m_Quads)
+			{
+				m_Renderer->Draw(m_Texture, quad);
+			}
+			m_Renderer->End();
+		});
+
+	Benchmarks::Report("BatchRenderer::Draw (per quad)", (uint64_t)QuadCount * Frames, seconds, "quads");
+}
+
+TEST_F(BatchRendererBenchmark, DrawBatch)
+{
+	// std::array is tightly packed, so the quads can be viewed as one contiguous vertex run
+	static_assert(sizeof(std::array<BenchmarkVertex, 4>) == 4 * sizeof(BenchmarkVertex));
+	std::span<const BenchmarkVertex> vertices(m_Quads.front().data(), m_Quads.size() * 4);
+
+	double seconds = Benchmarks::Measure(Frames, [&]()
+		{
+			m_Renderer->Begin();
+			m_Renderer->DrawBatch(vertices, m_Texture);
+			m_Renderer->End();
+		});
+
+	Benchmarks::Report("BatchRenderer::DrawBatch", (uint64_t)QuadCount * Frames, seconds, "quads");
+
+	EXPECT_EQ(m_Renderer->GetStats().ObjectCount, QuadCount * (Frames + 1)) << "Every quad should have been submitted";
+}
+
+TEST_F(BatchRendererBenchmark, StreamingModes)
+{
+	static_assert(sizeof(std::array<BenchmarkVertex, 4>) == 4 * sizeof(BenchmarkVertex));
+	std::span<const BenchmarkVertex> vertices(m_Quads.front().data(), m_Quads.size() * 4);
+
+	const std::array<std::pair<Acorn::BufferStreamingMode, const char*>, 3> modes = {{
+		{Acorn::BufferStreamingMode::SubData, "SubData"},
+		{Acorn::BufferStreamingMode::Orphaning, "Orphaning"},
+		{Acorn::BufferStreamingMode::PersistentMapped, "PersistentMapped"},
+	}};
+
+	for (const auto& [mode, name] : modes)
+	{
+		QuadBatchRenderer renderer(m_Renderer->GetShader(), {0, 1, 2, 2, 3, 0}, m_Layout, mode);
+
+		double seconds = Benchmarks::Measure(Frames, [&]()
+			{
+				renderer.Begin();
+				renderer.DrawBatch(vertices, m_Texture);
+				renderer.End();
+			});
+
+		Benchmarks::Report(fmt::format("BatchRenderer streaming ({})", name), (uint64_t)QuadCount * Frames, seconds, "quads");
+		fmt::print("[ BENCH    ] {} stalled {:.3f} ms\n", name, renderer.GetStats().StallTime);
+
+		EXPECT_EQ(renderer.GetStats().ObjectCount, QuadCount * (Frames + 1));
+	}
+}
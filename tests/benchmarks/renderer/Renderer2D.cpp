@@ -0,0 +1,77 @@
+#include "Benchmark.h"
+
+#include <Acorn/renderer/2d/Renderer2D.h>
+#include <Acorn/renderer/EditorCamera.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr uint32_t QuadCount = 100000;
+	constexpr uint32_t Frames = 20;
+
+	class Renderer2DBenchmark : public Benchmarks::RendererBenchmark
+	{
+	protected:
+		void SetUp() override
+		{
+			Acorn::ext2d::Renderer::Init();
+
+			m_Transforms.reserve(QuadCount);
+			for (uint32_t i = 0; i < QuadCount; i++)
+			{
+				glm::vec3 position = {(float)(i % 1000), (float)(i / 1000), 0.0f};
+				m_Transforms.push_back(glm::rotate(glm::translate(glm::mat4(1.0f), position), (float)i, {0.0f, 0.0f, 1.0f}));
+			}
+		}
+
+		void TearDown() override
+		{
+			Acorn::ext2d::Renderer::ShutDown();
+		}
+
+		Acorn::EditorCamera m_Camera;
+		std::vector<glm::mat4> m_Transforms;
+	};
+}
+
+TEST_F(Renderer2DBenchmark, GeometryModes)
+{
+	const std::array<std::pair<Acorn::ext2d::GeometryMode, const char*>, 2> modes = {{
+		{Acorn::ext2d::GeometryMode::Vertices, "Vertices"},
+		{Acorn::ext2d::GeometryMode::Instanced, "Instanced"},
+	}};
+
+	for (const auto& [mode, name] : modes)
+	{
+		Acorn::ext2d::Renderer::SetGeometryMode(mode);
+
+		double quadSeconds = Benchmarks::Measure(Frames, [&]()
+			{
+				Acorn::ext2d::Renderer::BeginScene(m_Camera);
+				for (uint32_t i = 0; i < QuadCount; i++)
+				{
+					Acorn::ext2d::Renderer::FillQuad(m_Transforms[i], glm::vec4(1.0f));
+				}
+				Acorn::ext2d::Renderer::EndScene();
+			});
+
+		double circleSeconds = Benchmarks::Measure(Frames, [&]()
+			{
+				Acorn::ext2d::Renderer::BeginScene(m_Camera);
+				for (uint32_t i = 0; i < QuadCount; i++)
+				{
+					Acorn::ext2d::Renderer::DrawCircle(m_Transforms[i], glm::vec4(1.0f), 1.0f, 0.005f, (int)i);
+				}
+				Acorn::ext2d::Renderer::EndScene();
+			});
+
+		Benchmarks::Report(fmt::format("Renderer2D::FillQuad ({})", name), (uint64_t)QuadCount * Frames, quadSeconds, "quads");
+		Benchmarks::Report(fmt::format("Renderer2D::DrawCircle ({})", name), (uint64_t)QuadCount * Frames, circleSeconds, "circles");
+	}
+}
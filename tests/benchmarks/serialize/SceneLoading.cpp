@@ -0,0 +1,151 @@
+#include "Benchmark.h"
+
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+#include <Acorn/serialize/Serializer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef __linux__
+	// Drops the file from the page cache, so the next load has to go to the disk
+	void EvictFromPageCache(const std::string& path)
+	{
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return;
+
+		fdatasync(file);
+		posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+		close(file);
+	}
+
+	uint64_t ReadStatusKiB(const std::string& key)
+	{
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.rfind(key + ":", 0) == 0)
+				return std::stoull(line.substr(key.size() + 1));
+		}
+		return 0;
+	}
+
+	// Makes VmHWM start over from the current resident size
+	void ResetPeakRss()
+	{
+		std::ofstream("/proc/self/clear_refs") << "5";
+	}
+#endif
+
+	class SceneLoadingBenchmark : public ::testing::TestWithParam<uint32_t>
+	{
+	protected:
+		void SetUp() override
+		{
+			auto scene = Acorn::CreateRef<Acorn::Scene>();
+
+			// A mix of what a typical 2d scene contains, every tenth entity is a root with nine children
+			Acorn::Entity root;
+			for (uint32_t i = 0; i < GetParam(); i++)
+			{
+				Acorn::Entity entity = scene->CreateEntity("Entity");
+				entity.GetComponent<Acorn::Components::Transform>().Translation = {(float)i, 0.0f, 0.0f};
+				entity.AddComponent<Acorn::Components::SpriteRenderer>();
+				if (i % 3 == 0)
+				{
+					entity.AddComponent<Acorn::Components::RigidBody2d>();
+					entity.AddComponent<Acorn::Components::BoxCollider2d>();
+				}
+
+				if (i % 10 == 0)
+				{
+					root = entity;
+					root.AddComponent<Acorn::Components::ChildRelationship>();
+					continue;
+				}
+
+				root.GetComponent<Acorn::Components::ChildRelationship>().AddEntity(root, entity, scene);
+			}
+
+			auto directory = std::filesystem::temp_directory_path();
+			m_YamlPath = (directory / "acorn_benchmark_loading.acorn").string();
+			m_BinaryPath = (directory / "acorn_benchmark_loading.acornb").string();
+			Acorn::SceneSerializer(scene).Serialize(m_YamlPath);
+			Acorn::SceneSerializer(scene).SerializeRuntime(m_BinaryPath);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove(m_YamlPath);
+			std::filesystem::remove(m_BinaryPath);
+		}
+
+		std::string m_YamlPath;
+		std::string m_BinaryPath;
+	};
+}
+
+TEST_P(SceneLoadingBenchmark, YamlVsBinary)
+{
+	double yamlSeconds = Benchmarks::Measure(3, [&]()
+		{
+			Acorn::SceneSerializer(Acorn::CreateRef<Acorn::Scene>()).Deserialize(m_YamlPath);
+		});
+	Benchmarks::Report(fmt::format("YAML scene load ({} entities, {} KiB)", GetParam(), std::filesystem::file_size(m_YamlPath) / 1024),
+		(uint64_t)GetParam() * 3, yamlSeconds, "entities");
+
+	bool loaded = true;
+	double binarySeconds = Benchmarks::Measure(3, [&]()
+		{
+			loaded &= Acorn::SceneSerializer(Acorn::CreateRef<Acorn::Scene>()).DeserializeRuntime(m_BinaryPath);
+		});
+	Benchmarks::Report(fmt::format("Binary scene load ({} entities, {} KiB)", GetParam(), std::filesystem::file_size(m_BinaryPath) / 1024),
+		(uint64_t)GetParam() * 3, binarySeconds, "entities");
+
+	EXPECT_TRUE(loaded);
+}
+
+#ifdef __linux__
+TEST_P(SceneLoadingBenchmark, ColdLoadAndPeakRss)
+{
+	auto measure = [&](const char* name, const std::string& path, bool (Acorn::SceneSerializer::*load)(const std::string&))
+	{
+		constexpr uint32_t iterations = 3;
+		double seconds = 0.0;
+		uint64_t peakKiB = 0;
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			EvictFromPageCache(path);
+			auto scene = Acorn::CreateRef<Acorn::Scene>();
+
+			ResetPeakRss();
+			uint64_t baseKiB = ReadStatusKiB("VmRSS");
+			Acorn::Timer timer;
+			EXPECT_TRUE((Acorn::SceneSerializer(scene).*load)(path));
+			seconds += timer.Elapsed();
+			uint64_t highWaterKiB = ReadStatusKiB("VmHWM");
+			peakKiB = std::max(peakKiB, highWaterKiB > baseKiB ? highWaterKiB - baseKiB : 0);
+		}
+
+		Benchmarks::Report(fmt::format("{} cold load ({} entities, peak +{} KiB)", name, GetParam(), peakKiB),
+			(uint64_t)GetParam() * iterations, seconds, "entities");
+	};
+
+	measure("YAML", m_YamlPath, &Acorn::SceneSerializer::Deserialize);
+	measure("Binary", m_BinaryPath, &Acorn::SceneSerializer::DeserializeRuntime);
+}
+#endif
+
+INSTANTIATE_TEST_SUITE_P(EntityCounts, SceneLoadingBenchmark, ::testing::Values(10'000u, 50'000u));
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include <Acorn/core/UUID.h>
+
+#include <string>
+#include <unordered_set>
+
+TEST(UUID, TextRoundTrip)
+{
+	Acorn::UUID uuid;
+	std::string text = uuid;
+
+	ASSERT_EQ(text.size(), Acorn::UUID::StringLength);
+	EXPECT_EQ(text[14], '4') << "Random UUIDs are version 4";
+	EXPECT_EQ(Acorn::UUID(text), uuid);
+}
+
+TEST(UUID, ParsesExistingSceneIds)
+{
+	auto uuid = Acorn::UUID::FromChars("0f8FAD5B-d9cb-469f-a165-70867728950e");
+	ASSERT_TRUE(uuid);
+	EXPECT_EQ(uuid->GetHigh(), 0x0f8fad5bd9cb469full);
+	EXPECT_EQ(uuid->GetLow(), 0xa16570867728950eull);
+	EXPECT_EQ((std::string)*uuid, "0f8fad5b-d9cb-469f-a165-70867728950e");
+
+	EXPECT_EQ(Acorn::UUID::FromChars("{0f8fad5bd9cb469fa16570867728950e}"), uuid);
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8fad5b-d9cb-469f-a165"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8fad5b-d9cb-469f-a165-70867728950x"));
+}
+
+TEST(UUID, DashesOnlyInCanonicalPlaces)
+{
+	EXPECT_TRUE(Acorn::UUID::FromChars("0f8fad5bd9cb469fa16570867728950e"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8fad5bd-9cb-469f-a165-70867728950e"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8f-ad5b-d9cb-469f-a165-7086-7728-950e"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("-0f8fad5bd9cb469fa16570867728950e"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8fad5b-d9cb-469f-a165-70867728950e-"));
+	EXPECT_FALSE(Acorn::UUID::FromChars("0f8fad5b-d9cb-469f-a16570867728950e"));
+	EXPECT_FALSE(Acorn::UUID::FromChars(""));
+}
+
+TEST(UUID, GeneratesDistinctIds)
+{
+	std::unordered_set<Acorn::UUID> ids;
+	for (int i = 0; i < 100'000; i++)
+	{
+		ASSERT_TRUE(ids.insert(Acorn::UUID()).second);
+	}
+}
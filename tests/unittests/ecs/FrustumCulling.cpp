@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+#include <Acorn/renderer/2d/Renderer2D.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+using namespace Acorn;
+
+// Sees x and y from -10 to 10
+static const glm::mat4 ViewProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, -1.0f, 1.0f);
+
+static Entity CreateSprite(const Ref<Scene>& scene, const glm::vec3& translation)
+{
+	Entity entity = scene->CreateEntity();
+	entity.GetComponent<Components::Transform>().Translation = translation;
+	entity.AddComponent<Components::SpriteRenderer>();
+	return entity;
+}
+
+static Entity CreateCircle(const Ref<Scene>& scene, const glm::vec3& translation)
+{
+	Entity entity = scene->CreateEntity();
+	entity.GetComponent<Components::Transform>().Translation = translation;
+	entity.AddComponent<Components::CircleRenderer>();
+	return entity;
+}
+
+// Visible and culled count of one CollectVisible, the renderer only keeps the sums
+static ext2d::CullingStats CollectVisible(const Ref<Scene>& scene)
+{
+	ext2d::CullingStats before = ext2d::Renderer::GetCullingStats();
+	scene->CollectVisible(ViewProjection);
+	ext2d::CullingStats after = ext2d::Renderer::GetCullingStats();
+	return {after.Visible - before.Visible, after.Culled - before.Culled};
+}
+
+TEST(FrustumCulling, OnlyCollectsWhatTheCameraSees)
+{
+	auto scene = CreateRef<Scene>();
+	Entity inside = CreateSprite(scene, {0.0f, 0.0f, 0.0f});
+	CreateSprite(scene, {50.0f, 0.0f, 0.0f});
+	// Its center is out of view, but half of the quad is not
+	Entity edge = CreateSprite(scene, {10.25f, -3.0f, 0.0f});
+	Entity circle = CreateCircle(scene, {-4.0f, 4.0f, 0.0f});
+	CreateCircle(scene, {0.0f, -30.0f, 0.0f});
+
+	scene->UpdateWorldTransforms();
+	ext2d::CullingStats stats = CollectVisible(scene);
+
+	// In the order of the sprite pool, which is the order they were added in
+	std::vector<entt::entity> sprites = {inside, edge};
+	std::vector<entt::entity> circles = {circle};
+	EXPECT_EQ(scene->GetVisibleSprites(), sprites);
+	EXPECT_EQ(scene->GetVisibleCircles(), circles);
+	EXPECT_EQ(stats.Visible, 3u);
+	EXPECT_EQ(stats.Culled, 2u);
+}
+
+TEST(FrustumCulling, FollowsMovedEntities)
+{
+	auto scene = CreateRef<Scene>();
+	Entity parent = scene->CreateEntity("Parent");
+	Entity child = CreateSprite(scene, {2.0f, 0.0f, 0.0f});
+	parent.AddComponent<Components::ChildRelationship>().AddEntity(parent, child, scene);
+	Entity still = CreateSprite(scene, {-2.0f, 0.0f, 0.0f});
+
+	scene->UpdateWorldTransforms();
+	ext2d::CullingStats stats = CollectVisible(scene);
+	EXPECT_EQ(scene->GetVisibleSprites().size(), 2u);
+	EXPECT_EQ(stats.Culled, 0u);
+
+	// Only the parent moves, the bounds of the child follow once the world transforms are updated
+	parent.GetComponent<Components::Transform>().Translation = {40.0f, 0.0f, 0.0f};
+	scene->UpdateWorldTransforms();
+	stats = CollectVisible(scene);
+	std::vector<entt::entity> sprites = {still};
+	EXPECT_EQ(scene->GetVisibleSprites(), sprites);
+	EXPECT_EQ(stats.Visible, 1u);
+	EXPECT_EQ(stats.Culled, 1u);
+
+	parent.GetComponent<Components::Transform>().Translation = {0.0f, 0.0f, 0.0f};
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(CollectVisible(scene).Visible, 2u);
+}
+
+TEST(FrustumCulling, CanBeTurnedOff)
+{
+	auto scene = CreateRef<Scene>();
+	CreateSprite(scene, {0.0f, 0.0f, 0.0f});
+	CreateSprite(scene, {50.0f, 0.0f, 0.0f});
+	scene->GetOptions().FrustumCulling = false;
+
+	scene->UpdateWorldTransforms();
+	ext2d::CullingStats stats = CollectVisible(scene);
+	EXPECT_EQ(scene->GetVisibleSprites().size(), 2u);
+	EXPECT_EQ(stats.Visible, 2u);
+	EXPECT_EQ(stats.Culled, 0u);
+}
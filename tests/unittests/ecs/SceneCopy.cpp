@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+
+#include <glm/glm.hpp>
+
+using namespace Acorn;
+
+TEST(SceneCopy, KeepsEntitiesAndHierarchy)
+{
+	auto scene = CreateRef<Scene>();
+	Entity parent = scene->CreateEntity("Parent");
+	Entity child = scene->CreateEntity("Child");
+	scene->DestroyEntity(scene->CreateEntity("Gap"));
+	Entity last = scene->CreateEntity("Last");
+	parent.AddComponent<Components::ChildRelationship>().AddEntity(parent, child, scene);
+	parent.GetComponent<Components::Transform>().Translation = {1.0f, 2.0f, 0.0f};
+	last.AddComponent<Components::SpriteRenderer>().Color = {0.0f, 1.0f, 0.0f, 1.0f};
+
+	auto copy = Scene::Copy(scene);
+
+	Entity copiedParent = copy->GetEntity(parent.GetUUID());
+	Entity copiedChild = copy->GetEntity(child.GetUUID());
+	Entity copiedLast = copy->GetEntity(last.GetUUID());
+	ASSERT_TRUE(copiedParent && copiedChild && copiedLast);
+	EXPECT_EQ((entt::entity)copiedLast, (entt::entity)last);
+	EXPECT_EQ(copiedParent.GetName(), "Parent");
+	EXPECT_EQ(copiedLast.GetComponent<Components::SpriteRenderer>().Color, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+	// Relationships point into the copy, not into the source scene
+	EXPECT_EQ(copiedChild.GetComponent<Components::ParentRelationship>().Parent, copiedParent);
+	EXPECT_EQ(copiedParent.GetComponent<Components::ChildRelationship>().Entities.front(), copiedChild);
+
+	copiedParent.GetComponent<Components::Transform>().Translation.x = 5.0f;
+	copy->UpdateWorldTransforms();
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(glm::vec3(copiedChild.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(5.0f, 2.0f, 0.0f));
+	EXPECT_EQ(glm::vec3(child.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(1.0f, 2.0f, 0.0f));
+}
+
+TEST(SceneCopy, DuplicateCopiesComponents)
+{
+	auto scene = CreateRef<Scene>();
+	Entity entity = scene->CreateEntity("Sprite");
+	entity.GetComponent<Components::Transform>().Translation = {3.0f, 0.0f, 0.0f};
+	entity.AddComponent<Components::SpriteRenderer>().TilingFactor = 2.0f;
+
+	Entity duplicate = scene->DuplicateEntity(entity);
+
+	EXPECT_NE(duplicate.GetUUID(), entity.GetUUID());
+	EXPECT_EQ(duplicate.GetName(), "Sprite - Copy");
+	EXPECT_EQ(duplicate.GetComponent<Components::Transform>().Translation, glm::vec3(3.0f, 0.0f, 0.0f));
+	EXPECT_EQ(duplicate.GetComponent<Components::SpriteRenderer>().TilingFactor, 2.0f);
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+
+#include <glm/glm.hpp>
+
+using namespace Acorn;
+
+TEST(SceneSnapshot, RestoresComponentsAndEntities)
+{
+	auto scene = CreateRef<Scene>();
+	Entity parent = scene->CreateEntity("Parent");
+	Entity child = scene->CreateEntity("Child");
+	parent.AddComponent<Components::ChildRelationship>().AddEntity(parent, child, scene);
+	parent.AddComponent<Components::SpriteRenderer>().Color = {1.0f, 0.0f, 0.0f, 1.0f};
+	child.GetComponent<Components::Transform>().Translation = {1.0f, 0.0f, 0.0f};
+	UUID parentId = parent.GetUUID();
+
+	scene->Snapshot();
+
+	parent.GetComponent<Components::Transform>().Translation = {5.0f, 0.0f, 0.0f};
+	parent.RemoveComponent<Components::SpriteRenderer>();
+	scene->CreateEntity("Added later");
+	scene->DestroyEntity(child);
+
+	scene->LoadLastSnapshot();
+	scene->UpdateWorldTransforms();
+
+	// Handles taken before the snapshot still point at the same entities
+	EXPECT_EQ(scene->GetEntity(parentId), parent);
+	EXPECT_EQ(parent.GetComponent<Components::Transform>().Translation, glm::vec3(0.0f));
+	ASSERT_TRUE(parent.HasComponent<Components::SpriteRenderer>());
+	EXPECT_EQ(parent.GetComponent<Components::SpriteRenderer>().Color, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+	EXPECT_EQ(scene->GetEntitiesWithComponent<Components::ID>().size(), 2u);
+
+	ASSERT_TRUE(child.HasComponent<Components::ParentRelationship>());
+	EXPECT_EQ(child.GetComponent<Components::ParentRelationship>().Parent, parent);
+	EXPECT_EQ(glm::vec3(child.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST(SceneSnapshot, SlotsAreIndependent)
+{
+	auto scene = CreateRef<Scene>();
+	Entity entity = scene->CreateEntity();
+
+	for (int i = 0; i < 3; i++)
+	{
+		entity.GetComponent<Components::Transform>().Translation.x = (float)i;
+		scene->Snapshot();
+	}
+	ASSERT_EQ(scene->GetSnapshotCount(), 3u);
+
+	scene->LoadSnapshot(1);
+	EXPECT_EQ(entity.GetComponent<Components::Transform>().Translation.x, 1.0f);
+	scene->LoadSnapshot(0);
+	EXPECT_EQ(entity.GetComponent<Components::Transform>().Translation.x, 0.0f);
+
+	scene->DropSnapshots(1);
+	scene->LoadLastSnapshot();
+	EXPECT_EQ(entity.GetComponent<Components::Transform>().Translation.x, 1.0f);
+}
+
+TEST(SceneSnapshot, KeepsPoolOrder)
+{
+	auto scene = CreateRef<Scene>();
+	for (int i = 0; i < 5; i++)
+	{
+		Entity entity = scene->CreateEntity();
+		entity.GetComponent<Components::Transform>().Translation.x = (float)i;
+		if (i % 2 == 0)
+			entity.AddComponent<Components::SpriteRenderer>();
+	}
+	scene->UpdateWorldTransforms();
+
+	// Sprites draw in pool order and scripts see the transforms in it, so a restore must not change it
+	auto transforms = scene->GetEntitiesWithComponent<Components::Transform>();
+	auto sprites = scene->GetEntitiesWithComponent<Components::SpriteRenderer>();
+
+	scene->Snapshot();
+	scene->LoadLastSnapshot();
+	EXPECT_EQ(scene->GetEntitiesWithComponent<Components::Transform>(), transforms);
+	EXPECT_EQ(scene->GetEntitiesWithComponent<Components::SpriteRenderer>(), sprites);
+
+	// A second snapshot shares the unchanged pools, restoring it must not reverse them either
+	scene->Snapshot();
+	scene->LoadLastSnapshot();
+	EXPECT_EQ(scene->GetEntitiesWithComponent<Components::Transform>(), transforms);
+	EXPECT_EQ(scene->GetEntitiesWithComponent<Components::SpriteRenderer>(), sprites);
+}
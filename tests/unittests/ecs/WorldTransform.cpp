@@ -0,0 +1,180 @@
+#include "gtest/gtest.h"
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+using namespace Acorn;
+
+TEST(WorldTransform, ChildrenFollowTheirParent)
+{
+	auto scene = CreateRef<Scene>();
+	Entity parent = scene->CreateEntity("Parent");
+	Entity child = scene->CreateEntity("Child");
+
+	parent.AddComponent<Components::ChildRelationship>().AddEntity(parent, child, scene);
+	parent.GetComponent<Components::Transform>().Translation = {1.0f, 2.0f, 0.0f};
+	child.GetComponent<Components::Transform>().Translation = {3.0f, 0.0f, 0.0f};
+
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(glm::vec3(child.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(4.0f, 2.0f, 0.0f));
+
+	parent.GetComponent<Components::Transform>().Translation.y = 5.0f;
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(glm::vec3(child.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(4.0f, 5.0f, 0.0f));
+	EXPECT_EQ(child.GetComponent<Components::WorldTransform>().Matrix, child.GetWorldTransform());
+}
+
+TEST(WorldTransform, StaticEntitiesAreNotRebuilt)
+{
+	auto scene = CreateRef<Scene>();
+	Entity entity = scene->CreateEntity();
+	entity.GetComponent<Components::Transform>().Translation = {1.0f, 0.0f, 0.0f};
+
+	scene->UpdateWorldTransforms();
+
+	// A matrix that is rebuilt would lose this marker
+	auto& worldTransform = entity.GetComponent<Components::WorldTransform>();
+	worldTransform.Matrix[3].w = 2.0f;
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(worldTransform.Matrix[3].w, 2.0f);
+
+	entity.GetComponent<Components::Transform>().Translation.x = 2.0f;
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(worldTransform.Matrix[3], glm::vec4(2.0f, 0.0f, 0.0f, 1.0f));
+}
+
+TEST(WorldTransform, ChildrenCreatedBeforeTheirParent)
+{
+	auto scene = CreateRef<Scene>();
+	Entity grandChild = scene->CreateEntity("GrandChild");
+	Entity child = scene->CreateEntity("Child");
+	Entity root = scene->CreateEntity("Root");
+
+	root.AddComponent<Components::ChildRelationship>().AddEntity(root, child, scene);
+	child.AddComponent<Components::ChildRelationship>().AddEntity(child, grandChild, scene);
+	EXPECT_TRUE(child.GetComponent<Components::ChildRelationship>().Contains(grandChild));
+	EXPECT_FALSE(root.GetComponent<Components::ChildRelationship>().Contains(grandChild));
+
+	for (Entity entity : {root, child, grandChild})
+	{
+		entity.GetComponent<Components::Transform>().Translation = {1.0f, 0.0f, 0.0f};
+	}
+
+	// A single sweep has to see every parent before its children
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(glm::vec3(grandChild.GetComponent<Components::WorldTransform>().Matrix[3]), glm::vec3(3.0f, 0.0f, 0.0f));
+}
+
+TEST(WorldTransform, BoundsFollowTheTransform)
+{
+	auto scene = CreateRef<Scene>();
+	Entity sprite = scene->CreateEntity("Sprite");
+	sprite.AddComponent<Components::SpriteRenderer>();
+	sprite.GetComponent<Components::Transform>().Translation = {3.0f, 0.0f, 0.0f};
+	scene->UpdateWorldTransforms();
+
+	Math::Ray ray = {{3.0f, 0.0f, 10.0f}, {0.0f, 0.0f, -1.0f}};
+	EXPECT_EQ(scene->Pick(ray), sprite);
+
+	sprite.GetComponent<Components::Transform>().Translation = {6.0f, 0.0f, 0.0f};
+	scene->UpdateWorldTransforms();
+	EXPECT_FALSE(scene->Pick(ray));
+
+	ray.Origin.x = 6.0f;
+	EXPECT_EQ(scene->Pick(ray), sprite);
+
+	sprite.RemoveComponent<Components::SpriteRenderer>();
+	scene->UpdateWorldTransforms();
+	EXPECT_FALSE(scene->Pick(ray));
+}
+
+TEST(WorldTransform, CollidersAreQueriedThroughTheBounds)
+{
+	auto scene = CreateRef<Scene>();
+	Entity box = scene->CreateEntity("Box");
+	box.AddComponent<Components::BoxCollider2d>().SetSize({1.0f, 0.5f});
+	box.GetComponent<Components::Transform>().Translation = {4.0f, 0.0f, 0.0f};
+	Entity circle = scene->CreateEntity("Circle");
+	circle.AddComponent<Components::CircleCollider2d>().SetRadius(1.0f);
+	scene->UpdateWorldTransforms();
+
+	std::vector<Entity> hits;
+	scene->QueryColliders({4.9f, 0.4f}, hits);
+	EXPECT_EQ(hits, std::vector<Entity>{box});
+	scene->QueryColliders({0.6f, 0.6f}, hits);
+	EXPECT_EQ(hits, std::vector<Entity>{circle});
+
+	// Inside the bounds of the circle, but not the circle itself
+	scene->QueryColliders({0.9f, 0.9f}, hits);
+	EXPECT_TRUE(hits.empty());
+
+	// The box size scales with the entity and follows its rotation
+	box.GetComponent<Components::Transform>().Rotation.z = glm::radians(90.0f);
+	box.GetComponent<Components::Transform>().Scale = {2.0f, 1.0f, 1.0f};
+	scene->UpdateWorldTransforms();
+	scene->QueryColliders({4.0f, 1.9f}, hits);
+	EXPECT_EQ(hits, std::vector<Entity>{box});
+	scene->QueryColliders({4.9f, 0.0f}, hits);
+	EXPECT_TRUE(hits.empty());
+
+	// Sizes are edited in place, marking the entity changed refreshes its bounds
+	box.GetComponent<Components::BoxCollider2d>().SetSize({1.0f, 3.0f});
+	box.MarkChanged();
+	scene->UpdateWorldTransforms();
+	scene->QueryColliders({6.9f, 0.0f}, hits);
+	EXPECT_EQ(hits, std::vector<Entity>{box});
+
+	box.RemoveComponent<Components::BoxCollider2d>();
+	scene->UpdateWorldTransforms();
+	scene->QueryColliders({4.0f, 0.0f}, hits);
+	EXPECT_TRUE(hits.empty());
+}
+
+TEST(WorldTransform, UntouchedHierarchiesAreNotRebuilt)
+{
+	auto scene = CreateRef<Scene>();
+	Entity moving = scene->CreateEntity("Moving");
+	Entity movingChild = scene->CreateEntity("MovingChild");
+	Entity still = scene->CreateEntity("Still");
+	Entity stillChild = scene->CreateEntity("StillChild");
+
+	moving.AddComponent<Components::ChildRelationship>().AddEntity(moving, movingChild, scene);
+	still.AddComponent<Components::ChildRelationship>().AddEntity(still, stillChild, scene);
+	scene->UpdateWorldTransforms();
+
+	// A matrix that is rebuilt would lose this marker
+	auto& stillMatrix = stillChild.GetComponent<Components::WorldTransform>().Matrix;
+	stillMatrix[3].w = 2.0f;
+
+	moving.GetComponent<Components::Transform>().Translation.x = 1.0f;
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(stillMatrix[3].w, 2.0f);
+	EXPECT_EQ(movingChild.GetComponent<Components::WorldTransform>().Matrix[3], glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+}
+
+TEST(WorldTransform, ReparentedEntitiesFollowTheirNewParent)
+{
+	auto scene = CreateRef<Scene>();
+	Entity first = scene->CreateEntity("First");
+	Entity second = scene->CreateEntity("Second");
+	Entity child = scene->CreateEntity("Child");
+
+	first.GetComponent<Components::Transform>().Translation.x = 1.0f;
+	second.GetComponent<Components::Transform>().Translation.x = 2.0f;
+	first.AddComponent<Components::ChildRelationship>().AddEntity(first, child, scene);
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(child.GetComponent<Components::WorldTransform>().Matrix[3].x, 1.0f);
+
+	// Only the parent changes, the local values of the child stay the same
+	second.AddComponent<Components::ChildRelationship>().AddEntity(second, child, scene);
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(child.GetComponent<Components::WorldTransform>().Matrix[3].x, 2.0f);
+
+	second.GetComponent<Components::ChildRelationship>().RemoveEntity(child);
+	scene->UpdateWorldTransforms();
+	EXPECT_EQ(child.GetComponent<Components::WorldTransform>().Matrix[3].x, 0.0f);
+}
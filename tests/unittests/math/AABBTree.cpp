@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include <Acorn/math/AABBTree.h>
+#include <Acorn/math/Bounds.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Acorn;
+
+TEST(AABBTree, QueriesFindEveryOverlap)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	auto randomBox = [&]()
+	{
+		glm::vec3 min = {position(random), position(random), 0.0f};
+		return Math::AABB{min, min + glm::vec3(1.0f, 1.0f, 0.0f)};
+	};
+
+	Math::AABBTree tree;
+	std::vector<Math::AABB> boxes(2000);
+	std::vector<int32_t> proxies(boxes.size());
+	for (uint32_t i = 0; i < boxes.size(); i++)
+	{
+		boxes[i] = randomBox();
+		proxies[i] = tree.CreateProxy(boxes[i], i);
+	}
+
+	// Moves every third box and removes every seventh
+	for (uint32_t i = 0; i < boxes.size(); i++)
+	{
+		if (i % 7 == 0)
+		{
+			tree.DestroyProxy(proxies[i]);
+			proxies[i] = Math::AABBTree::Null;
+		}
+		else if (i % 3 == 0)
+		{
+			boxes[i] = randomBox();
+			tree.MoveProxy(proxies[i], boxes[i]);
+		}
+	}
+
+	for (int query = 0; query < 50; query++)
+	{
+		Math::AABB area = randomBox().Expanded({10.0f, 10.0f, 0.0f});
+		std::vector<uint32_t> found;
+		tree.Query([&](const Math::AABB& box)
+			{
+				return box.Overlaps(area);
+			},
+			[&](uint32_t i)
+			{
+				found.push_back(i);
+			});
+
+		for (uint32_t i = 0; i < boxes.size(); i++)
+		{
+			if (proxies[i] != Math::AABBTree::Null && boxes[i].Overlaps(area))
+				EXPECT_NE(std::find(found.begin(), found.end(), i), found.end());
+		}
+	}
+
+	EXPECT_EQ(tree.GetProxyCount(), boxes.size() - (boxes.size() + 6) / 7);
+	// Balanced, a degenerate tree would be as deep as it has proxies
+	EXPECT_LT(tree.GetHeight(), 32);
+}
+
+TEST(AABBTree, FrustumOfARectangle)
+{
+	glm::mat4 viewProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, -1.0f, 1.0f);
+	Math::Frustum frustum = Math::Frustum::FromRect(viewProjection, {0.0f, 0.0f}, {1.0f, 1.0f});
+
+	EXPECT_TRUE(frustum.Intersects({{4.0f, 4.0f, 0.0f}, {6.0f, 6.0f, 0.0f}}));
+	EXPECT_TRUE(frustum.Intersects({{-1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}));
+	EXPECT_FALSE(frustum.Intersects({{-6.0f, 4.0f, 0.0f}, {-4.0f, 6.0f, 0.0f}}));
+	EXPECT_FALSE(frustum.Intersects({{4.0f, 4.0f, 2.0f}, {6.0f, 6.0f, 3.0f}}));
+}
@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include <Acorn/physics/PhysicsWorld.h>
+
+#include <box2d/b2_body.h>
+#include <box2d/b2_world.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace Acorn;
+
+static b2Body* AddFallingBody(Physics2D::World& world)
+{
+	b2BodyDef bodyDef;
+	bodyDef.type = b2_dynamicBody;
+	b2Body* body = world.GetB2World()->CreateBody(&bodyDef);
+	world.AddBody(body);
+	return body;
+}
+
+TEST(PhysicsWorld, FixedStepsAreIndependentOfTheFrameRate)
+{
+	Physics2D::WorldSettings settings;
+	// Powers of two keep the accumulated frame times exact
+	settings.StepRate = 64.0f;
+	settings.Interpolate = false;
+
+	Physics2D::World fast({0.0f, -10.0f}, settings);
+	Physics2D::World slow({0.0f, -10.0f}, settings);
+	AddFallingBody(fast);
+	AddFallingBody(slow);
+	fast.Start();
+	slow.Start();
+
+	// One second at 256 and at 16 frames per second
+	for (int i = 0; i < 256; i++)
+		fast.Advance(1.0f / 256.0f);
+	for (int i = 0; i < 16; i++)
+		slow.Advance(1.0f / 16.0f);
+
+	EXPECT_EQ(fast.GetStepCount(), 64u);
+	EXPECT_EQ(slow.GetStepCount(), 64u);
+	EXPECT_EQ(fast.GetInterpolatedState(0).Position.y, slow.GetInterpolatedState(0).Position.y);
+}
+
+TEST(PhysicsWorld, InterpolatesBetweenSteps)
+{
+	Physics2D::WorldSettings settings;
+	settings.StepRate = 10.0f;
+
+	Physics2D::World world({0.0f, -10.0f}, settings);
+	AddFallingBody(world);
+	world.Start();
+
+	world.Advance(0.2f);
+	float previous = world.GetInterpolatedState(0).Position.y;
+	world.Advance(0.05f);
+	float halfway = world.GetInterpolatedState(0).Position.y;
+	world.Advance(0.05f);
+	float next = world.GetInterpolatedState(0).Position.y;
+
+	EXPECT_LT(halfway, previous);
+	EXPECT_LT(next, halfway);
+}
+
+TEST(PhysicsWorld, ThreadPublishesSteps)
+{
+	Physics2D::WorldSettings settings;
+	settings.Threaded = true;
+
+	Physics2D::World world({0.0f, -10.0f}, settings);
+	AddFallingBody(world);
+	world.Start();
+
+	for (int i = 0; i < 1000 && world.GetStepCount() < 10; i++)
+	{
+		world.Advance(1.0f / 60.0f);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	EXPECT_GE(world.GetStepCount(), 10u);
+	EXPECT_LT(world.GetInterpolatedState(0).Position.y, 0.0f);
+}
+
+TEST(PhysicsWorld, OnlyReportsMovingBodies)
+{
+	Physics2D::World world({0.0f, 0.0f}, {});
+	b2BodyDef groundDef;
+	world.AddBody(world.GetB2World()->CreateBody(&groundDef));
+	AddFallingBody(world);
+	world.Start();
+
+	world.Advance(1.0f / 60.0f);
+	ASSERT_EQ(world.GetMovingBodies().size(), 1u);
+	EXPECT_EQ(world.GetMovingBodies()[0], 1u);
+
+	// Without gravity the body does not move and falls asleep
+	for (int i = 0; i < 120; i++)
+	{
+		world.ClearMovingBodies();
+		world.Advance(1.0f / 60.0f);
+	}
+	EXPECT_TRUE(world.GetMovingBodies().empty());
+}
+
+TEST(PhysicsWorld, KeepsBodiesThatSleptWithinAFrame)
+{
+	Physics2D::WorldSettings settings;
+	settings.Interpolate = false;
+
+	Physics2D::World world({0.0f, 0.0f}, settings);
+	b2Body* body = AddFallingBody(world);
+	// Slides to a stop and falls asleep, in the middle of a frame
+	body->SetLinearVelocity({1.0f, 0.0f});
+	body->SetLinearDamping(10.0f);
+	world.Start();
+
+	// What a scene would have written back, read once per frame of 8 steps
+	Physics2D::BodyState written;
+	int asleepFrames = 0;
+	for (int frame = 0; frame < 60 && asleepFrames < 3; frame++)
+	{
+		world.Advance(8.0f / 60.0f);
+		for (uint32_t i : world.GetMovingBodies())
+			written = world.GetInterpolatedState(i);
+		world.ClearMovingBodies();
+
+		if (!body->IsAwake())
+			asleepFrames++;
+	}
+
+	ASSERT_EQ(asleepFrames, 3) << "Body should have fallen asleep";
+	EXPECT_TRUE(world.GetMovingBodies().empty()) << "A sleeping body should not be reported forever";
+	EXPECT_EQ(written.Position.x, body->GetPosition().x) << "The pose the body fell asleep in should have been read";
+	EXPECT_GT(written.Position.x, 0.0f);
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include <Acorn/physics/StaticGeometry.h>
+
+using namespace Acorn;
+
+static void AddTiles(Physics2D::StaticGeometry& geometry, int width, int height)
+{
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			Physics2D::StaticBox box;
+			box.Center = {(float)x, (float)y};
+			box.Owner = (uint32_t)(y * width + x);
+			geometry.Add(box);
+		}
+	}
+}
+
+TEST(StaticGeometry, MergesAGridIntoOneBox)
+{
+	Physics2D::StaticGeometry geometry;
+	geometry.Begin();
+	AddTiles(geometry, 16, 4);
+	EXPECT_FALSE(geometry.Build());
+
+	ASSERT_EQ(geometry.GetMergedBoxes().size(), 1u);
+	const auto& merged = geometry.GetMergedBoxes()[0];
+	EXPECT_FLOAT_EQ(merged.Center.x, 7.5f);
+	EXPECT_FLOAT_EQ(merged.Center.y, 1.5f);
+	EXPECT_FLOAT_EQ(merged.HalfSize.x, 8.0f);
+	EXPECT_FLOAT_EQ(merged.HalfSize.y, 2.0f);
+	EXPECT_EQ(merged.MemberCount, 64u);
+}
+
+TEST(StaticGeometry, KeepsGapsAndMaterialsApart)
+{
+	Physics2D::StaticGeometry geometry;
+	geometry.Begin();
+	AddTiles(geometry, 4, 1);
+
+	// Not touching the row
+	Physics2D::StaticBox gap;
+	gap.Center = {6.0f, 0.0f};
+	geometry.Add(gap);
+
+	// Touching, but slippery
+	Physics2D::StaticBox ice;
+	ice.Center = {4.0f, 0.0f};
+	ice.Material.Friction = 0.0f;
+	geometry.Add(ice);
+
+	geometry.Build();
+	EXPECT_EQ(geometry.GetMergedBoxes().size(), 3u);
+}
+
+TEST(StaticGeometry, ReusesAnUnchangedBuild)
+{
+	Physics2D::StaticGeometry geometry;
+	geometry.Begin();
+	AddTiles(geometry, 8, 8);
+	EXPECT_FALSE(geometry.Build());
+
+	geometry.Begin();
+	AddTiles(geometry, 8, 8);
+	EXPECT_TRUE(geometry.Build());
+
+	geometry.Begin();
+	AddTiles(geometry, 8, 7);
+	EXPECT_FALSE(geometry.Build());
+	EXPECT_EQ(geometry.GetMergedBoxes()[0].MemberCount, 56u);
+}
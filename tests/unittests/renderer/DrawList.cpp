@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include <Acorn/renderer/2d/DrawList.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Acorn::ext2d;
+
+TEST(DrawList, KeyRoundTrip)
+{
+	uint64_t key = DrawKey::Create(3, 0.5f, 1, 1234);
+	EXPECT_EQ(DrawKey::GetLayer(key), 3) << "Layer should survive packing";
+	EXPECT_EQ(DrawKey::GetShader(key), 1) << "Shader should survive packing";
+	EXPECT_EQ(DrawKey::GetTexture(key), 1234) << "Texture should survive packing";
+}
+
+TEST(DrawList, KeyOrder)
+{
+	EXPECT_LT(DrawKey::Create(0, 10.0f, 1, 100), DrawKey::Create(1, -10.0f, 0, 0)) << "Layer should dominate the order";
+	EXPECT_LT(DrawKey::Create(0, 0.0f, 0, 100), DrawKey::Create(0, 0.0f, 1, 0)) << "Shader should come before texture";
+	EXPECT_LT(DrawKey::Create(0, 1.0f, 0, 1), DrawKey::Create(0, -1.0f, 0, 2)) << "Texture should come before depth, so a texture is batched once";
+	EXPECT_LT(DrawKey::Create(0, -1.0f, 0, 1), DrawKey::Create(0, 1.0f, 0, 1)) << "Further back sprites should be drawn first";
+	EXPECT_LT(DrawKey::Create(0, -2.0f, 0, 1), DrawKey::Create(0, -1.0f, 0, 1)) << "Negative depths should keep their order";
+}
+
+TEST(DrawList, BackToFrontKeys)
+{
+	uint64_t key = DrawKey::Create(3, 0.5f, 1, 1234, true);
+	EXPECT_TRUE(DrawKey::IsBackToFront(key));
+	EXPECT_FALSE(DrawKey::IsBackToFront(DrawKey::Create(3, 0.5f, 1, 1234)));
+	EXPECT_EQ(DrawKey::GetLayer(key), 3) << "Layer should survive packing";
+	EXPECT_EQ(DrawKey::GetShader(key), 1) << "Shader should survive packing";
+	EXPECT_EQ(DrawKey::GetTexture(key), 1234) << "Texture should survive packing";
+
+	EXPECT_LT(DrawKey::Create(0, -1.0f, 0, 2, true), DrawKey::Create(0, 1.0f, 0, 1, true)) << "Translucent draws should stay back to front across textures";
+	EXPECT_LT(DrawKey::Create(0, 1.0f, 1, 0, true), DrawKey::Create(0, 2.0f, 0, 0, true)) << "Depth should come before shader";
+	EXPECT_LT(DrawKey::Create(0, -2.0f, 0, 1, true), DrawKey::Create(0, -1.0f, 0, 1, true)) << "Negative depths should keep their order";
+	EXPECT_LT(DrawKey::Create(0, 10.0f, 0, 0, true), DrawKey::Create(1, -10.0f, 0, 0)) << "Layer should dominate the order";
+}
+
+TEST(DrawList, Sort)
+{
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> layer(0, 3);
+	std::uniform_real_distribution<float> depth(-5.0f, 5.0f);
+	std::uniform_int_distribution<int> texture(0, 63);
+
+	DrawList list;
+	std::vector<DrawList::Command> expected;
+	for (uint32_t i = 0; i < 10000; i++)
+	{
+		uint64_t key = DrawKey::Create((uint8_t)layer(random), depth(random), 0, (uint16_t)texture(random));
+		list.Push(key, i);
+		expected.push_back({key, i});
+	}
+
+	list.Sort();
+	std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b)
+		{ return a.Key < b.Key; });
+
+	ASSERT_EQ(list.Size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		EXPECT_EQ(list.GetCommands()[i].Key, expected[i].Key) << "Keys should be in ascending order";
+		EXPECT_EQ(list.GetCommands()[i].Index, expected[i].Index) << "Equal keys should keep their submission order";
+	}
+}
+
+TEST(DrawList, SortSharedBytes)
+{
+	DrawList list;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		list.Push(DrawKey::Create(0, 0.0f, 0, (uint16_t)(i % 3)), i);
+	}
+
+	list.Sort();
+
+	for (size_t i = 1; i < list.Size(); i++)
+	{
+		const auto& previous = list.GetCommands()[i - 1];
+		const auto& current = list.GetCommands()[i];
+		EXPECT_LE(previous.Key, current.Key) << "Keys should be in ascending order";
+		if (previous.Key == current.Key)
+		{
+			EXPECT_LT(previous.Index, current.Index) << "Equal keys should keep their submission order";
+		}
+	}
+}
@@ -0,0 +1,438 @@
+#include "gtest/gtest.h"
+#include <Acorn/ecs/Entity.h>
+#include <Acorn/ecs/Scene.h>
+#include <Acorn/ecs/components/Components.h>
+#include <Acorn/serialize/BinaryFormat.h>
+#include <Acorn/serialize/SceneJournal.h>
+#include <Acorn/serialize/SceneLoader.h>
+#include <Acorn/serialize/Serializer.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+
+using namespace Acorn;
+
+static Ref<Scene> CreateTestScene(std::vector<UUID>& ids)
+{
+	auto scene = CreateRef<Scene>();
+
+	Entity root = scene->CreateEntity("Root");
+	root.GetComponent<Components::Transform>().Translation = {1.0f, 2.0f, 3.0f};
+	auto& camera = root.AddComponent<Components::CameraComponent>();
+	camera.Camera.SetOrthographicSize(7.5f);
+	camera.Primary = true;
+	root.AddComponent<Components::ChildRelationship>();
+	ids.push_back(root.GetUUID());
+
+	for (int i = 0; i < 8; i++)
+	{
+		Entity child = scene->CreateEntity("Child " + std::to_string(i));
+		child.GetComponent<Components::Transform>().Rotation = {0.0f, 0.0f, 0.25f * i};
+		if (i % 2 == 0)
+			child.AddComponent<Components::SpriteRenderer>().Color = {0.1f * i, 0.2f, 0.3f, 1.0f};
+		else
+			child.AddComponent<Components::CircleRenderer>().Thickness = 0.5f;
+
+		if (i % 4 == 0)
+		{
+			auto& rigidBody = child.AddComponent<Components::RigidBody2d>();
+			rigidBody.Type = Components::RigidBody2d::BodyType::Dynamic;
+			rigidBody.Density = 2.0f;
+			child.AddComponent<Components::BoxCollider2d>().SetSize({0.5f, 2.0f});
+		}
+		else if (i % 4 == 1)
+		{
+			child.AddComponent<Components::CircleCollider2d>().SetRadius(1.5f);
+		}
+
+		root.GetComponent<Components::ChildRelationship>().AddEntity(root, child, scene);
+		ids.push_back(child.GetUUID());
+	}
+
+	return scene;
+}
+
+static void ExpectEquivalent(Entity expected, Entity actual)
+{
+	ASSERT_TRUE(actual);
+	EXPECT_EQ(expected.GetName(), actual.GetName());
+
+	auto& expectedTransform = expected.GetComponent<Components::Transform>();
+	auto& actualTransform = actual.GetComponent<Components::Transform>();
+	EXPECT_EQ(expectedTransform.Translation, actualTransform.Translation);
+	EXPECT_EQ(expectedTransform.Rotation, actualTransform.Rotation);
+	EXPECT_EQ(expectedTransform.Scale, actualTransform.Scale);
+
+	EXPECT_EQ(expected.HasComponent<Components::CameraComponent>(), actual.HasComponent<Components::CameraComponent>());
+	if (expected.HasComponent<Components::CameraComponent>() && actual.HasComponent<Components::CameraComponent>())
+	{
+		auto& expectedCamera = expected.GetComponent<Components::CameraComponent>();
+		auto& actualCamera = actual.GetComponent<Components::CameraComponent>();
+		EXPECT_EQ(expectedCamera.Camera.GetOrthographicSize(), actualCamera.Camera.GetOrthographicSize());
+		EXPECT_EQ(expectedCamera.Primary, actualCamera.Primary);
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::SpriteRenderer>(), actual.HasComponent<Components::SpriteRenderer>());
+	if (expected.HasComponent<Components::SpriteRenderer>() && actual.HasComponent<Components::SpriteRenderer>())
+	{
+		EXPECT_EQ(expected.GetComponent<Components::SpriteRenderer>().Color, actual.GetComponent<Components::SpriteRenderer>().Color);
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::CircleRenderer>(), actual.HasComponent<Components::CircleRenderer>());
+	if (expected.HasComponent<Components::CircleRenderer>() && actual.HasComponent<Components::CircleRenderer>())
+	{
+		EXPECT_EQ(expected.GetComponent<Components::CircleRenderer>().Thickness, actual.GetComponent<Components::CircleRenderer>().Thickness);
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::RigidBody2d>(), actual.HasComponent<Components::RigidBody2d>());
+	if (expected.HasComponent<Components::RigidBody2d>() && actual.HasComponent<Components::RigidBody2d>())
+	{
+		EXPECT_EQ(expected.GetComponent<Components::RigidBody2d>().Type, actual.GetComponent<Components::RigidBody2d>().Type);
+		EXPECT_EQ(expected.GetComponent<Components::RigidBody2d>().Density, actual.GetComponent<Components::RigidBody2d>().Density);
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::BoxCollider2d>(), actual.HasComponent<Components::BoxCollider2d>());
+	if (expected.HasComponent<Components::BoxCollider2d>() && actual.HasComponent<Components::BoxCollider2d>())
+	{
+		EXPECT_EQ(expected.GetComponent<Components::BoxCollider2d>().GetSize(), actual.GetComponent<Components::BoxCollider2d>().GetSize());
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::CircleCollider2d>(), actual.HasComponent<Components::CircleCollider2d>());
+	if (expected.HasComponent<Components::CircleCollider2d>() && actual.HasComponent<Components::CircleCollider2d>())
+	{
+		EXPECT_EQ(expected.GetComponent<Components::CircleCollider2d>().GetRadius(), actual.GetComponent<Components::CircleCollider2d>().GetRadius());
+	}
+
+	EXPECT_EQ(expected.HasComponent<Components::ChildRelationship>(), actual.HasComponent<Components::ChildRelationship>());
+	if (expected.HasComponent<Components::ChildRelationship>() && actual.HasComponent<Components::ChildRelationship>())
+	{
+		auto& expectedChildren = expected.GetComponent<Components::ChildRelationship>().Entities;
+		auto& actualChildren = actual.GetComponent<Components::ChildRelationship>().Entities;
+		ASSERT_EQ(expectedChildren.size(), actualChildren.size());
+		for (size_t i = 0; i < expectedChildren.size(); i++)
+		{
+			EXPECT_EQ(expectedChildren[i].GetUUID(), actualChildren[i].GetUUID());
+		}
+	}
+}
+
+TEST(SceneSerializer, BinaryMatchesYaml)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	auto directory = std::filesystem::temp_directory_path();
+	std::string yamlPath = (directory / "acorn_test_scene.acorn").string();
+	std::string binaryPath = (directory / "acorn_test_scene.acornb").string();
+	SceneSerializer(scene).Serialize(yamlPath);
+	SceneSerializer(scene).SerializeRuntime(binaryPath);
+
+	auto yamlScene = CreateRef<Scene>();
+	auto binaryScene = CreateRef<Scene>();
+	ASSERT_TRUE(SceneSerializer(yamlScene).Deserialize(yamlPath));
+	ASSERT_TRUE(SceneSerializer(binaryScene).DeserializeRuntime(binaryPath));
+
+	for (const UUID& id : ids)
+	{
+		Entity original = scene->GetEntity(id);
+		ExpectEquivalent(original, yamlScene->GetEntity(id));
+		ExpectEquivalent(original, binaryScene->GetEntity(id));
+	}
+
+	// Both loaders have to produce the same hierarchy, not just the same components
+	yamlScene->UpdateWorldTransforms();
+	binaryScene->UpdateWorldTransforms();
+	Entity lastChild = binaryScene->GetEntity(ids.back());
+	EXPECT_EQ(lastChild.GetComponent<Components::WorldTransform>().Matrix, yamlScene->GetEntity(ids.back()).GetComponent<Components::WorldTransform>().Matrix);
+
+	std::filesystem::remove(yamlPath);
+	std::filesystem::remove(binaryPath);
+}
+
+TEST(SceneSerializer, RejectsTruncatedBinary)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_truncated.acornb").string();
+	SceneSerializer(scene).SerializeRuntime(path);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+	auto loaded = CreateRef<Scene>();
+	EXPECT_FALSE(SceneSerializer(loaded).DeserializeRuntime(path));
+
+	std::ofstream(path, std::ios::binary) << "not a scene";
+	EXPECT_FALSE(SceneSerializer(CreateRef<Scene>()).DeserializeRuntime(path));
+
+	// Two entities followed by the given blocks
+	auto writeScene = [&](const std::function<void(Binary::Writer&)>& writeBlocks, UUID secondId = UUID(2, 4))
+	{
+		Binary::Writer writer;
+		writer.Write(Binary::FileHeader{{'A', 'C', 'S', 'B'}, Binary::SceneVersion, 2, 0});
+		writer.BeginBlock(Binary::BlockType::Entities, 2);
+		writer.WriteColumn(std::vector<uint64_t>{1, secondId.GetHigh()});
+		writer.WriteColumn(std::vector<uint64_t>{3, secondId.GetLow()});
+		writer.EndBlock();
+		writeBlocks(writer);
+
+		std::vector<char>& buffer = writer.GetBuffer();
+		uint32_t blockCount = writer.GetBlockCount();
+		std::memcpy(buffer.data() + offsetof(Binary::FileHeader, BlockCount), &blockCount, sizeof(blockCount));
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(buffer.data(), buffer.size());
+		return SceneSerializer(CreateRef<Scene>()).DeserializeRuntime(path);
+	};
+
+	// Counts are checked against the block, 0xffffffff + 1 offsets must not wrap around
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Strings, 0xffffffff);
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.EndBlock();
+		}));
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Children, 0xffffffff);
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.EndBlock();
+		}));
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			// The rows fit the file, but not the block
+			writer.BeginBlock(Binary::BlockType::CircleCollider2d, 2);
+			writer.WriteColumn(std::vector<uint32_t>{0, 1});
+			writer.EndBlock();
+			writer.BeginBlock(Binary::BlockType::Strings, 0);
+			writer.WriteColumn(std::vector<uint32_t>(16, 0));
+			writer.EndBlock();
+		}));
+
+	// Duplicate rows would add a component twice
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Camera, 2);
+			writer.WriteColumn(std::vector<uint32_t>{0, 0});
+			writer.WriteColumn(std::vector<int32_t>{1, 1});
+			for (int i = 0; i < 6; i++)
+				writer.WriteColumn(std::vector<float>{1.0f, 1.0f});
+			writer.WriteColumn(std::vector<uint8_t>{0, 0});
+			writer.WriteColumn(std::vector<uint8_t>{0, 0});
+			writer.EndBlock();
+		}));
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Children, 1);
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.WriteColumn(std::vector<uint32_t>{0, 2});
+			writer.WriteColumn(std::vector<uint32_t>{1, 1});
+			writer.EndBlock();
+		}));
+	EXPECT_TRUE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Children, 1);
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.WriteColumn(std::vector<uint32_t>{0, 1});
+			writer.WriteColumn(std::vector<uint32_t>{1});
+			writer.EndBlock();
+		}));
+
+	// Two entities with the same id
+	EXPECT_FALSE(writeScene([](Binary::Writer&) {}, UUID(1, 3)));
+
+	// A hierarchy that loops would never reach a root
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Children, 1);
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.WriteColumn(std::vector<uint32_t>{0, 1});
+			writer.WriteColumn(std::vector<uint32_t>{0});
+			writer.EndBlock();
+		}));
+	EXPECT_FALSE(writeScene([](Binary::Writer& writer)
+		{
+			writer.BeginBlock(Binary::BlockType::Children, 2);
+			writer.WriteColumn(std::vector<uint32_t>{0, 1});
+			writer.WriteColumn(std::vector<uint32_t>{0, 1, 2});
+			writer.WriteColumn(std::vector<uint32_t>{1, 0});
+			writer.EndBlock();
+		}));
+
+	std::filesystem::remove(path);
+}
+
+TEST(SceneSerializer, RejectsInvalidEntityIds)
+{
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_invalid_id.acorn").string();
+	std::ofstream(path, std::ios::trunc) << "Scene: Untitled\n"
+										   "Entities:\n"
+										   "  - Entity: 0f8fad5bd-9cb-469f-a165-70867728950e\n"
+										   "    Tag:\n"
+										   "      Tag: Misplaced dash\n";
+
+	EXPECT_FALSE(SceneSerializer(CreateRef<Scene>()).Deserialize(path));
+
+	std::filesystem::remove(path);
+}
+
+TEST(SceneSerializer, LoaderMatchesDeserialize)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_loader.acorn").string();
+	SceneSerializer(scene).Serialize(path);
+
+	// Small chunks, so the scene arrives over several updates
+	SceneLoader loader(CreateRef<Scene>(), path, 2);
+	SceneLoader::State state = SceneLoader::State::Loading;
+	for (int i = 0; i < 10000 && state != SceneLoader::State::Done; i++)
+	{
+		state = loader.Update(1);
+		ASSERT_NE(state, SceneLoader::State::Failed);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_EQ(state, SceneLoader::State::Done);
+	EXPECT_EQ(loader.GetProgress(), 1.0f);
+
+	for (const UUID& id : ids)
+	{
+		ExpectEquivalent(scene->GetEntity(id), loader.GetScene()->GetEntity(id));
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST(SceneSerializer, JournalRecoversChanges)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_journal.acorn").string();
+	SceneSerializer(scene).Serialize(path);
+
+	SceneJournal journal(scene, path, 2);
+	Entity root = scene->GetEntity(ids[0]);
+	Entity moved = scene->GetEntity(ids[1]);
+	moved.GetComponent<Components::Transform>().Translation = {4.0f, 5.0f, 6.0f};
+	moved.MarkChanged();
+	scene->GetEntity(ids[2]).AddComponent<Components::RigidBody2d>().Density = 3.0f;
+	journal.Autosave();
+
+	root.GetComponent<Components::ChildRelationship>().RemoveEntity(moved);
+	scene->DestroyEntity(scene->GetEntity(ids[3]));
+	UUID addedId = scene->CreateEntity("Added").GetUUID();
+	journal.Autosave();
+	ASSERT_TRUE(SceneJournal::HasAutosave(path));
+
+	auto expectRecovered = [&]()
+	{
+		auto saved = CreateRef<Scene>();
+		ASSERT_TRUE(SceneSerializer(saved).Deserialize(path));
+		auto recovered = SceneJournal::Recover(saved, path);
+		ASSERT_TRUE(recovered);
+
+		for (const UUID& id : ids)
+		{
+			if (id != ids[3])
+				ExpectEquivalent(scene->GetEntity(id), recovered->GetEntity(id));
+		}
+		EXPECT_FALSE(recovered->GetEntity(ids[3]));
+		EXPECT_TRUE(recovered->GetEntity(addedId));
+	};
+	expectRecovered();
+
+	// The third record is past the interval, so it is folded into a snapshot
+	moved.GetComponent<Components::Transform>().Scale = {2.0f, 2.0f, 2.0f};
+	moved.MarkChanged();
+	journal.Autosave();
+	expectRecovered();
+
+	journal.Discard();
+	EXPECT_FALSE(SceneJournal::HasAutosave(path));
+	std::filesystem::remove(path);
+}
+
+TEST(SceneSerializer, JournalMatchesItsSnapshot)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_generation.acorn").string();
+	std::string journalPath = path + ".autosave.journal";
+	SceneSerializer(scene).Serialize(path);
+
+	auto readFile = [](const std::string& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(file), {});
+	};
+	auto recover = [&]()
+	{
+		auto saved = CreateRef<Scene>();
+		EXPECT_TRUE(SceneSerializer(saved).Deserialize(path));
+		return SceneJournal::Recover(saved, path);
+	};
+
+	SceneJournal journal(scene, path);
+	Entity moved = scene->GetEntity(ids[1]);
+	moved.GetComponent<Components::Transform>().Translation = {1.0f, 0.0f, 0.0f};
+	moved.MarkChanged();
+	journal.Autosave();
+	std::string oldJournal = readFile(journalPath);
+
+	moved.GetComponent<Components::Transform>().Translation = {2.0f, 0.0f, 0.0f};
+	moved.MarkChanged();
+	journal.Compact();
+	std::string header = readFile(journalPath);
+
+	// A crash between writing the snapshot and truncating the journal leaves the records of the old generation behind
+	std::ofstream(journalPath, std::ios::binary | std::ios::trunc) << oldJournal;
+	auto recovered = recover();
+	ASSERT_TRUE(recovered);
+	EXPECT_EQ(recovered->GetEntity(ids[1]).GetComponent<Components::Transform>().Translation, glm::vec3(2.0f, 0.0f, 0.0f));
+
+	// A cut off record is skipped, a complete one that can not be read fails the recovery
+	std::ofstream(journalPath, std::ios::binary | std::ios::trunc) << header << "Changed: [";
+	EXPECT_TRUE(recover());
+	std::ofstream(journalPath, std::ios::binary | std::ios::trunc) << header << "Changed: [\n...\n";
+	EXPECT_FALSE(recover());
+
+	journal.Discard();
+	std::filesystem::remove(path);
+}
+
+TEST(SceneSerializer, FailedRecoveryKeepsTheSavedScene)
+{
+	std::vector<UUID> ids;
+	auto scene = CreateTestScene(ids);
+
+	std::string path = (std::filesystem::temp_directory_path() / "acorn_test_failed_recovery.acorn").string();
+	std::string journalPath = path + ".autosave.journal";
+	SceneSerializer(scene).Serialize(path);
+
+	// Without a snapshot the records apply to the scene file
+	SceneJournal journal(scene, path);
+	Entity moved = scene->GetEntity(ids[1]);
+	glm::vec3 savedTranslation = moved.GetComponent<Components::Transform>().Translation;
+	moved.GetComponent<Components::Transform>().Translation = savedTranslation + glm::vec3(1.0f);
+	moved.MarkChanged();
+	journal.Autosave();
+	std::ofstream(journalPath, std::ios::binary | std::ios::app) << "Changed: [\n...\n";
+
+	auto saved = CreateRef<Scene>();
+	ASSERT_TRUE(SceneSerializer(saved).Deserialize(path));
+	EXPECT_FALSE(SceneJournal::Recover(saved, path));
+	EXPECT_EQ(saved->GetEntity(ids[1]).GetComponent<Components::Transform>().Translation, savedTranslation);
+
+	SceneJournal::SetAside(path);
+	EXPECT_FALSE(SceneJournal::HasAutosave(path));
+	EXPECT_TRUE(std::filesystem::exists(journalPath + ".failed"));
+
+	std::filesystem::remove(journalPath + ".failed");
+	std::filesystem::remove(path);
+}
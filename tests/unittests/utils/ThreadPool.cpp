@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include <Acorn/utils/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPool, CoversEveryIndexOnce)
+{
+	Acorn::Utils::ThreadPool pool(4);
+
+	for (uint32_t count : {0u, 1u, 63u, 64u, 1000u, 100'000u})
+	{
+		std::vector<uint32_t> hits(count, 0);
+		pool.ParallelFor(count, 16, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					hits[i]++;
+				}
+			});
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			ASSERT_EQ(hits[i], 1u) << "Index " << i << " of " << count << " should be visited exactly once";
+		}
+	}
+}
+
+TEST(ThreadPool, WithoutWorkers)
+{
+	Acorn::Utils::ThreadPool pool(0);
+	EXPECT_EQ(pool.GetWorkerCount(), 0u);
+
+	uint64_t sum = 0;
+	pool.ParallelFor(1000, 1, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				sum += i;
+			}
+		});
+
+	EXPECT_EQ(sum, 499500u) << "The calling thread should run the whole loop";
+}
+
+TEST(ThreadPool, RepeatedJobs)
+{
+	Acorn::Utils::ThreadPool pool(3);
+	std::atomic<uint64_t> total = 0;
+
+	for (uint32_t job = 0; job < 500; job++)
+	{
+		pool.ParallelFor(256, 1, [&](uint32_t begin, uint32_t end)
+			{ total += end - begin; });
+	}
+
+	EXPECT_EQ(total.load(), 500u * 256u) << "Every job should finish before the next one starts";
+}
+
+TEST(ThreadPool, WaitsForSlowRanges)
+{
+	Acorn::Utils::ThreadPool pool(2);
+	std::atomic<uint32_t> done = 0;
+
+	// The caller runs out of ranges long before the workers finish theirs
+	pool.ParallelFor(3, 1, [&](uint32_t begin, uint32_t end)
+		{
+			if (begin != 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			done += end - begin;
+		});
+
+	EXPECT_EQ(done.load(), 3u) << "ParallelFor should only return once every range is done";
+}